@@ -20,19 +20,31 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #if USE_CLIENT
 
+typedef enum {
+    ASYNC_PRIO_NORMAL,  // default
+    ASYNC_PRIO_HIGH,
+    ASYNC_PRIO_LOW,
+
+    ASYNC_PRIO_MAX
+} asyncprio_t;
+
 typedef struct asyncwork_s {
     void (*work_cb)(void *);
     void (*done_cb)(void *);
     void *cb_arg;
+    asyncprio_t priority;
+    uint64_t queue_time;
     struct asyncwork_s *next;
 } asyncwork_t;
 
+void Com_InitAsyncWork(void);
 void Com_QueueAsyncWork(asyncwork_t *work);
 void Com_CompleteAsyncWork(void);
 void Com_ShutdownAsyncWork(void);
 
 #else
 
+#define Com_InitAsyncWork()         (void)0
 #define Com_QueueAsyncWork(work)    (void)0
 #define Com_CompleteAsyncWork()     (void)0
 #define Com_ShutdownAsyncWork()     (void)0
@@ -39,6 +39,7 @@ typedef enum {
 typedef struct cmdbuf_s {
     from_t      from;
     char        *text; // may not be NULL terminated
+    size_t      readpos; // offset of unexecuted text
     size_t      cursize;
     size_t      maxsize;
     int         waitCount;
@@ -95,11 +96,21 @@ typedef void (*xcompleter_t)(int, int);
 typedef void (*xgenerator_t)(void);
 
 typedef struct cmd_macro_s {
-    struct cmd_macro_s  *next, *hashNext;
+    struct cmd_macro_s  *next;
     const char          *name;
     xmacro_t            function;
 } cmd_macro_t;
 
+// Interned name shared by commands, aliases, macros and cvars, so that
+// resolving the first token of a command line takes a single lookup.
+typedef struct {
+    struct cmd_function_s   *cmd;
+    struct cmdalias_s       *alias;
+    cmd_macro_t             *macro;
+    struct cvar_s           *cvar;
+    char                    name[1];
+} cmd_symbol_t;
+
 typedef struct {
     const char *sh, *lo, *help;
 } cmd_option_t;
@@ -112,6 +123,9 @@ typedef struct {
 
 void Cmd_Init(void);
 
+cmd_symbol_t *Cmd_FindSymbol(const char *name);
+cmd_symbol_t *Cmd_InternSymbol(const char *name);
+
 bool Cmd_Exists(const char *cmd_name);
 // used by the cvar code to check for cvar / command name overlap
 
@@ -51,7 +51,6 @@ typedef struct cvar_s {
     char        *default_string;
     xchanged_t      changed;
     xgenerator_t    generator;
-    struct cvar_s   *hashNext;
 } cvar_t;
 
 extern cvar_t   *cvar_vars;
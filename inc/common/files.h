@@ -92,6 +92,7 @@ int64_t FS_Tell(qhandle_t f);
 int FS_Seek(qhandle_t f, int64_t offset, int whence);
 
 int64_t FS_Length(qhandle_t f);
+FILE *FS_RawFile(qhandle_t f, int64_t *offset);
 
 bool FS_WildCmp(const char *filter, const char *string);
 bool FS_ExtCmp(const char *extension, const char *string);
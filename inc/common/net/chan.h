@@ -22,6 +22,8 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "common/net/net.h"
 #include "common/sizebuf.h"
 
+typedef struct netbuf_s netbuf_t;
+
 typedef struct {
     unsigned    maxpacketlen;
 
@@ -58,8 +60,16 @@ typedef struct {
     unsigned    reliable_length;
     byte        *reliable_buf;      // unacked reliable message
 
-    sizebuf_t   fragment_in;
-    sizebuf_t   fragment_out;
+    // fragments are assembled in place into pooled buffer
+    unsigned    fragment_in_length;
+    netbuf_t    *fragment_in;
+
+    // reliable part of fragmented message is sent from reliable_buf,
+    // unreliable part is kept in pooled buffer
+    unsigned    fragment_reliable;
+    unsigned    fragment_length;
+    unsigned    fragment_offset;
+    netbuf_t    *fragment_out;
 } netchan_t;
 
 extern cvar_t       *net_qport;
@@ -74,7 +84,9 @@ int Netchan_Transmit(netchan_t *chan, size_t length, const void *data, int numpa
 int Netchan_TransmitNextFragment(netchan_t *chan);
 bool Netchan_Process(netchan_t *chan);
 bool Netchan_ShouldUpdate(const netchan_t *chan);
+size_t Netchan_ReliableSize(const netchan_t *chan);
 void Netchan_Close(netchan_t *chan);
+void Netchan_Stats(void);
 
 static inline bool Netchan_SeqTooBig(const netchan_t *chan)
 {
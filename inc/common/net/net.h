@@ -42,6 +42,14 @@ typedef int qsocket_t;
 
 struct pollfd;
 
+#define MAX_NETVECS     4   // max number of pieces a packet is gathered from
+
+// piece of outgoing packet
+typedef struct {
+    const void  *data;
+    size_t      len;
+} netvec_t;
+
 // portable network error codes
 typedef enum {
     NET_OK      =  0,   // success
@@ -194,6 +202,8 @@ bool        NET_GetAddress(netsrc_t sock, netadr_t *adr);
 void        NET_GetPackets(netsrc_t sock, void (*packet_cb)(void));
 bool        NET_SendPacket(netsrc_t sock, const void *data,
                            size_t len, const netadr_t *to);
+bool        NET_SendPacketv(netsrc_t sock, const netvec_t *vec,
+                            int count, const netadr_t *to);
 
 const char  *NET_AdrToString(const netadr_t *a);
 bool        NET_StringToAdr(const char *s, netadr_t *a, int default_port);
@@ -220,6 +230,16 @@ int         NET_Sleep(int msec);
 int         NET_Sleep1(int msec, struct pollfd *e);
 #endif
 
+#define MAX_NET_SHARDS  4
+
+int         NET_OffloadServer(int count);
+void        NET_RestoreServer(void);
+int         NET_OffloadWait(int shard, int msec);
+int         NET_OffloadRecv(int shard, void *data, size_t len, netadr_t *from);
+bool        NET_OffloadSend(int shard, const void *data,
+                            size_t len, const netadr_t *to);
+void        NET_OffloadWake(void);
+
 extern cvar_t       *net_ip;
 extern cvar_t       *net_port;
 
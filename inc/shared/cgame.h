@@ -23,7 +23,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "shared/refresh.h"
 #include "shared/sound.h"
 
-#define CGAME_API_VERSION    4000
+#define CGAME_API_VERSION    4001
 
 #define CMD_BACKUP      128 // allow a lot of command backups for very fast systems
                             // increased from 64
@@ -36,6 +36,12 @@ typedef struct {
     unsigned        cmdnum;
     unsigned        latency;
 
+    // jitter buffer statistics
+    unsigned        arrival;    // client realtime frame was received
+    unsigned        jitter;     // interarrival jitter, msec
+    unsigned        delay;      // playout delay, msec
+    unsigned        buffered;   // frames held back in jitter buffer
+
     byte            areabits[MAX_MAP_AREA_BYTES];
     int             areabytes;
 
@@ -59,6 +59,7 @@ typedef enum {
 // FIXME: eliminate AREA_ distinction?
 #define AREA_SOLID      1
 #define AREA_TRIGGERS   2
+#define AREA_SORTED     4   // gi.RadiusEdicts() only, nearest first
 
 //===============================================================
 
@@ -188,6 +189,7 @@ typedef struct {
     void (*Clip)(trace_t *tr, const trace_args_t *args);
     contents_t (*PointContents)(vec3_t point);
     int (*BoxEdicts)(box3_t box, int *list, int maxcount, int areatype);
+    int (*RadiusEdicts)(vec3_t origin, float radius, int *list, int maxcount, int areatype);
 
     bool (*InVis)(vec3_t p1, vec3_t p2, vis_t vis);
     void (*SetAreaPortalState)(unsigned portalnum, bool open);
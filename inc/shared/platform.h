@@ -83,6 +83,13 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define R_OK    4
 #endif
 
+// baseline SIMD instruction sets, intrinsics headers are included by users
+#if (defined __SSE2__) || (defined _M_X64) || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define USE_SSE2    1
+#elif (defined __ARM_NEON && defined __aarch64__) || (defined _M_ARM64)
+#define USE_NEON    1
+#endif
+
 #endif /* !Q2_VM */
 
 #ifdef __has_builtin
@@ -131,6 +138,8 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #define q_forceinline       inline __attribute__((always_inline))
 
+#define q_thread_local      __thread
+
 #else /* __GNUC__ */
 
 #ifdef _MSC_VER
@@ -140,6 +149,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define q_alignof(t)        __alignof(t)
 #define q_unreachable()     __assume(0)
 #define q_forceinline       __forceinline
+#define q_thread_local      __declspec(thread)
 #else
 #define q_noreturn
 #define q_noinline
@@ -147,6 +157,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define q_alignof(t)        _Alignof(t)
 #define q_unreachable()     abort()
 #define q_forceinline       inline
+#define q_thread_local      _Thread_local
 #endif
 
 #define q_printf(f, a)
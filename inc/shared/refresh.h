@@ -20,7 +20,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #define MAX_DLIGHTS     64
 #define MAX_ENTITIES    2048
-#define MAX_PARTICLES   8192
+#define MAX_PARTICLES   16384
 
 #define POWERSUIT_SCALE     4.0f
 #define WEAPONSHELL_SCALE   0.5f
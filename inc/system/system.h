@@ -35,6 +35,8 @@ void    *Sys_GetProcAddress(void *handle, const char *sym);
 void    *Sys_LoadGameLibrary(void);
 
 unsigned    Sys_Milliseconds(void);
+uint64_t    Sys_Microseconds(void);
+int         Sys_NumCPUs(void);
 void        Sys_Sleep(int msec);
 
 void    Sys_Init(void);
@@ -54,6 +54,7 @@ strcpy(char *to, const char *from)
     return(save);
 }
 
+#if 0
 size_t
 strlen(const char *str)
 {
@@ -63,6 +64,7 @@ strlen(const char *str)
         ;
     return (s - str);
 }
+#endif
 
 char *strstr(const char *string, const char *substring)
 {
@@ -139,6 +141,7 @@ memchr(const void *s, int c, size_t n)
     return (NULL);
 }
 
+#if 0
 /*
  * Compare strings.
  */
@@ -164,6 +167,7 @@ strncmp(const char *s1, const char *s2, size_t n)
     } while (--n != 0);
     return (0);
 }
+#endif
 
 #if 0
 /*
@@ -382,6 +382,15 @@ static void CG_TestModelMuzzle_f(void)
     cg.test_muzzle.scale = muzzle_scale * scale;
 }
 
+// emit given number of particles per frame, watch fps and r_speeds
+static void CG_ParticleStress_f(void)
+{
+    char buf[MAX_QPATH];
+
+    trap_Argv(1, buf, sizeof(buf));
+    CG_StressParticles(max(Q_atoi(buf), 0));
+}
+
 #endif
 
 typedef enum {
@@ -412,6 +421,7 @@ static cg_consolecmd_t cg_consolecmds[] = {
     { "nextskin", CG_TestModelNextSkin_f },
     { "prevskin", CG_TestModelPrevSkin_f },
     { "testmuzzle", CG_TestModelMuzzle_f },
+    { "particlestress", CG_ParticleStress_f, NEED_FRAME },
 #endif
 
     { "cl_weapprev", CG_WeapPrev_f, NEED_FRAME | NO_DEMO },
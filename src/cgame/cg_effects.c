@@ -842,37 +842,72 @@ PARTICLE MANAGEMENT
 ==============================================================
 */
 
-static cparticle_t  *active_particles, *free_particles;
-
-static cparticle_t  particles[MAX_PARTICLES];
+// Effects fill in cparticle_t records in a staging buffer, which are moved
+// into structure of arrays store by CG_AddParticles. Live particles always
+// occupy contiguous [0, num_particles) range of the store, so that update
+// loop doesn't chase pointers and touches only the arrays it needs.
+static struct {
+    int     time[MAX_PARTICLES];
+    float   alpha[MAX_PARTICLES];
+    float   alphavel[MAX_PARTICLES];
+    vec3_t  org[MAX_PARTICLES];
+    vec3_t  vel[MAX_PARTICLES];
+    vec3_t  accel[MAX_PARTICLES];
+    int     color[MAX_PARTICLES];
+    float   scale[MAX_PARTICLES];
+    color_t rgba[MAX_PARTICLES];
+} particles;
+
+static int          num_particles;
+
+static cparticle_t  new_particles[MAX_NEW_PARTICLES];
+static int          num_new_particles;
+
+#if USE_DEBUG
+static int          stress_particles;
+#endif
 
 static void CG_ClearParticles(void)
 {
-    int     i;
-
-    free_particles = &particles[0];
-    active_particles = NULL;
-
-    for (i = 0; i < MAX_PARTICLES - 1; i++)
-        particles[i].next = &particles[i + 1];
-    particles[i].next = NULL;
+    num_particles = 0;
+    num_new_particles = 0;
 }
 
-cparticle_t *CG_AllocParticle(void)
+/*
+===============
+CG_AllocParticles
+
+Allocates up to `*count' new particles as a contiguous array and updates
+`*count' with the number of particles actually allocated. Returns NULL if
+none are available.
+===============
+*/
+cparticle_t *CG_AllocParticles(int *count)
 {
+    int avail = min(MAX_PARTICLES - num_particles, MAX_NEW_PARTICLES) - num_new_particles;
     cparticle_t *p;
 
-    if (!free_particles)
+    if (*count <= 0 || avail <= 0) {
+        *count = 0;
         return NULL;
-    p = free_particles;
-    free_particles = p->next;
-    p->next = active_particles;
-    active_particles = p;
+    }
+
+    *count = min(*count, avail);
+    p = &new_particles[num_new_particles];
+    num_new_particles += *count;
+
+    for (int i = 0; i < *count; i++)
+        p[i].scale = 1.0f;
 
-    p->scale = 1.0f;
     return p;
 }
 
+cparticle_t *CG_AllocParticle(void)
+{
+    int count = 1;
+    return CG_AllocParticles(&count);
+}
+
 /*
 ===============
 CG_ParticleEffect
@@ -885,11 +920,8 @@ void CG_ParticleEffect(vec3_t org, vec3_t dir, int color, int count)
     int         i;
     cparticle_t *p;
 
-    for (i = 0; i < count; i++) {
-        p = CG_AllocParticle();
-        if (!p)
-            return;
-
+    p = CG_AllocParticles(&count);
+    for (i = 0; i < count; i++, p++) {
         p->time = cg.time;
         p->color = color + (Q_rand() & 7);
 
@@ -915,11 +947,8 @@ void CG_ParticleEffect2(vec3_t org, vec3_t dir, int color, int count)
     int         i;
     cparticle_t *p;
 
-    for (i = 0; i < count; i++) {
-        p = CG_AllocParticle();
-        if (!p)
-            return;
-
+    p = CG_AllocParticles(&count);
+    for (i = 0; i < count; i++, p++) {
         p->time = cg.time;
         p->color = color;
 
@@ -1039,14 +1068,11 @@ CG_ExplosionParticles
 */
 void CG_ExplosionParticles(vec3_t org)
 {
-    int         i;
+    int         i, count = 256;
     cparticle_t *p;
 
-    for (i = 0; i < 256; i++) {
-        p = CG_AllocParticle();
-        if (!p)
-            return;
-
+    p = CG_AllocParticles(&count);
+    for (i = 0; i < count; i++, p++) {
         p->time = cg.time;
         p->color = 0xe0 + (Q_rand() & 7);
         p->org = Vec3_MA(org, 16, Vec3_CenterRandom());
@@ -1555,14 +1581,11 @@ CG_BFGExplosionParticles
 //FIXME combined with CG_ExplosionParticles
 void CG_BFGExplosionParticles(vec3_t org)
 {
-    int         i;
+    int         i, count = 256;
     cparticle_t *p;
 
-    for (i = 0; i < 256; i++) {
-        p = CG_AllocParticle();
-        if (!p)
-            return;
-
+    p = CG_AllocParticles(&count);
+    for (i = 0; i < count; i++, p++) {
         p->time = cg.time;
         p->color = 0xd0 + (Q_rand() & 7);
 
@@ -2086,14 +2109,11 @@ CG_ColorExplosionParticles
 */
 void CG_ColorExplosionParticles(vec3_t org, int color, int run)
 {
-    int         i;
+    int         i, count = 128;
     cparticle_t *p;
 
-    for (i = 0; i < 128; i++) {
-        p = CG_AllocParticle();
-        if (!p)
-            return;
-
+    p = CG_AllocParticles(&count);
+    for (i = 0; i < count; i++, p++) {
         p->time = cg.time;
         p->color = color + (Q_rand() % run);
 
@@ -2363,11 +2383,8 @@ void CG_ParticleEffect3(vec3_t org, vec3_t dir, int color, int count)
     int         i;
     cparticle_t *p;
 
-    for (i = 0; i < count; i++) {
-        p = CG_AllocParticle();
-        if (!p)
-            return;
-
+    p = CG_AllocParticles(&count);
+    for (i = 0; i < count; i++, p++) {
         p->time = cg.time;
         p->color = color;
 
@@ -2555,6 +2572,80 @@ void CG_BarrelExplodingParticles(vec3_t org)
 
 static particle_t   r_particles[MAX_PARTICLES];
 
+#if USE_DEBUG
+/*
+===============
+CG_StressParticles
+
+Continuously emits given number of particles per frame in front of the
+view, for measuring particle system performance.
+===============
+*/
+void CG_StressParticles(int count)
+{
+    stress_particles = count;
+}
+
+static void CG_EmitStressParticles(void)
+{
+    cparticle_t *p;
+    vec3_t      org;
+    int         count;
+
+    if (!stress_particles)
+        return;
+
+    org = Vec3_MA(cg.refdef.vieworg, 256, cg.v_forward);
+
+    count = stress_particles;
+    p = CG_AllocParticles(&count);
+    for (int i = 0; i < count; i++, p++) {
+        p->time = cg.time;
+        p->color = 0xe0 + (Q_rand() & 7);
+        p->org = Vec3_MA(org, 16, Vec3_CenterRandom());
+        p->vel = Vec3_Scale(Vec3_CenterRandom(), 192);
+        p->accel = Vec3(0, 0, -PARTICLE_GRAVITY);
+        p->alpha = 1.0f;
+        p->alphavel = -0.8f / (0.5f + frand() * 0.3f);
+    }
+}
+#endif
+
+// moves staged particles into the store. instant particles are never
+// stored, they are drawn once and discarded.
+static int CG_FlushNewParticles(void)
+{
+    int count = 0;
+
+    for (int i = 0; i < num_new_particles; i++) {
+        const cparticle_t *p = &new_particles[i];
+
+        if (p->alphavel == INSTANT_PARTICLE) {
+            particle_t *part = &r_particles[count++];
+            part->origin = p->org;
+            part->rgba = p->rgba;
+            part->color = p->color;
+            part->alpha = min(p->alpha, 1.0f);
+            part->scale = p->scale;
+            continue;
+        }
+
+        int n = num_particles++;
+        particles.time[n] = p->time;
+        particles.alpha[n] = p->alpha;
+        particles.alphavel[n] = p->alphavel;
+        particles.org[n] = p->org;
+        particles.vel[n] = p->vel;
+        particles.accel[n] = p->accel;
+        particles.color[n] = p->color;
+        particles.scale[n] = p->scale;
+        particles.rgba[n] = p->rgba;
+    }
+
+    num_new_particles = 0;
+    return count;
+}
+
 /*
 ===============
 CG_AddParticles
@@ -2562,60 +2653,46 @@ CG_AddParticles
 */
 void CG_AddParticles(void)
 {
-    cparticle_t     *p, *next;
-    float           alpha, time;
-    cparticle_t     *active, *tail;
-    particle_t      *part;
-    int r_numparticles = 0;
-
-    active = NULL;
-    tail = NULL;
-
-    for (p = active_particles; p; p = next) {
-        next = p->next;
-
-        if (p->alphavel != INSTANT_PARTICLE) {
-            time = (cg.time - p->time) * 0.001f;
-            alpha = p->alpha + time * p->alphavel;
-            if (alpha <= 0) {
-                // faded out
-                p->next = free_particles;
-                free_particles = p;
-                continue;
-            }
-        } else {
-            time = 0.0f;
-            alpha = p->alpha;
-        }
+    int r_numparticles, i, j;
 
-        if (r_numparticles >= MAX_PARTICLES)
-            break;
-        part = &r_particles[r_numparticles++];
-
-        p->next = NULL;
-        if (!tail)
-            active = tail = p;
-        else {
-            tail->next = p;
-            tail = p;
-        }
+#if USE_DEBUG
+    CG_EmitStressParticles();
+#endif
 
-        part->origin = Vec3_MA(p->org, time, p->vel);
-        part->origin = Vec3_MA(part->origin, time * time, p->accel);
-        part->rgba = p->rgba;
-        part->color = p->color;
-        part->alpha = min(alpha, 1.0f);
-        part->scale = p->scale;
+    r_numparticles = CG_FlushNewParticles();
 
-        if (p->alphavel == INSTANT_PARTICLE) {
-            p->alphavel = 0.0f;
-            p->alpha = 0.0f;
+    for (i = j = 0; i < num_particles; i++) {
+        float time = (cg.time - particles.time[i]) * 0.001f;
+        float alpha = particles.alpha[i] + time * particles.alphavel[i];
+        if (alpha <= 0)
+            continue;   // faded out
+
+        particle_t *part = &r_particles[r_numparticles++];
+        part->origin = Vec3_MA(particles.org[i], time, particles.vel[i]);
+        part->origin = Vec3_MA(part->origin, time * time, particles.accel[i]);
+        part->rgba = particles.rgba[i];
+        part->color = particles.color[i];
+        part->alpha = min(alpha, 1.0f);
+        part->scale = particles.scale[i];
+
+        // compact live range
+        if (i != j) {
+            particles.time[j] = particles.time[i];
+            particles.alpha[j] = particles.alpha[i];
+            particles.alphavel[j] = particles.alphavel[i];
+            particles.org[j] = particles.org[i];
+            particles.vel[j] = particles.vel[i];
+            particles.accel[j] = particles.accel[i];
+            particles.color[j] = particles.color[i];
+            particles.scale[j] = particles.scale[i];
+            particles.rgba[j] = particles.rgba[i];
         }
+        j++;
     }
 
-    trap_R_LocateParticles(r_particles, r_numparticles);
+    num_particles = j;
 
-    active_particles = active;
+    trap_R_LocateParticles(r_particles, r_numparticles);
 }
 
 /*
@@ -251,6 +251,8 @@ void CG_DeltaFrame(void)
     for (int i = 0; i < cg.frame->num_entities; i++)
         CG_DeltaEntity(&cg.frame->entities[i]);
 
+    CG_LinkSolidEntities();
+
     // fire events. due to footstep tracing this must be done
     // after updating all entities.
     for (int i = 0; i < cg.frame->num_entities; i++) {
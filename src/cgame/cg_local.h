@@ -40,6 +40,7 @@ typedef struct {
 
     box3_t          box;
     float           radius;             // from mid point
+    box3_t          absbox;             // world space bounds, if solid
 
     unsigned        serverframe;        // if not current, this ent isn't in the frame
 
@@ -88,10 +89,17 @@ typedef struct {
 
     player_state_t  predicted_ps;    // generated by CG_PredictMovement
 
+    // predicted state after the last complete usercmd, valid until next
+    // server frame. saves replaying all unacknowledged usercmds each frame.
+    player_state_t  predicted_cache_ps;
+    unsigned        predicted_cache_cmd;    // 0 if not valid
+
     // rebuilt each valid frame
     centity_t       *solid_entities[MAX_PACKET_ENTITIES];
     int             num_solid_entities;
 
+    int             num_trace_tests;    // entity clip tests, for cg_showtraces
+
     cg_server_frame_t   *frame;     // received from server
     cg_server_frame_t   *oldframe;
     cg_server_frame_t   frames[2];
@@ -412,14 +420,19 @@ extern vm_cvar_t    cg_nobob;
 #define SHOWSTEP(...) \
     do { if (cg_showstep.integer) \
         Com_LPrintf(PRINT_DEVELOPER, __VA_ARGS__); } while (0)
+#define SHOWTRACES(...) \
+    do { if (cg_showtraces.integer) \
+        Com_LPrintf(PRINT_DEVELOPER, __VA_ARGS__); } while (0)
 extern vm_cvar_t    cg_showmiss;
 extern vm_cvar_t    cg_showclamp;
 extern vm_cvar_t    cg_showstep;
 extern vm_cvar_t    cg_showevents;
+extern vm_cvar_t    cg_showtraces;
 #else
 #define SHOWMISS(...)
 #define SHOWCLAMP(...)
 #define SHOWSTEP(...)
+#define SHOWTRACES(...)
 #endif
 
 extern vm_cvar_t    cg_vwep;
@@ -574,6 +587,7 @@ static inline bool CG_PredictionEnabled(void)
 void CG_PredictAngles(void);
 void CG_PredictMovement(void);
 void CG_CheckPredictionError(void);
+void CG_LinkSolidEntities(void);
 void CG_TraceArgs(trace_t *tr, const trace_args_t *args);
 contents_t CG_PointContents(vec3_t point);
 
@@ -598,9 +612,9 @@ static inline trace_t CG_Trace(vec3_t start, vec3_t end, box3_t box, int passent
 #define PARTICLE_GRAVITY    40
 #define INSTANT_PARTICLE    -10000.0f
 
-typedef struct cparticle_s {
-    struct cparticle_s    *next;
+#define MAX_NEW_PARTICLES   (MAX_PARTICLES / 2)   // per frame
 
+typedef struct {
     int     time;
     vec3_t  org;
     vec3_t  vel;
@@ -653,8 +667,12 @@ void CG_TeleporterParticles(vec3_t org);
 void CG_TeleportParticles(vec3_t org);
 void CG_ParticleEffect(vec3_t org, vec3_t dir, int color, int count);
 void CG_ParticleEffect2(vec3_t org, vec3_t dir, int color, int count);
+cparticle_t *CG_AllocParticles(int *count);
 cparticle_t *CG_AllocParticle(void);
 void CG_AddParticles(void);
+#if USE_DEBUG
+void CG_StressParticles(int count);
+#endif
 cdlight_t *CG_AllocDlight(int key);
 void CG_AddDLights(void);
 void CG_SetLightStyle(int index, const char *s);
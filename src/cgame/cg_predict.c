@@ -29,6 +29,9 @@ void CG_CheckPredictionError(void)
     unsigned    cmd;
     float       len;
 
+    // new server frame, prediction must be redone from scratch
+    cg.predicted_cache_cmd = 0;
+
     if (cgs.demoplayback)
         return;
 
@@ -63,6 +66,165 @@ void CG_CheckPredictionError(void)
     cg.prediction_error = delta;
 }
 
+/*
+===============================================================================
+
+ENTITY AREA CHECKING
+
+Same idea as server side area nodes, but the tree is rebuilt each server
+frame around solid entities of the frame.
+===============================================================================
+*/
+
+typedef struct {
+    int     axis;       // -1 = leaf node
+    float   dist;
+    int     children[2];
+    int     first, count;   // range of area_entities
+} areanode_t;
+
+#define AREA_DEPTH  4
+#define AREA_NODES  32
+
+static areanode_t   area_nodes[AREA_NODES];
+static int          area_numnodes;
+static centity_t    *area_entities[MAX_PACKET_ENTITIES];
+
+static box3_t       area_box;
+static centity_t    *area_list[MAX_PACKET_ENTITIES];
+static int          area_count;
+
+static int CG_CreateAreaNode(int depth, box3_t box)
+{
+    int         nodenum = area_numnodes++;
+    areanode_t  *anode = &area_nodes[nodenum];
+    vec3_t      size;
+    box3_t      box2;
+
+    anode->first = anode->count = 0;
+
+    if (depth == AREA_DEPTH) {
+        anode->axis = -1;
+        anode->children[0] = anode->children[1] = -1;
+        return nodenum;
+    }
+
+    size = Box3_Size(box);
+    if (size.x > size.y)
+        anode->axis = 0;
+    else
+        anode->axis = 1;
+
+    anode->dist = 0.5f * (box.maxs.xyz[anode->axis] + box.mins.xyz[anode->axis]);
+
+    box2 = box;
+    box2.mins.xyz[anode->axis] = box2.maxs.xyz[anode->axis] = anode->dist;
+
+    anode->children[0] = CG_CreateAreaNode(depth + 1, Box3(box2.mins, box.maxs));
+    anode->children[1] = CG_CreateAreaNode(depth + 1, Box3(box.mins,  box2.maxs));
+
+    return nodenum;
+}
+
+/*
+====================
+CG_LinkSolidEntities
+
+Called after solid entity list is rebuilt for a new server frame.
+====================
+*/
+void CG_LinkSolidEntities(void)
+{
+    byte        nodenums[MAX_PACKET_ENTITIES];
+    box3_t      box = Box3_Null();
+    centity_t   *ent;
+    int         i, first;
+
+    area_numnodes = 0;
+    if (!cg.num_solid_entities)
+        return;
+
+    for (i = 0; i < cg.num_solid_entities; i++) {
+        ent = cg.solid_entities[i];
+        if (ent->current.solid == PACKED_BSP && !Vec3_IsEmpty(ent->current.angles))
+            ent->absbox = Box3_Translate(Box3_FromRotated(ent->box), ent->current.origin);
+        else
+            ent->absbox = Box3_Translate(ent->box, ent->current.origin);
+        ent->absbox = Box3_Expand(ent->absbox, 1);
+        box = Box3_Union(box, ent->absbox);
+    }
+
+    CG_CreateAreaNode(0, box);
+
+    // find the first node that each entity crosses
+    for (i = 0; i < cg.num_solid_entities; i++) {
+        const areanode_t *node = area_nodes;
+
+        ent = cg.solid_entities[i];
+        while (1) {
+            if (node->axis == -1)
+                break;
+            if (ent->absbox.mins.xyz[node->axis] > node->dist)
+                node = &area_nodes[node->children[0]];
+            else if (ent->absbox.maxs.xyz[node->axis] < node->dist)
+                node = &area_nodes[node->children[1]];
+            else
+                break;        // crosses the node
+        }
+        nodenums[i] = node - area_nodes;
+        area_nodes[nodenums[i]].count++;
+    }
+
+    // sort entities by node, preserving original order
+    for (i = 0, first = 0; i < area_numnodes; i++) {
+        area_nodes[i].first = first;
+        first += area_nodes[i].count;
+        area_nodes[i].count = 0;
+    }
+
+    for (i = 0; i < cg.num_solid_entities; i++) {
+        areanode_t *node = &area_nodes[nodenums[i]];
+        area_entities[node->first + node->count++] = cg.solid_entities[i];
+    }
+}
+
+static void CG_AreaEntities_r(const areanode_t *node)
+{
+    for (int i = 0; i < node->count; i++) {
+        centity_t *ent = area_entities[node->first + i];
+        if (Box3_Intersects(ent->absbox, area_box))
+            area_list[area_count++] = ent;
+    }
+
+    if (node->axis == -1)
+        return;        // terminal node
+
+    // recurse down both sides
+    if (area_box.maxs.xyz[node->axis] > node->dist)
+        CG_AreaEntities_r(&area_nodes[node->children[0]]);
+    if (area_box.mins.xyz[node->axis] < node->dist)
+        CG_AreaEntities_r(&area_nodes[node->children[1]]);
+}
+
+/*
+====================
+CG_AreaEntities
+
+Fills area_list with solid entities of current frame whose bounds intersect
+the box. Returns number of entities found.
+====================
+*/
+static int CG_AreaEntities(box3_t box)
+{
+    area_box = box;
+    area_count = 0;
+
+    if (area_numnodes)
+        CG_AreaEntities_r(area_nodes);
+
+    return area_count;
+}
+
 /*
 ====================
 CG_ClipMoveToEntities
@@ -72,9 +234,24 @@ static void CG_ClipMoveToEntities(trace_t *tr, const trace_args_t *args)
 {
     trace_t     trace;
     qhandle_t   hmodel;
+    box3_t      box;
+    int         num;
+
+    // create the bounding box of the entire move
+    for (int i = 0; i < 3; i++) {
+        if (args->end.xyz[i] > args->start.xyz[i]) {
+            box.mins.xyz[i] = args->start.xyz[i] + args->box.mins.xyz[i] - 1;
+            box.maxs.xyz[i] = args->end.xyz[i]   + args->box.maxs.xyz[i] + 1;
+        } else {
+            box.mins.xyz[i] = args->end.xyz[i]   + args->box.mins.xyz[i] - 1;
+            box.maxs.xyz[i] = args->start.xyz[i] + args->box.maxs.xyz[i] + 1;
+        }
+    }
+
+    num = CG_AreaEntities(box);
 
-    for (int i = 0; i < cg.num_solid_entities; i++) {
-        const centity_t *ent = cg.solid_entities[i];
+    for (int i = 0; i < num; i++) {
+        const centity_t *ent = area_list[i];
 
         if (ent->current.number < cgs.maxclients && !(args->mask & CONTENTS_PLAYER))
             continue;
@@ -93,6 +270,7 @@ static void CG_ClipMoveToEntities(trace_t *tr, const trace_args_t *args)
 
         trap_TransformedBoxTrace(&trace, args, hmodel,
                                  ent->current.origin, ent->current.angles);
+        cg.num_trace_tests++;
 
         CM_ClipEntity(tr, &trace, ent->current.number);
     }
@@ -125,15 +303,17 @@ static void CG_ClipArgs(trace_t *tr, const trace_args_t *args)
 contents_t CG_PointContents(vec3_t point)
 {
     contents_t contents = trap_PointContents(point, MODELINDEX_WORLD);
+    int num = CG_AreaEntities(Box3_FromPoint(point));
 
-    for (int i = 0; i < cg.num_solid_entities; i++) {
-        const centity_t *ent = cg.solid_entities[i];
+    for (int i = 0; i < num; i++) {
+        const centity_t *ent = area_list[i];
 
         if (ent->current.solid != PACKED_BSP) // special value for bmodel
             continue;
 
         contents |= trap_TransformedPointContents(point,
             ent->current.modelindex, ent->current.origin, ent->current.angles);
+        cg.num_trace_tests++;
     }
 
     return contents;
@@ -171,6 +351,11 @@ static void CG_RunUsercmd(pmove_t *pm, unsigned frame)
 /*
 =================
 CG_PredictMovement
+
+Usercmds before the current one are complete and won't change until next
+server frame arrives, so prediction resumes from the state cached after the
+last of them. Only the current (possibly partial) usercmd and any commands
+completed since previous call are run each frame.
 =================
 */
 void CG_PredictMovement(void)
@@ -213,10 +398,23 @@ void CG_PredictMovement(void)
     pm.pointcontents = CG_PointContents;
     pm.s = &cg.predicted_ps;
 
+    // resume from cached state if still in range
+    if (cg.predicted_cache_cmd - ack - 1 < current - ack - 1) {
+        cg.predicted_ps = cg.predicted_cache_ps;
+        ack = cg.predicted_cache_cmd;
+    }
+
     // run frames
-    while (++ack <= current)
+    while (++ack <= current) {
         CG_RunUsercmd(&pm, ack);
 
+        // current usercmd may be partial, cache the one before
+        if (ack == current - 1) {
+            cg.predicted_cache_ps = cg.predicted_ps;
+            cg.predicted_cache_cmd = ack;
+        }
+    }
+
     // check for ducking
     if (cg.predicted_ps.viewheight != viewheight) {
         cg.duck_time = cg.time + DUCK_TIME;
@@ -395,9 +395,13 @@ LAGOMETER
 #define LAG_BASE    0xD5
 #define LAG_WARN    0xDC
 #define LAG_CRIT    0xF2
+#define LAG_DEPTH   0x0F
+
+#define LAG_DEPTH_SCALE 4   // pixels per buffered frame
 
 static struct {
     unsigned samples[LAG_WIDTH];
+    byte depth[LAG_WIDTH];
     unsigned head;
 } lag;
 
@@ -411,6 +415,7 @@ void SCR_LagSample(const cg_server_frame_t *frame)
     unsigned ping;
 
     if (!frame) {
+        lag.depth[lag.head % LAG_WIDTH] = 0;
         lag.samples[lag.head++ % LAG_WIDTH] = 200 | LAG_CRIT_BIT;
         return;
     }
@@ -419,6 +424,7 @@ void SCR_LagSample(const cg_server_frame_t *frame)
     if (frame->flags)
         ping |= LAG_WARN_BIT;
 
+    lag.depth[lag.head % LAG_WIDTH] = min(frame->buffered, 255);
     lag.samples[lag.head++ % LAG_WIDTH] = ping;
 }
 
@@ -453,6 +459,11 @@ static void SCR_LagDraw(int x, int y)
         v = Q_clip((v - v_min) * LAG_HEIGHT / v_range, 0, LAG_HEIGHT);
 
         trap_R_DrawFill8(x + LAG_WIDTH - i - 1, y + LAG_HEIGHT - v, 1, v, c);
+
+        // overlay jitter buffer depth
+        v = lag.depth[j % LAG_WIDTH] * LAG_DEPTH_SCALE;
+        if (v)
+            trap_R_DrawFill8(x + LAG_WIDTH - i - 1, y + LAG_HEIGHT - min(v, LAG_HEIGHT), 1, 1, LAG_DEPTH);
     }
 }
 
@@ -689,6 +689,9 @@ CG_RenderView
 */
 void CG_RenderView(void)
 {
+    SHOWTRACES("%i: %i trace tests\n", cg.frame->number, cg.num_trace_tests);
+    cg.num_trace_tests = 0;
+
     CG_PredictMovement();
 
     CG_CalcViewValues();
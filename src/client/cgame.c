@@ -208,7 +208,7 @@ static bool PF_GetUsercmd(unsigned number, usercmd_t *ucmd)
 
 static unsigned PF_GetServerFrameNumber(void)
 {
-    return cl.frame.number;
+    return cl.jitter.released;
 }
 
 static bool PF_GetServerFrame(unsigned number, cg_server_frame_t *out)
@@ -228,6 +228,11 @@ static bool PF_GetServerFrame(unsigned number, cg_server_frame_t *out)
     out->cmdnum = frame->cmdnum;
     out->latency = frame->latency;
 
+    out->arrival = frame->arrival;
+    out->jitter = cl.jitter.jitter;
+    out->delay = cl.jitter.delay;
+    out->buffered = cl.jitter.depth;
+
     memcpy(out->areabits, frame->areabits, sizeof(out->areabits));
     out->areabytes = frame->areabytes;
 
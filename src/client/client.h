@@ -71,6 +71,7 @@ typedef struct {
     unsigned        servertime;
     unsigned        cmdnum;
     unsigned        latency;
+    unsigned        arrival;    // cls.realtime frame was received
 
     byte            areabits[MAX_MAP_AREA_BYTES];
     int             areabytes;
@@ -81,6 +82,18 @@ typedef struct {
     unsigned        first_entity;
 } server_frame_t;
 
+// frames are held back and released to cgame at steady pace
+typedef struct {
+    unsigned    released;       // latest frame number visible to cgame
+    unsigned    depth;          // number of frames held back
+    bool        valid;
+    int         lasttransit;
+    float       base;           // shortest transit time seen, drifts upwards
+    float       jitter;         // mean transit time variation, msec
+    float       peak;           // recent peak transit time above base
+    float       delay;          // current playout delay, msec
+} jitterbuf_t;
+
 //
 // the client_state_t structure is wiped completely at every
 // server map change
@@ -107,6 +120,7 @@ typedef struct {
 
     server_frame_t  frames[UPDATE_BACKUP];
     server_frame_t  frame;          // received from server
+    jitterbuf_t     jitter;
 
     size_t          dcs[BC_COUNT(MAX_CONFIGSTRINGS)];
 
@@ -289,6 +303,7 @@ typedef struct {
     struct {
         qhandle_t   playback;
         qhandle_t   recording;
+        char        name[MAX_OSPATH];   // path of demo being played back
         unsigned    time_start;
         unsigned    time_frames;
         int         last_server_frame;  // number of server frame the last svc_frame was written
@@ -339,6 +354,9 @@ extern cvar_t   *cl_beginmapcmd;
 
 extern cvar_t   *cl_async;
 
+extern cvar_t   *cl_jitterbuffer;
+extern cvar_t   *cl_jitter_max;
+
 extern cvar_t   *allow_download;
 
 //
@@ -349,6 +367,7 @@ extern cvar_t   *info_spectator;
 extern cvar_t   *info_name;
 extern cvar_t   *info_skin;
 extern cvar_t   *info_rate;
+extern cvar_t   *info_snaps;
 extern cvar_t   *info_fov;
 extern cvar_t   *info_msg;
 extern cvar_t   *info_hand;
@@ -415,6 +434,7 @@ void CL_SendCmd(void);
 
 void CL_ParseServerMessage(void);
 bool CL_SeekDemoMessage(void);
+void CL_ReleaseFrames(void);
 
 //
 // demo.c
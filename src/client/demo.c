@@ -21,12 +21,14 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 //
 
 #include "client.h"
+#include "common/intreadwrite.h"
 
 static byte     demo_buffer[MAX_MSGLEN];
 
 static cvar_t   *cl_demosnaps;
 static cvar_t   *cl_demowait;
 static cvar_t   *cl_demosuspendtoggle;
+static cvar_t   *cl_demoindex;
 
 // =========================================================================
 
@@ -670,6 +672,7 @@ static void CL_PlayDemo_f(void)
     CL_Disconnect(ERR_RECONNECT);
 
     cls.demo.playback = f;
+    Q_strlcpy(cls.demo.name, name, sizeof(cls.demo.name));
     cls.demo.compat = !strcmp(Cmd_Argv(2), "compat");
     cls.state = ca_connected;
     Q_strlcpy(cls.servername, COM_SkipPath(name), sizeof(cls.servername));
@@ -793,6 +796,161 @@ static demosnap_t *find_snapshot(int64_t dest, bool byte_seek)
     return cls.demo.snapshots[max(r, 0)];
 }
 
+/*
+Demo index file format (all integers little endian):
+
+header:
+    uint32_t    magic
+    uint32_t    version
+    int64_t     file_size       // size of demo file after the first frame
+    int64_t     file_offset     // offset of the second frame
+    uint32_t    numsnapshots
+
+followed by numsnapshots records of:
+    int64_t     servertime
+    int64_t     filepos
+    uint32_t    framenum
+    uint32_t    msglen
+    byte        data[msglen]
+*/
+
+#define DEMOINDEX_MAGIC     MakeLittleLong('D','I','D','X')
+#define DEMOINDEX_VERSION   1
+
+#define DEMOINDEX_HEADER    28
+#define DEMOINDEX_RECORD    24
+
+static bool index_path(char *buffer, size_t size)
+{
+    if (!cls.demo.name[0])
+        return false;
+    return Q_concat(buffer, size, cls.demo.name, ".idx") < size;
+}
+
+/*
+====================
+load_demo_index
+
+Loads snapshots from index file created by `demoindex'. Index is only used if
+it matches the demo being played back.
+====================
+*/
+static void load_demo_index(void)
+{
+    char buffer[MAX_OSPATH];
+    byte *data, *p, *end;
+    demosnap_t *snap;
+    uint32_t i, count, msglen;
+    int len;
+
+    if (!cl_demoindex->integer || cl_demosnaps->integer <= 0)
+        return;
+
+    if (!cls.demo.file_size)
+        return;
+
+    if (!index_path(buffer, sizeof(buffer)))
+        return;
+
+    len = FS_LoadFile(buffer, (void **)&data);
+    if (!data)
+        return;
+
+    if (len < DEMOINDEX_HEADER ||
+        RL32(data) != DEMOINDEX_MAGIC ||
+        RL32(data + 4) != DEMOINDEX_VERSION ||
+        RL64(data + 8) != cls.demo.file_size ||
+        RL64(data + 16) != cls.demo.file_offset) {
+        Com_DPrintf("Ignoring stale demo index %s\n", buffer);
+        goto done;
+    }
+
+    count = RL32(data + 24);
+    if (count > MAX_SNAPSHOTS)
+        goto fail;
+
+    CL_FreeDemoSnapshots();
+
+    p = data + DEMOINDEX_HEADER;
+    end = data + len;
+    for (i = 0; i < count; i++) {
+        if (end - p < DEMOINDEX_RECORD)
+            goto fail;
+        msglen = RL32(p + 20);
+        if (!msglen || msglen > MAX_MSGLEN || end - p - DEMOINDEX_RECORD < msglen)
+            goto fail;
+
+        snap = Z_Malloc(sizeof(*snap) + msglen - 1);
+        snap->servertime = RL64(p);
+        snap->filepos = RL64(p + 8);
+        snap->framenum = RL32(p + 16);
+        snap->msglen = msglen;
+        memcpy(snap->data, p + DEMOINDEX_RECORD, msglen);
+        p += DEMOINDEX_RECORD + msglen;
+
+        if (snap->filepos < cls.demo.file_offset ||
+            snap->filepos > cls.demo.file_offset + cls.demo.file_size ||
+            (i && snap->filepos <= cls.demo.snapshots[i - 1]->filepos)) {
+            Z_Free(snap);
+            goto fail;
+        }
+
+        cls.demo.snapshots = Z_Realloc(cls.demo.snapshots, sizeof(cls.demo.snapshots[0]) * Q_ALIGN(cls.demo.numsnapshots + 1, MIN_SNAPSHOTS));
+        cls.demo.snapshots[cls.demo.numsnapshots++] = snap;
+    }
+
+    if (count)
+        cls.demo.last_snapshot_pos = cls.demo.snapshots[count - 1]->filepos;
+
+    Com_DPrintf("Loaded %u snapshots from %s\n", count, buffer);
+    goto done;
+
+fail:
+    Com_WPrintf("Demo index %s is corrupt\n", buffer);
+    CL_FreeDemoSnapshots();
+done:
+    FS_FreeFile(data);
+}
+
+static int write_demo_index(const char *path)
+{
+    byte header[DEMOINDEX_HEADER];
+    byte record[DEMOINDEX_RECORD];
+    qhandle_t f;
+    int ret;
+
+    ret = FS_OpenFile(path, &f, FS_MODE_WRITE);
+    if (!f)
+        return ret;
+
+    WL32(header, DEMOINDEX_MAGIC);
+    WL32(header + 4, DEMOINDEX_VERSION);
+    WL64(header + 8, cls.demo.file_size);
+    WL64(header + 16, cls.demo.file_offset);
+    WL32(header + 24, cls.demo.numsnapshots);
+
+    ret = FS_Write(header, sizeof(header), f);
+    for (int i = 0; i < cls.demo.numsnapshots && ret >= 0; i++) {
+        const demosnap_t *snap = cls.demo.snapshots[i];
+
+        WL64(record, snap->servertime);
+        WL64(record + 8, snap->filepos);
+        WL32(record + 16, snap->framenum);
+        WL32(record + 20, snap->msglen);
+
+        ret = FS_Write(record, sizeof(record), f);
+        if (ret >= 0)
+            ret = FS_Write(snap->data, snap->msglen, f);
+    }
+
+    if (ret >= 0)
+        ret = FS_CloseFile(f);
+    else
+        FS_CloseFile(f);
+
+    return ret;
+}
+
 /*
 ====================
 CL_FirstDemoFrame
@@ -830,6 +988,9 @@ void CL_FirstDemoFrame(void)
 
     // force initial snapshot
     cls.demo.last_snapshot_pos = INT64_MIN;
+
+    // pick up snapshots from index file
+    load_demo_index();
 }
 
 /*
@@ -848,77 +1009,20 @@ void CL_FreeDemoSnapshots(void)
 
 /*
 ====================
-CL_Seek_f
+seek_demo
+
+Seeks to the given file position or server time. If `wait' is true, stops at
+the end of demo file instead of finishing playback. Returns false if playback
+was finished.
 ====================
 */
-static void CL_Seek_f(void)
+static bool seek_demo(int64_t dest, bool byte_seek, bool back_seek, bool wait)
 {
     demosnap_t *snap;
-    int64_t dest, frames, pos;
-    bool byte_seek, back_seek;
+    int64_t pos;
     char *from, *to;
     int ret;
 
-    if (Cmd_Argc() < 2) {
-        Com_Printf("Usage: %s [+-]<timespec|percent>[%%]\n", Cmd_Argv(0));
-        return;
-    }
-
-    if (!cls.demo.playback) {
-        Com_Printf("Not playing a demo.\n");
-        return;
-    }
-
-    to = Cmd_Argv(1);
-
-    if (strchr(to, '%')) {
-        char *suf;
-        float percent = strtof(to, &suf);
-        if (suf == to || strcmp(suf, "%") || !isfinite(percent)) {
-            Com_Printf("Invalid percentage.\n");
-            return;
-        }
-
-        if (!cls.demo.file_size) {
-            Com_Printf("Unknown file size, can't seek.\n");
-            return;
-        }
-
-        percent = Q_clipf(percent, 0, 100);
-        dest = cls.demo.file_offset + cls.demo.file_size * percent / 100;
-
-        byte_seek = true;
-        back_seek = dest < FS_Tell(cls.demo.playback);
-    } else {
-        if (*to == '-' || *to == '+') {
-            // relative to current frame
-            if (!Com_ParseTimespec(to + 1, &frames)) {
-                Com_Printf("Invalid relative timespec.\n");
-                return;
-            }
-            if (*to == '-')
-                frames = -frames;
-            dest = cl.frame.servertime + frames;
-        } else {
-            // relative to first frame
-            if (!Com_ParseTimespec(to, &frames)) {
-                Com_Printf("Invalid absolute timespec.\n");
-                return;
-            }
-            dest = cls.demo.starttime + frames;
-            frames = dest - cl.frame.servertime;
-        }
-
-        if (!frames)
-            return; // already there
-
-        byte_seek = false;
-        back_seek = frames < 0;
-    }
-
-    if (!back_seek && cls.demo.eof && cl_demowait->integer)
-        return; // already at end
-
     // disable effects processing
     cls.demo.seeking = true;
 
@@ -936,6 +1040,10 @@ static void CL_Seek_f(void)
     if (back_seek || cls.demo.last_snapshot_pos > pos) {
         snap = find_snapshot(dest, byte_seek);
 
+        // don't go back if already past the best snapshot
+        if (snap && !back_seek && snap->filepos <= pos)
+            snap = NULL;
+
         if (snap) {
             Com_DPrintf("found snap at %d\n", snap->framenum);
             ret = FS_Seek(cls.demo.playback, snap->filepos, SEEK_SET);
@@ -978,13 +1086,13 @@ static void CL_Seek_f(void)
             break;
 
         ret = read_next_message(cls.demo.playback);
-        if (ret == 0 && cl_demowait->integer) {
+        if (ret == 0 && wait) {
             cls.demo.eof = true;
             break;
         }
         if (ret <= 0) {
             finish_demo(ret);
-            return;
+            return false;
         }
 
         if (CL_SeekDemoMessage())
@@ -1012,6 +1120,137 @@ static void CL_Seek_f(void)
 
 done:
     cls.demo.seeking = false;
+    return true;
+}
+
+/*
+====================
+CL_Seek_f
+====================
+*/
+static void CL_Seek_f(void)
+{
+    int64_t dest, frames;
+    bool byte_seek, back_seek;
+    char *to;
+
+    if (Cmd_Argc() < 2) {
+        Com_Printf("Usage: %s [+-]<timespec|percent>[%%]\n", Cmd_Argv(0));
+        return;
+    }
+
+    if (!cls.demo.playback) {
+        Com_Printf("Not playing a demo.\n");
+        return;
+    }
+
+    to = Cmd_Argv(1);
+
+    if (strchr(to, '%')) {
+        char *suf;
+        float percent = strtof(to, &suf);
+        if (suf == to || strcmp(suf, "%") || !isfinite(percent)) {
+            Com_Printf("Invalid percentage.\n");
+            return;
+        }
+
+        if (!cls.demo.file_size) {
+            Com_Printf("Unknown file size, can't seek.\n");
+            return;
+        }
+
+        percent = Q_clipf(percent, 0, 100);
+        dest = cls.demo.file_offset + cls.demo.file_size * percent / 100;
+
+        byte_seek = true;
+        back_seek = dest < FS_Tell(cls.demo.playback);
+    } else {
+        if (*to == '-' || *to == '+') {
+            // relative to current frame
+            if (!Com_ParseTimespec(to + 1, &frames)) {
+                Com_Printf("Invalid relative timespec.\n");
+                return;
+            }
+            if (*to == '-')
+                frames = -frames;
+            dest = cl.frame.servertime + frames;
+        } else {
+            // relative to first frame
+            if (!Com_ParseTimespec(to, &frames)) {
+                Com_Printf("Invalid absolute timespec.\n");
+                return;
+            }
+            dest = cls.demo.starttime + frames;
+            frames = dest - cl.frame.servertime;
+        }
+
+        if (!frames)
+            return; // already there
+
+        byte_seek = false;
+        back_seek = frames < 0;
+    }
+
+    if (!back_seek && cls.demo.eof && cl_demowait->integer)
+        return; // already at end
+
+    seek_demo(dest, byte_seek, back_seek, cl_demowait->integer);
+}
+
+/*
+====================
+CL_IndexDemo_f
+
+Scans the rest of demo file collecting snapshots, then saves all of them into
+index file next to the demo. Index is picked up automatically the next time
+this demo is played back, making any seek instant.
+====================
+*/
+static void CL_IndexDemo_f(void)
+{
+    char buffer[MAX_OSPATH];
+    int64_t servertime;
+    int ret;
+
+    if (!cls.demo.playback) {
+        Com_Printf("Not playing a demo.\n");
+        return;
+    }
+
+    if (cls.state != ca_active) {
+        Com_Printf("Demo playback has not started yet.\n");
+        return;
+    }
+
+    if (!cls.demo.file_size) {
+        Com_Printf("Unknown file size, can't index.\n");
+        return;
+    }
+
+    if (cl_demosnaps->integer <= 0) {
+        Com_Printf("Snapshots are disabled, set %s to enable.\n", cl_demosnaps->name);
+        return;
+    }
+
+    if (!index_path(buffer, sizeof(buffer))) {
+        Com_Printf("Oversize index filename.\n");
+        return;
+    }
+
+    // run through the rest of demo file
+    servertime = cl.frame.servertime;
+    if (!seek_demo(INT64_MAX, true, false, true))
+        return;
+
+    ret = write_demo_index(buffer);
+    if (ret < 0)
+        Com_EPrintf("Couldn't write %s: %s\n", buffer, Q_ErrorString(ret));
+    else
+        Com_Printf("Wrote %d snapshots to %s.\n", cls.demo.numsnapshots, buffer);
+
+    // return to where we were
+    if (cl.frame.servertime != servertime)
+        seek_demo(servertime, false, true, cl_demowait->integer);
 }
 
 static void parse_info_string(demoInfo_t *info, int clientNum, int index)
@@ -1168,6 +1407,7 @@ static const cmdreg_t c_demo[] = {
     { "suspend", CL_Suspend_f },
     { "resume", CL_Resume_f },
     { "seek", CL_Seek_f },
+    { "demoindex", CL_IndexDemo_f },
 
     { NULL }
 };
@@ -1182,6 +1422,7 @@ void CL_InitDemos(void)
     cl_demosnaps = Cvar_Get("cl_demosnaps", "100", 0);
     cl_demowait = Cvar_Get("cl_demowait", "0", 0);
     cl_demosuspendtoggle = Cvar_Get("cl_demosuspendtoggle", "1", 0);
+    cl_demoindex = Cvar_Get("cl_demoindex", "1", 0);
 
     Cmd_Register(c_demo);
 }
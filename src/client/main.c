@@ -25,6 +25,8 @@ cvar_t  *cl_timeout;
 cvar_t  *cl_warn_on_fps_rounding;
 cvar_t  *cl_maxfps;
 cvar_t  *cl_async;
+cvar_t  *cl_jitterbuffer;
+cvar_t  *cl_jitter_max;
 cvar_t  *r_maxfps;
 cvar_t  *cl_autopause;
 
@@ -52,6 +54,7 @@ cvar_t  *info_spectator;
 cvar_t  *info_name;
 cvar_t  *info_skin;
 cvar_t  *info_rate;
+cvar_t  *info_snaps;
 cvar_t  *info_fov;
 cvar_t  *info_msg;
 cvar_t  *info_hand;
@@ -1792,6 +1795,8 @@ static void CL_InitLocal(void)
     cl_maxfps->changed = cl_sync_changed;
     cl_async = Cvar_Get("cl_async", "1", 0);
     cl_async->changed = cl_sync_changed;
+    cl_jitterbuffer = Cvar_Get("cl_jitterbuffer", "1", 0);
+    cl_jitter_max = Cvar_Get("cl_jitter_max", "100", 0);
     r_maxfps = Cvar_Get("r_maxfps", "0", 0);
     r_maxfps->changed = cl_sync_changed;
     cl_autopause = Cvar_Get("cl_autopause", "1", 0);
@@ -1834,6 +1839,7 @@ static void CL_InitLocal(void)
     info_name = Cvar_Get("name", "unnamed", CVAR_USERINFO | CVAR_ARCHIVE);
     info_skin = Cvar_Get("skin", "male/grunt", CVAR_USERINFO | CVAR_ARCHIVE);
     info_rate = Cvar_Get("rate", "15000", CVAR_USERINFO | CVAR_ARCHIVE);
+    info_snaps = Cvar_Get("snaps", "0", CVAR_USERINFO | CVAR_ARCHIVE);
     info_msg = Cvar_Get("msg", "1", CVAR_USERINFO | CVAR_ARCHIVE);
     info_hand = Cvar_Get("hand", "0", CVAR_USERINFO | CVAR_ARCHIVE);
     //info_hand->changed = info_hand_changed;
@@ -2238,6 +2244,9 @@ unsigned CL_Frame(unsigned msec)
     // read next demo frame
     CL_DemoFrame();
 
+    // release buffered server frames to cgame
+    CL_ReleaseFrames();
+
     // resend a connection request if necessary
     CL_CheckForResend();
 
@@ -163,6 +163,98 @@ static void CL_ParsePacketEntities(const server_frame_t *oldframe, server_frame_
     }
 }
 
+/*
+=====================================================================
+
+  JITTER BUFFER
+
+=====================================================================
+*/
+
+// updates transit time statistics and playout delay with new frame
+static void CL_JitterSample(const server_frame_t *frame)
+{
+    jitterbuf_t *j = &cl.jitter;
+    int transit = frame->arrival - frame->servertime;
+    float target;
+
+    if (!j->valid) {
+        j->valid = true;
+        j->base = j->lasttransit = transit;
+        return;
+    }
+
+    // RFC 3550 style interarrival jitter
+    j->jitter += (abs(transit - j->lasttransit) - j->jitter) / 16;
+    j->lasttransit = transit;
+
+    // follow the fastest path, but let clock drift and route
+    // changes move it upwards
+    if (transit < j->base)
+        j->base = transit;
+    else
+        j->base += (transit - j->base) / 256;
+
+    // peak follower of how late frames are
+    if (transit - j->base > j->peak)
+        j->peak = transit - j->base;
+    else
+        j->peak += (transit - j->base - j->peak) / 64;
+
+    target = Q_clipf(j->peak, 0, Cvar_ClampInteger(cl_jitter_max, 0, 1000));
+
+    // grow at once to stop stutter, shrink slowly so that
+    // cgame time doesn't jump forward
+    if (target > j->delay)
+        j->delay = target;
+    else
+        j->delay = max(target, j->delay - 0.5f);
+
+    SHOWCLAMP(3, "transit %d jitter %.1f peak %.1f delay %.1f\n",
+              transit - (int)j->base, j->jitter, j->peak, j->delay);
+}
+
+/*
+==================
+CL_ReleaseFrames
+
+Makes received frames visible to cgame once their playout time, servertime
+plus shortest transit time plus delay, has come. This spaces out frames that
+arrived in bursts, so cgame has a newer frame to interpolate towards.
+==================
+*/
+void CL_ReleaseFrames(void)
+{
+    jitterbuf_t *j = &cl.jitter;
+    const server_frame_t *frame;
+    unsigned number;
+
+    if (cls.demo.playback || !cl_jitterbuffer->integer || !j->valid) {
+        j->released = cl.frame.number;
+        j->depth = 0;
+        return;
+    }
+
+    // never fall behind too far
+    if (cl.frame.number - j->released > UPDATE_BACKUP / 2)
+        j->released = cl.frame.number - UPDATE_BACKUP / 2;
+
+    for (number = j->released + 1; number - 1 != cl.frame.number; number++) {
+        frame = &cl.frames[number & UPDATE_MASK];
+        if (frame->number == number && frame->valid &&
+            (int)(cls.realtime - frame->servertime) < j->base + j->delay)
+            break;
+        j->released = number;
+    }
+
+    j->depth = 0;
+    for (number = j->released + 1; number - 1 != cl.frame.number; number++) {
+        frame = &cl.frames[number & UPDATE_MASK];
+        if (frame->number == number && frame->valid)
+            j->depth++;
+    }
+}
+
 static void CL_SetActiveState(void)
 {
     cls.state = ca_active;
@@ -205,6 +297,7 @@ static void CL_ParseFrame(void)
         frame.number = cls.netchan.incoming_sequence;
         frame.cmdnum = h->cmdNumber;
         frame.latency = cls.realtime - h->sent;
+        frame.arrival = cls.realtime;
     }
 
     // if the frame is delta compressed from data that we no longer have
@@ -270,6 +363,9 @@ static void CL_ParseFrame(void)
     if (cls.state < ca_precached)
         return;
 
+    if (!cls.demo.playback)
+        CL_JitterSample(&frame);
+
     cl.frame = frame;
 
     // getting a valid frame message ends the connection process
@@ -471,12 +567,14 @@ static void CL_ParseServerCommand(void)
 static void CL_ParseZPacket(void)
 {
 #if USE_ZLIB
+    // message may be read from netchan buffer, so tag the inflated one
+    static const char zpacket_tag[] = "zpacket";
     sizebuf_t   temp;
     byte        buffer[MAX_MSGLEN];
     uInt        inlen, outlen;
     int         ret;
 
-    if (msg_read.data != msg_read_buffer) {
+    if (msg_read.tag == zpacket_tag) {
         Com_Error(ERR_DROP, "%s: recursively entered", __func__);
     }
 
@@ -499,6 +597,7 @@ static void CL_ParseZPacket(void)
 
     temp = msg_read;
     SZ_InitRead(&msg_read, buffer, outlen);
+    msg_read.tag = zpacket_tag;
 
     CL_ParseServerMessage();
 
@@ -18,61 +18,141 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "shared/shared.h"
 #include "common/async.h"
+#include "common/cmd.h"
+#include "common/common.h"
 #include "common/zone.h"
 #include "system/pthread.h"
+#include "system/system.h"
+
+#define MAX_WORKERS     4
+
+typedef struct {
+    asyncwork_t *head;
+    asyncwork_t *tail;
+} workqueue_t;
 
 static bool work_initialized;
 static bool work_terminate;
 static pthread_mutex_t work_lock;
 static pthread_cond_t work_cond;
-static pthread_t work_thread;
-static asyncwork_t *pend_head;
-static asyncwork_t *done_head;
-
-static void append_work(asyncwork_t **head, asyncwork_t *work)
+static pthread_t work_threads[MAX_WORKERS];
+static int num_workers;
+static workqueue_t pend_queues[ASYNC_PRIO_MAX];
+
+// completed work has its own lock so that workers finishing jobs never
+// make the main thread skip completions
+static pthread_mutex_t done_lock;
+static workqueue_t done_queue;
+
+static struct {
+    unsigned    queued;
+    unsigned    completed;
+    unsigned    pending;
+    unsigned    running;
+    unsigned    max_pending;
+    uint64_t    total_wait;
+    uint64_t    max_wait;
+    uint64_t    total_run;
+} work_stats;
+
+static void append_work(workqueue_t *q, asyncwork_t *work)
 {
-    asyncwork_t *c, **p;
-    for (p = head, c = *head; c; p = &c->next, c = c->next)
-        ;
     work->next = NULL;
-    *p = work;
+    if (q->tail)
+        q->tail->next = work;
+    else
+        q->head = work;
+    q->tail = work;
+}
+
+static asyncwork_t *remove_work(void)
+{
+    static const asyncprio_t order[ASYNC_PRIO_MAX] = {
+        ASYNC_PRIO_HIGH, ASYNC_PRIO_NORMAL, ASYNC_PRIO_LOW
+    };
+
+    for (int i = 0; i < ASYNC_PRIO_MAX; i++) {
+        workqueue_t *q = &pend_queues[order[i]];
+        asyncwork_t *work = q->head;
+        if (work) {
+            q->head = work->next;
+            if (!q->head)
+                q->tail = NULL;
+            return work;
+        }
+    }
+
+    return NULL;
 }
 
 static void *work_func(void *arg)
 {
     pthread_mutex_lock(&work_lock);
     while (1) {
-        while (!pend_head && !work_terminate)
+        asyncwork_t *work;
+
+        while (!(work = remove_work()) && !work_terminate)
             pthread_cond_wait(&work_cond, &work_lock);
 
-        asyncwork_t *work = pend_head;
         if (!work)
             break;
-        pend_head = work->next;
 
+        uint64_t start = Sys_Microseconds();
+        uint64_t wait = start - work->queue_time;
+
+        work_stats.pending--;
+        work_stats.running++;
+        work_stats.total_wait += wait;
+        work_stats.max_wait = max(work_stats.max_wait, wait);
         pthread_mutex_unlock(&work_lock);
+
         work->work_cb(work->cb_arg);
-        pthread_mutex_lock(&work_lock);
 
-        append_work(&done_head, work);
+        uint64_t run = Sys_Microseconds() - start;
+
+        pthread_mutex_lock(&done_lock);
+        append_work(&done_queue, work);
+        pthread_mutex_unlock(&done_lock);
+
+        pthread_mutex_lock(&work_lock);
+        work_stats.running--;
+        work_stats.total_run += run;
     }
     pthread_mutex_unlock(&work_lock);
 
     return NULL;
 }
 
+static int get_num_workers(void)
+{
+    int n = Sys_NumCPUs() - 1;
+    return Q_clip(n, 1, MAX_WORKERS);
+}
+
 void Com_QueueAsyncWork(asyncwork_t *work)
 {
+    Q_assert(work->priority < ASYNC_PRIO_MAX);
+
     if (!work_initialized) {
         pthread_mutex_init(&work_lock, NULL);
+        pthread_mutex_init(&done_lock, NULL);
         pthread_cond_init(&work_cond, NULL);
-        if (pthread_create(&work_thread, NULL, work_func, NULL))
-            Com_Error(ERR_FATAL, "Couldn't create async work thread");
+        work_terminate = false;
+        num_workers = get_num_workers();
+        for (int i = 0; i < num_workers; i++)
+            if (pthread_create(&work_threads[i], NULL, work_func, NULL))
+                Com_Error(ERR_FATAL, "Couldn't create async work thread");
         work_initialized = true;
     }
 
+    work = Z_CopyStruct(work);
+    work->queue_time = Sys_Microseconds();
+
     pthread_mutex_lock(&work_lock);
-    append_work(&pend_head, Z_CopyStruct(work));
+    append_work(&pend_queues[work->priority], work);
+    work_stats.queued++;
+    work_stats.pending++;
+    work_stats.max_pending = max(work_stats.max_pending, work_stats.pending);
     pthread_mutex_unlock(&work_lock);
 
     pthread_cond_signal(&work_cond);
@@ -84,18 +164,19 @@ void Com_CompleteAsyncWork(void)
 
     if (!work_initialized)
         return;
-    if (pthread_mutex_trylock(&work_lock))
-        return;
-    if (q_unlikely(done_head)) {
-        for (work = done_head; work; work = next) {
-            next = work->next;
-            if (work->done_cb)
-                work->done_cb(work->cb_arg);
-            Z_Free(work);
-        }
-        done_head = NULL;
+
+    pthread_mutex_lock(&done_lock);
+    work = done_queue.head;
+    done_queue.head = done_queue.tail = NULL;
+    pthread_mutex_unlock(&done_lock);
+
+    for (; work; work = next) {
+        next = work->next;
+        if (work->done_cb)
+            work->done_cb(work->cb_arg);
+        Z_Free(work);
+        work_stats.completed++;
     }
-    pthread_mutex_unlock(&work_lock);
 }
 
 void Com_ShutdownAsyncWork(void)
@@ -107,12 +188,43 @@ void Com_ShutdownAsyncWork(void)
     work_terminate = true;
     pthread_mutex_unlock(&work_lock);
 
-    pthread_cond_signal(&work_cond);
+    pthread_cond_broadcast(&work_cond);
+
+    for (int i = 0; i < num_workers; i++)
+        Q_assert(!pthread_join(work_threads[i], NULL));
 
-    Q_assert(!pthread_join(work_thread, NULL));
+    // run callbacks for everything that has completed
     Com_CompleteAsyncWork();
 
     pthread_mutex_destroy(&work_lock);
+    pthread_mutex_destroy(&done_lock);
     pthread_cond_destroy(&work_cond);
     work_initialized = false;
 }
+
+static void Com_AsyncStats_f(void)
+{
+    if (!work_initialized) {
+        Com_Printf("Async work queue not started.\n");
+        return;
+    }
+
+    pthread_mutex_lock(&work_lock);
+    unsigned started = work_stats.queued - work_stats.pending;
+    unsigned finished = started - work_stats.running;
+    Com_Printf("%d workers, %u queued, %u completed\n",
+               num_workers, work_stats.queued, work_stats.completed);
+    Com_Printf("%u pending (max %u), %u running\n",
+               work_stats.pending, work_stats.max_pending, work_stats.running);
+    if (started)
+        Com_Printf("wait: %.2f ms avg, %.2f ms max\n",
+                   work_stats.total_wait * 1e-3 / started, work_stats.max_wait * 1e-3);
+    if (finished)
+        Com_Printf("run: %.2f ms avg\n", work_stats.total_run * 1e-3 / finished);
+    pthread_mutex_unlock(&work_lock);
+}
+
+void Com_InitAsyncWork(void)
+{
+    Cmd_AddCommand("async_stats", Com_AsyncStats_f);
+}
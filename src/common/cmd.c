@@ -23,6 +23,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "common/cvar.h"
 #include "common/error.h"
 #include "common/files.h"
+#include "common/hash_map.h"
 #include "common/list.h"
 #include "common/prompt.h"
 #include "common/utils.h"
@@ -91,12 +92,16 @@ void Cbuf_AddText(cmdbuf_t *buf, const char *text)
 {
     size_t l = strlen(text);
 
-    Q_assert(buf->cursize <= buf->maxsize);
+    Q_assert(buf->readpos + buf->cursize <= buf->maxsize);
     if (l > buf->maxsize - buf->cursize) {
         Com_WPrintf("%s: overflow\n", __func__);
         return;
     }
-    memcpy(buf->text + buf->cursize, text, l);
+    if (l > buf->maxsize - buf->cursize - buf->readpos) {
+        memmove(buf->text, buf->text + buf->readpos, buf->cursize);
+        buf->readpos = 0;
+    }
+    memcpy(buf->text + buf->readpos + buf->cursize, text, l);
     buf->cursize += l;
 }
 
@@ -116,15 +121,21 @@ void Cbuf_InsertText(cmdbuf_t *buf, const char *text)
     if (!l) {
         return;
     }
-    Q_assert(buf->cursize <= buf->maxsize);
+    Q_assert(buf->readpos + buf->cursize <= buf->maxsize);
     if (l >= buf->maxsize - buf->cursize) {
         Com_WPrintf("%s: overflow\n", __func__);
         return;
     }
 
-    memmove(buf->text + l + 1, buf->text, buf->cursize);
-    memcpy(buf->text, text, l);
-    buf->text[l] = '\n';
+    // reuse space of already executed text if possible
+    if (l < buf->readpos) {
+        buf->readpos -= l + 1;
+    } else {
+        memmove(buf->text + l + 1, buf->text + buf->readpos, buf->cursize);
+        buf->readpos = 0;
+    }
+    memcpy(buf->text + buf->readpos, text, l);
+    buf->text[buf->readpos + l] = '\n';
     buf->cursize += l + 1;
 }
 
@@ -149,7 +160,7 @@ void Cbuf_Execute(cmdbuf_t *buf)
         }
 
 // find a \n or ; line break
-        text = buf->text;
+        text = buf->text + buf->readpos;
 
         quotes = 0;
         for (i = 0; i < buf->cursize; i++) {
@@ -169,15 +180,18 @@ void Cbuf_Execute(cmdbuf_t *buf)
             ok = true;
         }
 
-// delete the text from the command buffer and move remaining commands down
-// this is necessary because commands (exec, alias) can insert data at the
-// beginning of the text buffer
+// delete the text from the command buffer. remaining commands are not
+// moved down, commands (exec, alias) inserting data at the beginning of
+// the buffer reuse the space
         if (i == buf->cursize) {
             buf->cursize = 0;
+            buf->readpos = 0;
         } else {
             i++;
             buf->cursize -= i;
-            memmove(text, text + i, buf->cursize);
+            buf->readpos += i;
+            if (!buf->cursize)
+                buf->readpos = 0;
         }
 
 // execute the command line
@@ -210,28 +224,87 @@ Cbuf_Clear
 */
 void Cbuf_Clear(cmdbuf_t *buf)
 {
-    buf->cursize = buf->waitCount = buf->aliasCount = 0;
+    buf->readpos = buf->cursize = buf->waitCount = buf->aliasCount = 0;
 }
 
 /*
 ==============================================================================
 
-                        SCRIPT COMMANDS
+                        SYMBOL TABLE
 
 ==============================================================================
 */
 
-#define ALIAS_HASH_SIZE    64
+static hash_map_t   *cmd_symbols;
 
-typedef struct {
-    list_t  hashEntry;
+/*
+============
+Cmd_FindSymbol
+============
+*/
+cmd_symbol_t *Cmd_FindSymbol(const char *name)
+{
+    cmd_symbol_t **sym;
+
+    if (!cmd_symbols) {
+        return NULL;
+    }
+
+    sym = HashMap_Lookup(cmd_symbol_t *, cmd_symbols, &name);
+    return sym ? *sym : NULL;
+}
+
+/*
+============
+Cmd_InternSymbol
+
+Returns symbol for the given name, creating it if needed.
+Symbols are never freed.
+============
+*/
+cmd_symbol_t *Cmd_InternSymbol(const char *name)
+{
+    cmd_symbol_t *sym;
+    size_t len;
+
+    sym = Cmd_FindSymbol(name);
+    if (sym) {
+        return sym;
+    }
+
+    if (!cmd_symbols) {
+        cmd_symbols = HashMap_TagCreate(char *, cmd_symbol_t *, HashStr, HashStrCmp, TAG_CMD);
+        HashMap_Reserve(cmd_symbols, 2048);
+    }
+
+    len = strlen(name);
+    sym = Cmd_Malloc(sizeof(*sym) + len);
+    sym->cmd = NULL;
+    sym->alias = NULL;
+    sym->macro = NULL;
+    sym->cvar = NULL;
+    memcpy(sym->name, name, len + 1);
+
+    name = sym->name;
+    HashMap_Insert(cmd_symbols, &name, &sym);
+    return sym;
+}
+
+/*
+==============================================================================
+
+                        SCRIPT COMMANDS
+
+==============================================================================
+*/
+
+typedef struct cmdalias_s {
     list_t  listEntry;
     char    *value;
     char    name[1];
 } cmdalias_t;
 
 static list_t   cmd_alias;
-static list_t   cmd_aliasHash[ALIAS_HASH_SIZE];
 
 /*
 ===============
@@ -240,17 +313,9 @@ Cmd_AliasFind
 */
 static cmdalias_t *Cmd_AliasFind(const char *name)
 {
-    unsigned hash;
-    cmdalias_t *alias;
+    cmd_symbol_t *sym = Cmd_FindSymbol(name);
 
-    hash = Com_HashString(name, ALIAS_HASH_SIZE);
-    LIST_FOR_EACH(alias, &cmd_aliasHash[hash], hashEntry) {
-        if (!strcmp(name, alias->name)) {
-            return alias;
-        }
-    }
-
-    return NULL;
+    return sym ? sym->alias : NULL;
 }
 
 char *Cmd_AliasCommand(const char *name)
@@ -268,7 +333,6 @@ char *Cmd_AliasCommand(const char *name)
 void Cmd_AliasSet(const char *name, const char *cmd)
 {
     cmdalias_t  *a;
-    unsigned    hash;
     size_t      len;
 
     // if the alias already exists, reuse it
@@ -286,8 +350,7 @@ void Cmd_AliasSet(const char *name, const char *cmd)
 
     List_Append(&cmd_alias, &a->listEntry);
 
-    hash = Com_HashString(name, ALIAS_HASH_SIZE);
-    List_Append(&cmd_aliasHash[hash], &a->hashEntry);
+    Cmd_InternSymbol(a->name)->alias = a;
 }
 
 void Cmd_Alias_g(void)
@@ -358,7 +421,6 @@ static void Cmd_UnAlias_f(void)
     };
     char *s;
     cmdalias_t *a, *n;
-    unsigned hash;
     int c;
 
     while ((c = Cmd_ParseOptions(options)) != -1) {
@@ -369,12 +431,10 @@ static void Cmd_UnAlias_f(void)
             return;
         case 'a':
             LIST_FOR_EACH_SAFE(a, n, &cmd_alias, listEntry) {
+                Cmd_FindSymbol(a->name)->alias = NULL;
                 Z_Free(a->value);
                 Z_Free(a);
             }
-            for (hash = 0; hash < ALIAS_HASH_SIZE; hash++) {
-                List_Init(&cmd_aliasHash[hash]);
-            }
             List_Init(&cmd_alias);
             Com_Printf("Removed all alias commands.\n");
             return;
@@ -397,7 +457,7 @@ static void Cmd_UnAlias_f(void)
     }
 
     List_Remove(&a->listEntry);
-    List_Remove(&a->hashEntry);
+    Cmd_FindSymbol(a->name)->alias = NULL;
 
     Z_Free(a->value);
     Z_Free(a);
@@ -690,10 +750,7 @@ error:
 =============================================================================
 */
 
-#define MACRO_HASH_SIZE    64
-
 static cmd_macro_t  *cmd_macros;
-static cmd_macro_t  *cmd_macroHash[MACRO_HASH_SIZE];
 
 /*
 ============
@@ -702,17 +759,9 @@ Cmd_FindMacro
 */
 cmd_macro_t *Cmd_FindMacro(const char *name)
 {
-    cmd_macro_t *macro;
-    unsigned hash;
+    cmd_symbol_t *sym = Cmd_FindSymbol(name);
 
-    hash = Com_HashString(name, MACRO_HASH_SIZE);
-    for (macro = cmd_macroHash[hash]; macro; macro = macro->hashNext) {
-        if (!strcmp(macro->name, name)) {
-            return macro;
-        }
-    }
-
-    return NULL;
+    return sym ? sym->macro : NULL;
 }
 
 void Cmd_Macro_g(void)
@@ -731,7 +780,6 @@ Cmd_AddMacro
 void Cmd_AddMacro(const char *name, xmacro_t function)
 {
     cmd_macro_t *macro;
-    unsigned hash;
 
 // fail if the macro is a variable name
     if (Cvar_Exists(name, false)) {
@@ -754,9 +802,7 @@ void Cmd_AddMacro(const char *name, xmacro_t function)
     macro->next = cmd_macros;
     cmd_macros = macro;
 
-    hash = Com_HashString(name, MACRO_HASH_SIZE);
-    macro->hashNext = cmd_macroHash[hash];
-    cmd_macroHash[hash] = macro;
+    Cmd_InternSymbol(name)->macro = macro;
 }
 
 
@@ -768,10 +814,7 @@ void Cmd_AddMacro(const char *name, xmacro_t function)
 =============================================================================
 */
 
-#define CMD_HASH_SIZE    128
-
-typedef struct {
-    list_t          hashEntry;
+typedef struct cmd_function_s {
     list_t          listEntry;
 
     xcommand_t      function;
@@ -780,7 +823,6 @@ typedef struct {
 } cmd_function_t;
 
 static list_t   cmd_functions;      // possible commands to execute
-static list_t   cmd_hash[CMD_HASH_SIZE];
 
 static int      cmd_argc;
 static char     *cmd_argv[MAX_STRING_TOKENS]; // pointers to cmd_data[]
@@ -1401,31 +1443,28 @@ Cmd_Find
 */
 static cmd_function_t *Cmd_Find(const char *name)
 {
-    cmd_function_t *cmd;
-    unsigned hash;
-
-    hash = Com_HashString(name, CMD_HASH_SIZE);
-    LIST_FOR_EACH(cmd, &cmd_hash[hash], hashEntry) {
-        if (!strcmp(cmd->name, name)) {
-            return cmd;
-        }
-    }
+    cmd_symbol_t *sym = Cmd_FindSymbol(name);
 
-    return NULL;
+    return sym ? sym->cmd : NULL;
 }
 
 static void Cmd_LinkCommand(cmd_function_t *cmd)
 {
     cmd_function_t *cur;
-    unsigned hash;
 
     LIST_FOR_EACH(cur, &cmd_functions, listEntry)
         if (strcmp(cmd->name, cur->name) < 0)
             break;
     List_Append(&cur->listEntry, &cmd->listEntry);
 
-    hash = Com_HashString(cmd->name, CMD_HASH_SIZE);
-    List_Append(&cmd_hash[hash], &cmd->hashEntry);
+    Cmd_InternSymbol(cmd->name)->cmd = cmd;
+}
+
+static void Cmd_UnlinkCommand(cmd_function_t *cmd)
+{
+    List_Remove(&cmd->listEntry);
+    Cmd_FindSymbol(cmd->name)->cmd = NULL;
+    Z_Free(cmd);
 }
 
 static void Cmd_RegCommand(const cmdreg_t *reg)
@@ -1488,9 +1527,7 @@ void Cmd_RemoveForwarded(void)
     LIST_FOR_EACH_SAFE(cmd, next, &cmd_functions, listEntry) {
         if (cmd->function)
             continue;
-        List_Remove(&cmd->listEntry);
-        List_Remove(&cmd->hashEntry);
-        Z_Free(cmd);
+        Cmd_UnlinkCommand(cmd);
     }
 }
 
@@ -1509,9 +1546,7 @@ void Cmd_RemoveCommand(const char *name)
         return;
     }
 
-    List_Remove(&cmd->listEntry);
-    List_Remove(&cmd->hashEntry);
-    Z_Free(cmd);
+    Cmd_UnlinkCommand(cmd);
 }
 
 /*
@@ -1551,6 +1586,7 @@ void Cmd_Command_g(void)
 
 void Cmd_ExecuteCommand(cmdbuf_t *buf)
 {
+    cmd_symbol_t    *sym;
     cmd_function_t  *cmd;
     cmdalias_t      *a;
     cvar_t          *v;
@@ -1563,8 +1599,14 @@ void Cmd_ExecuteCommand(cmdbuf_t *buf)
 
     cmd_current = buf;
 
+    // resolve the name once for all namespaces
+    sym = Cmd_FindSymbol(cmd_argv[0]);
+    if (!sym) {
+        goto unknown;
+    }
+
     // check functions
-    cmd = Cmd_Find(cmd_argv[0]);
+    cmd = sym->cmd;
     if (cmd) {
         if (cmd->function) {
             cmd->function();
@@ -1575,7 +1617,7 @@ void Cmd_ExecuteCommand(cmdbuf_t *buf)
     }
 
     // check aliases
-    a = Cmd_AliasFind(cmd_argv[0]);
+    a = sym->alias;
     if (a) {
         if (buf->aliasCount >= ALIAS_LOOP_COUNT) {
             Com_WPrintf("Runaway alias loop\n");
@@ -1590,12 +1632,13 @@ void Cmd_ExecuteCommand(cmdbuf_t *buf)
     }
 
     // check variables
-    v = Cvar_FindVar(cmd_argv[0]);
+    v = sym->cvar;
     if (v) {
         Cvar_Command(v);
         return;
     }
 
+unknown:
     // send it as a server command if we are connected
     if (!CL_ForwardToServer()) {
         Com_Printf("Unknown command \"%s\"\n", cmd_argv[0]);
@@ -1965,17 +2008,8 @@ Cmd_Init
 */
 void Cmd_Init(void)
 {
-    int i;
-
     List_Init(&cmd_functions);
-    for (i = 0; i < CMD_HASH_SIZE; i++) {
-        List_Init(&cmd_hash[i]);
-    }
-
     List_Init(&cmd_alias);
-    for (i = 0; i < ALIAS_HASH_SIZE; i++) {
-        List_Init(&cmd_aliasHash[i]);
-    }
 
     List_Init(&cmd_triggers);
 
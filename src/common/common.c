@@ -930,6 +930,8 @@ void Qcommon_Init(int argc, char **argv)
 
     Cmd_AddCommand("z_stats", Z_Stats_f);
 
+    Com_InitAsyncWork();
+
     Cmd_AddMacro("com_date", Com_Date_m);
     Cmd_AddMacro("com_time", Com_Time_m);
     Cmd_AddMacro("com_uptime", Com_Uptime_m);
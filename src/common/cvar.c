@@ -34,9 +34,6 @@ int     cvar_modified;
 
 #define Cvar_Malloc(size)   Z_TagMalloc(size, TAG_CVAR)
 
-#define CVARHASH_SIZE    256
-
-static cvar_t *cvarHash[CVARHASH_SIZE];
 
 /*
 ============
@@ -45,18 +42,9 @@ Cvar_FindVar
 */
 cvar_t *Cvar_FindVar(const char *var_name)
 {
-    cvar_t *var;
-    unsigned hash;
-
-    hash = Com_HashString(var_name, CVARHASH_SIZE);
-
-    for (var = cvarHash[hash]; var; var = var->hashNext) {
-        if (!strcmp(var_name, var->name)) {
-            return var;
-        }
-    }
+    cmd_symbol_t *sym = Cmd_FindSymbol(var_name);
 
-    return NULL;
+    return sym ? sym->cvar : NULL;
 }
 
 xgenerator_t Cvar_FindGenerator(const char *var_name)
@@ -265,7 +253,6 @@ The flags will be or'ed in if the variable exists.
 cvar_t *Cvar_Get(const char *var_name, const char *var_value, int flags)
 {
     cvar_t *var, *c, **p;
-    unsigned hash;
     size_t length;
 
     Q_assert(var_name);
@@ -316,9 +303,7 @@ cvar_t *Cvar_Get(const char *var_name, const char *var_value, int flags)
     *p = var;
 
     // link the variable in
-    hash = Com_HashString(var_name, CVARHASH_SIZE);
-    var->hashNext = cvarHash[hash];
-    cvarHash[hash] = var;
+    Cmd_InternSymbol(var->name)->cvar = var;
 
     return var;
 }
@@ -116,6 +116,7 @@ typedef struct packfile_s {
 #endif
     uint8_t     namelen;
     uint32_t    nameofs;
+    uint32_t    namehash;   // full hash, checked before comparing names
     struct packfile_s *hash_next;
 } packfile_t;
 
@@ -537,6 +538,37 @@ static int seek_pak_file(file_t *file, int64_t offset, int whence)
     return Q_ERR_SUCCESS;
 }
 
+/*
+============
+FS_RawFile
+
+Returns stdio stream and absolute offset of file data for files stored
+verbatim on disk (loose or in pack without compression). Data may be
+transferred directly from the underlying descriptor by callers, as long as
+stream position is not disturbed. Returns NULL for other files.
+============
+*/
+FILE *FS_RawFile(qhandle_t f, int64_t *offset)
+{
+    file_t *file = file_for_handle(f);
+
+    if (!file || (file->mode & FS_MODE_MASK) != FS_MODE_READ)
+        return NULL;
+
+    switch (file->type) {
+    case FS_REAL:
+        *offset = 0;
+        return file->fp;
+    case FS_PAK:
+        if (!file->entry || file->length != file->entry->filelen)
+            return NULL;
+        *offset = file->entry->filepos;
+        return file->fp;
+    default:
+        return NULL;
+    }
+}
+
 /*
 ============
 FS_Seek
@@ -1346,7 +1378,7 @@ static int64_t open_file_read(file_t *file, const char *normalized, size_t namel
             // look through all the pak file elements
             entry = pak->file_hash[hash & (pak->hash_size - 1)];
             for (; entry; entry = entry->hash_next) {
-                if (entry->namelen != namelen) {
+                if (entry->namehash != hash || entry->namelen != namelen) {
                     continue;
                 }
                 FS_COUNT_STRCMP;
@@ -2084,7 +2116,8 @@ static void pack_calc_hashes(pack_t *pack)
         // force conversion to lower case. mixed case paths are annoying.
         Q_strlwr(name);
 
-        hash = Com_HashString(name, pack->hash_size);
+        file->namehash = hash = Com_HashString(name, 0);
+        hash &= pack->hash_size - 1;
         file->hash_next = pack->file_hash[hash];
         pack->file_hash[hash] = file;
     }
@@ -3142,7 +3175,7 @@ recheck:
             pak = search->pack;
             entry = pak->file_hash[hash & (pak->hash_size - 1)];
             for (; entry; entry = entry->hash_next) {
-                if (entry->namelen != namelen) {
+                if (entry->namehash != hash || entry->namelen != namelen) {
                     continue;
                 }
                 if (!FS_pathcmp(pak->names + entry->nameofs, normalized)) {
@@ -22,9 +22,36 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "common/zone.h"
 #include "common/hash_map.h"
 
+#if USE_SSE2
+#include <emmintrin.h>
+#elif USE_NEON
+#include <arm_neon.h>
+#endif
+
 #define MIN_KEY_VALUE_STORAGE_SIZE 16
 #define MIN_HASH_SIZE              32
 
+// Index is an open addressing table with linear probing. Each slot has a
+// control byte holding 7 bits of the hash (or CTRL_EMPTY) so that a whole
+// group of slots can be matched at once. First GROUP_SIZE - 1 control bytes
+// are mirrored past the end, so groups can be loaded unaligned across the
+// wrap point. Slots store full hash and index into dense key/value arrays.
+#define CTRL_EMPTY  0x80
+#define GROUP_SIZE  16
+
+#if USE_NEON
+#define GROUP_SHIFT 2       // 4 mask bits per slot
+#define GROUP_LANE  0xfull
+#else
+#define GROUP_SHIFT 0
+#define GROUP_LANE  1ull
+#endif
+
+typedef struct {
+    uint32_t index;
+    uint32_t hash;
+} hash_slot_t;
+
 typedef struct hash_map_s {
     uint32_t num_entries;
     uint32_t hash_size;
@@ -34,8 +61,8 @@ typedef struct hash_map_s {
     memtag_t tag;
     uint32_t (*hasher)(const void *const);
     bool     (*comp)(const void *const, const void *const);
-    uint32_t *hash_to_index;
-    uint32_t *index_chain;
+    uint8_t     *ctrl;
+    hash_slot_t *slots;
     void     *keys;
     void     *values;
 } hash_map_t;
@@ -60,25 +87,144 @@ void *HashMap_GetValueImpl(const hash_map_t *map, uint32_t index)
     return (byte *)map->values + (map->value_size * index);
 }
 
+/*
+=================
+HashMap_MatchGroup
+
+Returns mask of slots in group whose control byte equals `h2'.
+Mask of empty slots is returned in `empty'.
+=================
+*/
+static inline uint64_t HashMap_MatchGroup(const uint8_t *ctrl, uint8_t h2, uint64_t *empty)
+{
+#if USE_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    *empty = (uint32_t)_mm_movemask_epi8(group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+#elif USE_NEON
+    uint8x16_t group = vld1q_u8(ctrl);
+    uint8x16_t match = vceqq_u8(group, vdupq_n_u8(h2));
+    uint8x16_t empt = vtstq_u8(group, vdupq_n_u8(CTRL_EMPTY));
+    *empty = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(empt), 4)), 0);
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+#else
+    uint64_t match = 0;
+    *empty = 0;
+    for (int i = 0; i < GROUP_SIZE; i++) {
+        if (ctrl[i] == h2)
+            match |= 1ull << i;
+        else if (ctrl[i] == CTRL_EMPTY)
+            *empty |= 1ull << i;
+    }
+    return match;
+#endif
+}
+
+#define GROUP_FIRST(mask)   (__builtin_ctzll(mask) >> GROUP_SHIFT)
+#define GROUP_CLEAR(mask)   ((mask) & ~(GROUP_LANE << (GROUP_FIRST(mask) << GROUP_SHIFT)))
+#define HASH_TO_H2(hash)    ((hash) >> 25)
+
+static inline void HashMap_SetCtrl(hash_map_t *map, uint32_t slot, uint8_t c)
+{
+    map->ctrl[slot] = c;
+    if (slot < GROUP_SIZE - 1)
+        map->ctrl[slot + map->hash_size] = c;
+}
+
+static inline bool HashMap_KeyEqual(const hash_map_t *map, const void *const key, uint32_t index)
+{
+    const void *const storage_key = HashMap_GetKeyImpl(map, index);
+    return map->comp ? map->comp(key, storage_key) : (memcmp(key, storage_key, map->key_size) == 0);
+}
+
+/*
+=================
+HashMap_Find
+
+Returns storage index of the key and its slot, or UINT32_MAX and the
+first empty slot the key can be inserted into.
+=================
+*/
+static uint32_t HashMap_Find(const hash_map_t *map, const void *const key, const uint32_t hash, uint32_t *slot_p)
+{
+    const uint32_t mask = map->hash_size - 1;
+    uint32_t       pos = hash & mask;
+
+    while (1) {
+        uint64_t empty, match = HashMap_MatchGroup(map->ctrl + pos, HASH_TO_H2(hash), &empty);
+
+        // keys can't live past the first empty slot
+        if (empty)
+            match &= (empty & -empty) - 1;
+
+        for (; match; match = GROUP_CLEAR(match)) {
+            const uint32_t     slot = (pos + GROUP_FIRST(match)) & mask;
+            const hash_slot_t *s = &map->slots[slot];
+            if (s->hash == hash && HashMap_KeyEqual(map, key, s->index)) {
+                *slot_p = slot;
+                return s->index;
+            }
+        }
+
+        if (empty) {
+            *slot_p = (pos + GROUP_FIRST(empty)) & mask;
+            return UINT32_MAX;
+        }
+
+        pos = (pos + GROUP_SIZE) & mask;
+    }
+}
+
+/*
+=================
+HashMap_FindEmpty
+=================
+*/
+static uint32_t HashMap_FindEmpty(const hash_map_t *map, const uint32_t hash)
+{
+    const uint32_t mask = map->hash_size - 1;
+    uint32_t       pos = hash & mask;
+
+    while (1) {
+        uint64_t empty;
+        HashMap_MatchGroup(map->ctrl + pos, 0, &empty);
+        if (empty)
+            return (pos + GROUP_FIRST(empty)) & mask;
+        pos = (pos + GROUP_SIZE) & mask;
+    }
+}
+
 /*
 =================
 HashMap_Rehash
+
+Full hashes are kept in slots, so rebuilding the index doesn't call
+hasher or comp functions.
 =================
 */
 static void HashMap_Rehash(hash_map_t *map, const uint32_t new_size)
 {
     if (map->hash_size >= new_size)
         return;
+
+    uint8_t     *old_ctrl = map->ctrl;
+    hash_slot_t *old_slots = map->slots;
+    uint32_t     old_size = map->hash_size;
+
     map->hash_size = new_size;
-    map->hash_to_index = Z_ReallocArray(map->hash_to_index, map->hash_size, sizeof(uint32_t), map->tag);
-    memset(map->hash_to_index, 0xFF, map->hash_size * sizeof(uint32_t));
-    for (uint32_t i = 0; i < map->num_entries; ++i) {
-        void          *key = HashMap_GetKeyImpl(map, i);
-        const uint32_t hash = map->hasher(key);
-        const uint32_t hash_index = hash & (map->hash_size - 1);
-        map->index_chain[i] = map->hash_to_index[hash_index];
-        map->hash_to_index[hash_index] = i;
+    map->ctrl = Z_TagMalloc(map->hash_size + GROUP_SIZE - 1, map->tag);
+    map->slots = Z_TagMalloc(map->hash_size * sizeof(hash_slot_t), map->tag);
+    memset(map->ctrl, CTRL_EMPTY, map->hash_size + GROUP_SIZE - 1);
+    for (uint32_t i = 0; i < old_size; ++i) {
+        if (old_ctrl[i] == CTRL_EMPTY)
+            continue;
+        const uint32_t slot = HashMap_FindEmpty(map, old_slots[i].hash);
+        HashMap_SetCtrl(map, slot, old_ctrl[i]);
+        map->slots[slot] = old_slots[i];
     }
+
+    Z_Free(old_ctrl);
+    Z_Free(old_slots);
 }
 
 /*
@@ -90,7 +236,6 @@ static void HashMap_ExpandKeyValueStorage(hash_map_t *map, const uint32_t new_si
 {
     map->keys = Z_ReallocArray(map->keys, new_size, map->key_size, map->tag);
     map->values = Z_ReallocArray(map->values, new_size, map->value_size, map->tag);
-    map->index_chain = Z_ReallocArray(map->index_chain, new_size, sizeof(uint32_t), map->tag);
     map->key_value_storage_size = new_size;
 }
 
@@ -120,8 +265,8 @@ HashMap_Destroy
 */
 void HashMap_Destroy(hash_map_t *map)
 {
-    Z_Free(map->hash_to_index);
-    Z_Free(map->index_chain);
+    Z_Free(map->ctrl);
+    Z_Free(map->slots);
     Z_Free(map->keys);
     Z_Free(map->values);
     Z_Free(map);
@@ -137,7 +282,7 @@ void HashMap_Reserve(hash_map_t *map, uint32_t capacity)
     const uint32_t new_key_value_storage_size = Q_npot32(capacity);
     if (map->key_value_storage_size < new_key_value_storage_size)
         HashMap_ExpandKeyValueStorage(map, new_key_value_storage_size);
-    const uint32_t new_hash_size = Q_npot32(capacity + (capacity / 4));
+    const uint32_t new_hash_size = max(Q_npot32(capacity + (capacity / 4)), MIN_HASH_SIZE);
     if (map->hash_size < new_hash_size)
         HashMap_Rehash(map, new_hash_size);
 }
@@ -158,21 +303,15 @@ bool HashMap_InsertImpl(hash_map_t *map, const uint32_t key_size, const uint32_t
         HashMap_Rehash(map, max(map->hash_size * 2, MIN_HASH_SIZE));
 
     const uint32_t hash = map->hasher(key);
-    const uint32_t hash_index = hash & (map->hash_size - 1);
-    {
-        uint32_t storage_index = map->hash_to_index[hash_index];
-        while (storage_index != UINT32_MAX) {
-            const void *const storage_key = HashMap_GetKeyImpl(map, storage_index);
-            if (map->comp ? map->comp(key, storage_key) : (memcmp(key, storage_key, key_size) == 0)) {
-                memcpy(HashMap_GetValueImpl(map, storage_index), value, value_size);
-                return true;
-            }
-            storage_index = map->index_chain[storage_index];
-        }
+    uint32_t       slot;
+    uint32_t       storage_index = HashMap_Find(map, key, hash, &slot);
+    if (storage_index != UINT32_MAX) {
+        memcpy(HashMap_GetValueImpl(map, storage_index), value, value_size);
+        return true;
     }
 
-    map->index_chain[map->num_entries] = map->hash_to_index[hash_index];
-    map->hash_to_index[hash_index] = map->num_entries;
+    HashMap_SetCtrl(map, slot, HASH_TO_H2(hash));
+    map->slots[slot] = (hash_slot_t){ map->num_entries, hash };
     memcpy(HashMap_GetKeyImpl(map, map->num_entries), key, key_size);
     memcpy(HashMap_GetValueImpl(map, map->num_entries), value, value_size);
     ++map->num_entries;
@@ -183,6 +322,8 @@ bool HashMap_InsertImpl(hash_map_t *map, const uint32_t key_size, const uint32_t
 /*
 =================
 HashMap_EraseImpl
+
+Uses backward shift deletion, so no tombstones are left behind.
 =================
 */
 bool HashMap_EraseImpl(hash_map_t *map, const uint32_t key_size, const void *const key)
@@ -191,64 +332,43 @@ bool HashMap_EraseImpl(hash_map_t *map, const uint32_t key_size, const void *con
     if (map->num_entries == 0)
         return false;
 
-    const uint32_t hash = map->hasher(key);
-    const uint32_t hash_index = hash & (map->hash_size - 1);
-    uint32_t       storage_index = map->hash_to_index[hash_index];
-    uint32_t      *prev_storage_index_ptr = NULL;
-    while (storage_index != UINT32_MAX) {
-        const void *storage_key = HashMap_GetKeyImpl(map, storage_index);
-        if (map->comp ? map->comp(key, storage_key) : (memcmp(key, storage_key, key_size) == 0)) {
-            {
-                // Remove found key from index
-                if (prev_storage_index_ptr == NULL)
-                    map->hash_to_index[hash_index] = map->index_chain[storage_index];
-                else
-                    *prev_storage_index_ptr = map->index_chain[storage_index];
-            }
-
-            const uint32_t last_index = map->num_entries - 1;
-            const uint32_t last_hash = map->hasher(HashMap_GetKeyImpl(map, last_index));
-            const uint32_t last_hash_index = last_hash & (map->hash_size - 1);
-
-            if (storage_index == last_index) {
-                --map->num_entries;
-                return true;
-            }
-
-            {
-                // Remove last key from index
-                if (map->hash_to_index[last_hash_index] == last_index)
-                    map->hash_to_index[last_hash_index] = map->index_chain[last_index];
-                else {
-                    bool found = false;
-                    for (uint32_t last_storage_index = map->hash_to_index[last_hash_index]; last_storage_index != UINT32_MAX;
-                         last_storage_index = map->index_chain[last_storage_index]) {
-                        if (map->index_chain[last_storage_index] == last_index) {
-                            map->index_chain[last_storage_index] = map->index_chain[last_index];
-                            found = true;
-                            break;
-                        }
-                    }
-                    (void)found;
-                    Q_assert(found);
-                }
-            }
+    const uint32_t mask = map->hash_size - 1;
+    uint32_t       slot;
+    const uint32_t storage_index = HashMap_Find(map, key, map->hasher(key), &slot);
+    if (storage_index == UINT32_MAX)
+        return false;
 
-            {
-                // Copy last key to current key position and add back to index
-                memcpy(HashMap_GetKeyImpl(map, storage_index), HashMap_GetKeyImpl(map, last_index), map->key_size);
-                memcpy(HashMap_GetValueImpl(map, storage_index), HashMap_GetValueImpl(map, last_index), map->value_size);
-                map->index_chain[storage_index] = map->hash_to_index[last_hash_index];
-                map->hash_to_index[last_hash_index] = storage_index;
+    {
+        // Shift following entries back into the hole while they can
+        // still be reached from their home slot
+        uint32_t next = slot;
+        while (1) {
+            next = (next + 1) & mask;
+            if (map->ctrl[next] == CTRL_EMPTY)
+                break;
+            const uint32_t home = map->slots[next].hash & mask;
+            if (((next - home) & mask) >= ((next - slot) & mask)) {
+                HashMap_SetCtrl(map, slot, map->ctrl[next]);
+                map->slots[slot] = map->slots[next];
+                slot = next;
             }
-
-            --map->num_entries;
-            return true;
         }
-        prev_storage_index_ptr = &map->index_chain[storage_index];
-        storage_index = map->index_chain[storage_index];
+        HashMap_SetCtrl(map, slot, CTRL_EMPTY);
     }
-    return false;
+
+    const uint32_t last_index = map->num_entries - 1;
+    if (storage_index != last_index) {
+        // Move last entry into the freed storage position
+        slot = map->hasher(HashMap_GetKeyImpl(map, last_index)) & mask;
+        while (map->slots[slot].index != last_index || map->ctrl[slot] == CTRL_EMPTY)
+            slot = (slot + 1) & mask;
+        map->slots[slot].index = storage_index;
+        memcpy(HashMap_GetKeyImpl(map, storage_index), HashMap_GetKeyImpl(map, last_index), map->key_size);
+        memcpy(HashMap_GetValueImpl(map, storage_index), HashMap_GetValueImpl(map, last_index), map->value_size);
+    }
+
+    --map->num_entries;
+    return true;
 }
 
 /*
@@ -262,17 +382,12 @@ void *HashMap_LookupImpl(const hash_map_t *map, const uint32_t key_size, const v
     if (map->num_entries == 0)
         return NULL;
 
-    const uint32_t hash = map->hasher(key);
-    const uint32_t hash_index = hash & (map->hash_size - 1);
-    uint32_t       storage_index = map->hash_to_index[hash_index];
-    while (storage_index != UINT32_MAX) {
-        const void *const storage_key = HashMap_GetKeyImpl(map, storage_index);
-        if (map->comp ? map->comp(key, storage_key) : (memcmp(key, storage_key, key_size) == 0))
-            return HashMap_GetValueImpl(map, storage_index);
-        storage_index = map->index_chain[storage_index];
-    }
+    uint32_t       slot;
+    const uint32_t storage_index = HashMap_Find(map, key, map->hasher(key), &slot);
+    if (storage_index == UINT32_MAX)
+        return NULL;
 
-    return NULL;
+    return HashMap_GetValueImpl(map, storage_index);
 }
 
 /*
@@ -24,6 +24,12 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "common/intreadwrite.h"
 #include <assert.h>
 
+#if USE_SSE2
+#include <emmintrin.h>
+#elif USE_NEON
+#include <arm_neon.h>
+#endif
+
 /*
 ==============================================================================
 
@@ -289,6 +295,12 @@ typedef struct {
     int bits;
 } netfield_t;
 
+// Maps mask of changed 32-bit words of a state to mask of changed fields,
+// one nibble of words at a time.
+typedef struct {
+    uint64_t lut[16][16];
+} netfield_map_t;
+
 // special values for bits
 typedef enum {
     NETF_FLOAT = 0,
@@ -341,6 +353,9 @@ static_assert(sizeof(entity_state_t) / sizeof(uint32_t) == q_countof(entity_stat
 
 static unsigned entity_state_counts[q_countof(entity_state_fields)];
 
+static netfield_map_t entity_state_map;
+static netfield_map_t entity_state_map2;
+
 static const int entity_state_nc_bits = 32 - __builtin_clz(q_countof(entity_state_fields));
 
 #undef NETF
@@ -373,22 +388,68 @@ static int MSG_CountDeltaMaxBits(const netfield_t *f, int n)
     return bits;
 }
 
-static int MSG_CountDeltaFields(const netfield_t *f, int n, const void *from, const void *to, unsigned *counts)
+static void MSG_InitFieldMap(netfield_map_t *map, const netfield_t *f, int n)
 {
-    int nc = 0;
-
     for (int i = 0; i < n; i++, f++) {
-        uint32_t from_v = RN32((const byte *)from + f->offset);
-        uint32_t to_v   = RN32((const byte *)to   + f->offset);
+        int w = f->offset / sizeof(uint32_t);
 
-        if (from_v == to_v)
-            continue;
+        Q_assert(w < 64);
+        for (int v = 0; v < 16; v++)
+            if (v & BIT(w & 3))
+                map->lut[w >> 2][v] |= BIT_ULL(i);
+    }
+}
 
-        counts[i]++;
-        nc = i + 1;
+// returns mask of 32-bit words that differ, n must be <= 64
+static uint64_t MSG_ChangedWords(const void *from, const void *to, int n)
+{
+    const byte *a = from, *b = to;
+    uint64_t mask = 0;
+    int i = 0;
+
+#if USE_SSE2
+    for (; i + 4 <= n; i += 4, a += 16, b += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *)a);
+        __m128i vb = _mm_loadu_si128((const __m128i *)b);
+        int eq = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(va, vb)));
+        mask |= (uint64_t)(eq ^ 15) << i;
+    }
+#elif USE_NEON
+    static const uint32_t lanes[4] = { 1, 2, 4, 8 };
+    for (; i + 4 <= n; i += 4, a += 16, b += 16) {
+        uint32x4_t va = vld1q_u32((const uint32_t *)a);
+        uint32x4_t vb = vld1q_u32((const uint32_t *)b);
+        uint32x4_t ne = vmvnq_u32(vceqq_u32(va, vb));
+        mask |= (uint64_t)vaddvq_u32(vandq_u32(ne, vld1q_u32(lanes))) << i;
     }
+#endif
 
-    return nc;
+    for (; i < n; i++, a += 4, b += 4)
+        if (RN32(a) != RN32(b))
+            mask |= BIT_ULL(i);
+
+    return mask;
+}
+
+static uint64_t MSG_ChangedFields(const netfield_map_t *map, uint64_t words)
+{
+    uint64_t bits = 0;
+
+    for (int i = 0; words; i++, words >>= 4)
+        bits |= map->lut[i][words & 15];
+
+    return bits;
+}
+
+static int MSG_CountDeltaFields(uint64_t bits, unsigned *counts)
+{
+    if (!bits)
+        return 0;
+
+    for (uint64_t b = bits; b; b &= b - 1)
+        counts[__builtin_ctzll(b)]++;
+
+    return 64 - __builtin_clzll(bits);
 }
 
 #define FLOAT_INT_BITS  14
@@ -413,18 +474,25 @@ static void MSG_WriteFloat(uint32_t to_v)
     }
 }
 
-static void MSG_WriteDeltaFields(const netfield_t *f, int n, const void *from, const void *to)
+// writes first n fields, with changed ones given by bits
+static void MSG_WriteZeroBits(int count)
 {
-    for (int i = 0; i < n; i++, f++) {
-        uint32_t from_v = RN32((const byte *)from + f->offset);
-        uint32_t to_v   = RN32((const byte *)to   + f->offset);
+    for (; count > 0; count -= 32)
+        MSG_WriteBits(0, min(count, 32));
+}
 
-        if (from_v == to_v) {
-            MSG_WriteBit(0);    // not changed
-            continue;
-        }
+static void MSG_WriteDeltaFields(const netfield_t *fields, int n, uint64_t bits, const void *to)
+{
+    int i = 0;
 
+    for (; bits; bits &= bits - 1) {
+        int j = __builtin_ctzll(bits);
+        const netfield_t *f = &fields[j];
+        uint32_t to_v = RN32((const byte *)to + f->offset);
+
+        MSG_WriteZeroBits(j - i);   // not changed
         MSG_WriteBit(1);
+        i = j + 1;
 
         switch (f->bits) {
         case NETF_FLOAT:
@@ -444,11 +512,14 @@ static void MSG_WriteDeltaFields(const netfield_t *f, int n, const void *from, c
             break;
         }
     }
+
+    MSG_WriteZeroBits(n - i);
 }
 
 void MSG_WriteDeltaEntity(const entity_state_t *from, const entity_state_t *to, bool force)
 {
     int oldorg, nc;
+    uint64_t words, bits;
     bool baseline;
 
     if (!to) {
@@ -477,7 +548,10 @@ void MSG_WriteDeltaEntity(const entity_state_t *from, const entity_state_t *to,
     else
         oldorg = 3;
 
-    nc = MSG_CountDeltaFields(entity_state_fields, q_countof(entity_state_fields), from, to, entity_state_counts);
+    // compare whole states once, count and write passes share the mask
+    words = MSG_ChangedWords(from, to, sizeof(*to) / sizeof(uint32_t));
+    bits = MSG_ChangedFields(&entity_state_map, words);
+    nc = MSG_CountDeltaFields(bits, entity_state_counts);
     if (!nc && !oldorg) {
         if (!force)
             return;     // nothing to send!
@@ -493,11 +567,11 @@ void MSG_WriteDeltaEntity(const entity_state_t *from, const entity_state_t *to,
         MSG_WriteBit(1);    // changed
     }
     MSG_WriteBits(nc, entity_state_nc_bits);
-    MSG_WriteDeltaFields(entity_state_fields, nc, from, to);
+    MSG_WriteDeltaFields(entity_state_fields, nc, bits, to);
 
     MSG_WriteBits(oldorg, 2);
     if (oldorg == 3)
-        MSG_WriteDeltaFields(entity_state_fields2, 3, from, to);
+        MSG_WriteDeltaFields(entity_state_fields2, 3, MSG_ChangedFields(&entity_state_map2, words), to);
 }
 
 #define NETF(f, bits)  { #f, offsetof(player_state_t, f), bits }
@@ -560,8 +634,12 @@ static const netfield_t player_state_fields[] = {
 
 static_assert(sizeof(player_state_t) / sizeof(uint32_t) == q_countof(player_state_fields) + MAX_AMMO + MAX_STATS, "Bad player_state_fields size");
 
+static_assert(offsetof(player_state_t, ammo) == sizeof(uint32_t) * q_countof(player_state_fields), "Bad player_state_fields layout");
+
 static unsigned player_state_counts[q_countof(player_state_fields)];
 
+static netfield_map_t player_state_map;
+
 static const int player_state_nc_bits = 32 - __builtin_clz(q_countof(player_state_fields));
 
 #undef NETF
@@ -573,17 +651,12 @@ void MSG_WriteDeltaPlayerstate(const player_state_t *from, const player_state_t
     if (!from)
         from = &nullPlayerState;
 
-    uint32_t ammobits = 0;
-    for (int i = 0; i < MAX_AMMO; i++)
-        if (to->ammo[i] != from->ammo[i])
-            ammobits |= BIT(i);
+    uint32_t ammobits = MSG_ChangedWords(from->ammo, to->ammo, MAX_AMMO);
+    uint64_t statbits = MSG_ChangedWords(from->stats, to->stats, MAX_STATS);
 
-    uint64_t statbits = 0;
-    for (int i = 0; i < MAX_STATS; i++)
-        if (to->stats[i] != from->stats[i])
-            statbits |= BIT_ULL(i);
-
-    int nc = MSG_CountDeltaFields(player_state_fields, q_countof(player_state_fields), from, to, player_state_counts);
+    uint64_t words = MSG_ChangedWords(from, to, q_countof(player_state_fields));
+    uint64_t bits = MSG_ChangedFields(&player_state_map, words);
+    int nc = MSG_CountDeltaFields(bits, player_state_counts);
     if (!nc && !ammobits && !statbits) {
         MSG_WriteBit(0);
         return;
@@ -591,7 +664,7 @@ void MSG_WriteDeltaPlayerstate(const player_state_t *from, const player_state_t
 
     MSG_WriteBit(1);
     MSG_WriteBits(nc, player_state_nc_bits);
-    MSG_WriteDeltaFields(player_state_fields, nc, from, to);
+    MSG_WriteDeltaFields(player_state_fields, nc, bits, to);
 
     MSG_WriteLeb32(ammobits);
     if (ammobits)
@@ -1036,6 +1109,10 @@ void MSG_Init(void)
     bits += MSG_CountDeltaMaxBits(entity_state_fields2, q_countof(entity_state_fields2));
     msg_max_entity_bytes = (bits + 7) / 8;
 
+    MSG_InitFieldMap(&entity_state_map,  entity_state_fields,  q_countof(entity_state_fields ));
+    MSG_InitFieldMap(&entity_state_map2, entity_state_fields2, q_countof(entity_state_fields2));
+    MSG_InitFieldMap(&player_state_map,  player_state_fields,  q_countof(player_state_fields ));
+
     MSG_Clear();
 
 #if USE_CLIENT && USE_DEBUG
@@ -161,6 +161,75 @@ void Netchan_OutOfBand(netsrc_t sock, const netadr_t *address, const char *forma
 
 // ============================================================================
 
+/*
+
+Fragmented messages are assembled into and sent from MAX_MSGLEN sized buffers
+taken from a shared pool, so that idle channels don't hold them. Completed
+message is parsed directly from the pool buffer, which is handed over from
+the channel to msg_read and returned to the pool on the next call to
+Netchan_Process. Outgoing packets are gathered from header, reliable and
+unreliable parts by NET_SendPacketv instead of being copied together.
+
+*/
+
+#define MAX_FREE_NETBUFS    8
+
+struct netbuf_s {
+    netbuf_t    *next;
+    byte        data[MAX_MSGLEN];
+};
+
+static netbuf_t     *netbuf_free;
+static unsigned     netbuf_numfree;
+static unsigned     netbuf_inuse;
+static netbuf_t     *netbuf_read;   // msg_read points here
+
+// statistics
+static uint64_t     netbuf_allocs;
+static uint64_t     netbuf_reuses;
+static uint64_t     netchan_copies;
+static uint64_t     netchan_copied;
+
+static netbuf_t *Netbuf_Get(void)
+{
+    netbuf_t *buf = netbuf_free;
+
+    if (buf) {
+        netbuf_free = buf->next;
+        netbuf_numfree--;
+        netbuf_reuses++;
+    } else {
+        buf = Z_Malloc(sizeof(*buf));
+        netbuf_allocs++;
+    }
+
+    netbuf_inuse++;
+    return buf;
+}
+
+static void Netbuf_Put(netbuf_t *buf)
+{
+    if (!buf)
+        return;
+
+    netbuf_inuse--;
+    if (netbuf_numfree >= MAX_FREE_NETBUFS) {
+        Z_Free(buf);
+        return;
+    }
+
+    buf->next = netbuf_free;
+    netbuf_free = buf;
+    netbuf_numfree++;
+}
+
+static void Netchan_Copy(void *dst, const void *src, size_t len)
+{
+    memcpy(dst, src, len);
+    netchan_copies++;
+    netchan_copied += len;
+}
+
 /*
 ===============
 Netchan_TransmitNextFragment
@@ -169,19 +238,21 @@ Netchan_TransmitNextFragment
 int Netchan_TransmitNextFragment(netchan_t *chan)
 {
     sizebuf_t   send;
-    byte        send_buf[MAX_PACKETLEN];
+    byte        send_buf[16];
+    netvec_t    vec[3];
     bool        send_reliable, more_fragments;
-    unsigned    w1, w2, fragment_length;
+    unsigned    w1, w2, fragment_length, start, end;
+    int         count;
 
     send_reliable = chan->reliable_length;
 
-    fragment_length = chan->fragment_out.cursize - chan->fragment_out.readcount;
+    fragment_length = chan->fragment_length - chan->fragment_offset;
     if (fragment_length > chan->maxpacketlen) {
         fragment_length = chan->maxpacketlen;
     }
 
     more_fragments = true;
-    if (chan->fragment_out.readcount + fragment_length == chan->fragment_out.cursize) {
+    if (chan->fragment_offset + fragment_length == chan->fragment_length) {
         more_fragments = false;
     }
 
@@ -209,38 +280,56 @@ int Netchan_TransmitNextFragment(netchan_t *chan)
 #endif
 
     // write fragment offset
-    SZ_WriteShort(&send, chan->fragment_out.readcount);
-
-    // write fragment contents
-    SZ_Write(&send, chan->fragment_out.data + chan->fragment_out.readcount, fragment_length);
+    SZ_WriteShort(&send, chan->fragment_offset);
+
+    vec[0].data = send.data;
+    vec[0].len = send.cursize;
+    count = 1;
+
+    // fragment contents may span reliable and unreliable parts
+    start = chan->fragment_offset;
+    end = start + fragment_length;
+    if (start < chan->fragment_reliable) {
+        vec[count].data = chan->reliable_buf + start;
+        vec[count].len = min(end, chan->fragment_reliable) - start;
+        count++;
+    }
+    if (end > chan->fragment_reliable) {
+        start = max(start, chan->fragment_reliable);
+        vec[count].data = chan->fragment_out->data + start - chan->fragment_reliable;
+        vec[count].len = end - start;
+        count++;
+    }
 
     SHOWPACKET("send %4u : s=%u ack=%u rack=%d "
                "fragment_offset=%u more_fragments=%d",
-               send.cursize,
+               send.cursize + fragment_length,
                chan->outgoing_sequence,
                chan->incoming_sequence,
                chan->incoming_reliable_sequence,
-               chan->fragment_out.readcount,
+               chan->fragment_offset,
                more_fragments);
     if (send_reliable) {
         SHOWPACKET(" reliable=%d", chan->reliable_sequence);
     }
     SHOWPACKET("\n");
 
-    chan->fragment_out.readcount += fragment_length;
+    // send the datagram
+    NET_SendPacketv(chan->sock, vec, count, &chan->remote_address);
+
+    chan->fragment_offset += fragment_length;
     chan->fragment_pending = more_fragments;
 
-    // if the message has been sent completely, clear the fragment buffer
+    // if the message has been sent completely, release the fragment buffer
     if (!chan->fragment_pending) {
         chan->outgoing_sequence++;
         chan->last_sent = com_localTime;
-        SZ_Clear(&chan->fragment_out);
+        chan->fragment_reliable = chan->fragment_length = chan->fragment_offset = 0;
+        Netbuf_Put(chan->fragment_out);
+        chan->fragment_out = NULL;
     }
 
-    // send the datagram
-    NET_SendPacket(chan->sock, send.data, send.cursize, &chan->remote_address);
-
-    return send.cursize;
+    return send.cursize + fragment_length;
 }
 
 /*
@@ -251,9 +340,11 @@ Netchan_Transmit
 int Netchan_Transmit(netchan_t *chan, size_t length, const void *data, int numpackets)
 {
     sizebuf_t   send;
-    byte        send_buf[MAX_PACKETLEN];
+    byte        send_buf[16];
+    netvec_t    vec[3];
     bool        send_reliable;
     unsigned    w1, w2;
+    int         count;
 
     if (chan->fragment_pending) {
         return Netchan_TransmitNextFragment(chan);
@@ -276,7 +367,7 @@ int Netchan_Transmit(netchan_t *chan, size_t length, const void *data, int numpa
 // if the reliable transmit buffer is empty, copy the current message out
     if (!chan->reliable_length && chan->message.cursize) {
         send_reliable = true;
-        memcpy(chan->reliable_buf, chan->message.data, chan->message.cursize);
+        Netchan_Copy(chan->reliable_buf, chan->message.data, chan->message.cursize);
         chan->reliable_length = chan->message.cursize;
         chan->message.cursize = 0;
         chan->reliable_sequence ^= 1;
@@ -284,15 +375,24 @@ int Netchan_Transmit(netchan_t *chan, size_t length, const void *data, int numpa
 
     if (length > chan->maxpacketlen || (send_reliable &&
                                         (chan->reliable_length + length > chan->maxpacketlen))) {
+        chan->fragment_reliable = 0;
+        chan->fragment_offset = 0;
         if (send_reliable) {
             chan->last_reliable_sequence = chan->outgoing_sequence;
-            SZ_Write(&chan->fragment_out, chan->reliable_buf, chan->reliable_length);
+            chan->fragment_reliable = chan->reliable_length;
         }
+        chan->fragment_length = chan->fragment_reliable;
         // add the unreliable part if space is available
-        if (chan->fragment_out.maxsize - chan->fragment_out.cursize >= length)
-            SZ_Write(&chan->fragment_out, data, length);
-        else
+        if (MAX_MSGLEN - chan->fragment_length >= length) {
+            if (length) {
+                if (!chan->fragment_out)
+                    chan->fragment_out = Netbuf_Get();
+                Netchan_Copy(chan->fragment_out->data, data, length);
+                chan->fragment_length += length;
+            }
+        } else {
             Com_WPrintf("%s: dumped unreliable\n", NET_AdrToString(&chan->remote_address));
+        }
         return Netchan_TransmitNextFragment(chan);
     }
 
@@ -317,14 +417,26 @@ int Netchan_Transmit(netchan_t *chan, size_t length, const void *data, int numpa
     }
 #endif
 
-    // copy the reliable message to the packet first
+    vec[0].data = send.data;
+    vec[0].len = send.cursize;
+    count = 1;
+
+    // reliable message goes to the packet first
     if (send_reliable) {
         chan->last_reliable_sequence = chan->outgoing_sequence;
-        SZ_Write(&send, chan->reliable_buf, chan->reliable_length);
+        vec[count].data = chan->reliable_buf;
+        vec[count].len = chan->reliable_length;
+        count++;
+        send.cursize += chan->reliable_length;
     }
 
     // add the unreliable part
-    SZ_Write(&send, data, length);
+    if (length) {
+        vec[count].data = data;
+        vec[count].len = length;
+        count++;
+        send.cursize += length;
+    }
 
     SHOWPACKET("send %4u : s=%u ack=%u rack=%d",
                send.cursize,
@@ -338,7 +450,7 @@ int Netchan_Transmit(netchan_t *chan, size_t length, const void *data, int numpa
 
     // send the datagram
     for (int i = 0; i < numpackets; i++) {
-        NET_SendPacket(chan->sock, send.data, send.cursize, &chan->remote_address);
+        NET_SendPacketv(chan->sock, vec, count, &chan->remote_address);
     }
 
     chan->outgoing_sequence++;
@@ -358,6 +470,10 @@ bool Netchan_Process(netchan_t *chan)
     unsigned    sequence, sequence_ack, fragment_offset, length;
     bool        reliable_message, reliable_ack, fragmented_message, more_fragments;
 
+    // previous assembled message has been parsed
+    Netbuf_Put(netbuf_read);
+    netbuf_read = NULL;
+
 // get sequence numbers
     MSG_BeginReading();
     sequence = MSG_ReadLong();
@@ -435,37 +551,44 @@ bool Netchan_Process(netchan_t *chan)
         if (chan->fragment_sequence != sequence) {
             // start new receive sequence
             chan->fragment_sequence = sequence;
-            SZ_Clear(&chan->fragment_in);
+            chan->fragment_in_length = 0;
         }
 
-        if (fragment_offset < chan->fragment_in.cursize) {
+        if (fragment_offset < chan->fragment_in_length) {
             SHOWDROP("%s: out of order fragment at %u\n",
                      NET_AdrToString(&chan->remote_address), sequence);
             return false;
         }
 
-        if (fragment_offset > chan->fragment_in.cursize) {
+        if (fragment_offset > chan->fragment_in_length) {
             SHOWDROP("%s: dropped fragment(s) at %u\n",
                      NET_AdrToString(&chan->remote_address), sequence);
             return false;
         }
 
         length = msg_read.cursize - msg_read.readcount;
-        if (length > chan->fragment_in.maxsize - chan->fragment_in.cursize) {
+        if (length > MAX_MSGLEN - chan->fragment_in_length) {
             SHOWDROP("%s: oversize fragment at %u\n",
                      NET_AdrToString(&chan->remote_address), sequence);
             return false;
         }
 
-        SZ_Write(&chan->fragment_in, msg_read.data + msg_read.readcount, length);
+        if (!chan->fragment_in) {
+            chan->fragment_in = Netbuf_Get();
+        }
+
+        Netchan_Copy(chan->fragment_in->data + chan->fragment_in_length,
+                     msg_read.data + msg_read.readcount, length);
+        chan->fragment_in_length += length;
         if (more_fragments) {
             return false;
         }
 
-        // message has been successfully assembled
-        memcpy(msg_read_buffer, chan->fragment_in.data, chan->fragment_in.cursize);
-        SZ_InitRead(&msg_read, msg_read_buffer, chan->fragment_in.cursize);
-        SZ_Clear(&chan->fragment_in);
+        // message has been successfully assembled, read it in place
+        netbuf_read = chan->fragment_in;
+        SZ_InitRead(&msg_read, netbuf_read->data, chan->fragment_in_length);
+        chan->fragment_in = NULL;
+        chan->fragment_in_length = 0;
     }
 
     chan->incoming_sequence = sequence;
@@ -499,10 +622,32 @@ bool Netchan_ShouldUpdate(const netchan_t *chan)
 {
     return chan->message.cursize
         || chan->reliable_ack_pending
-        || chan->fragment_out.cursize
+        || chan->fragment_pending
         || com_localTime - chan->last_sent > 1000;
 }
 
+/*
+==============
+Netchan_ReliableSize
+
+Returns how many bytes of reliable data next Netchan_Transmit will add to
+the packet.
+==============
+*/
+size_t Netchan_ReliableSize(const netchan_t *chan)
+{
+    // remote side dropped the last reliable message
+    if (chan->incoming_acknowledged > chan->last_reliable_sequence &&
+        chan->incoming_reliable_acknowledged != chan->reliable_sequence)
+        return chan->reliable_length;
+
+    // current message will be copied out
+    if (!chan->reliable_length)
+        return chan->message.cursize;
+
+    return 0;
+}
+
 /*
 ==============
 Netchan_Setup
@@ -529,10 +674,8 @@ void Netchan_Setup(netchan_t *chan, netsrc_t sock, const netadr_t *adr,
     chan->last_sent = com_localTime;
     chan->incoming_sequence = 0;
     chan->outgoing_sequence = 1;
-    chan->reliable_buf = buf = Z_TagMalloc(MAX_MSGLEN * 4, tag);
+    chan->reliable_buf = buf = Z_TagMalloc(MAX_MSGLEN * 2, tag);
     SZ_InitWrite(&chan->message, buf + MAX_MSGLEN, MAX_MSGLEN);
-    SZ_Init(&chan->fragment_in, buf + MAX_MSGLEN * 2, MAX_MSGLEN, "nc_frg_in");
-    SZ_Init(&chan->fragment_out, buf + MAX_MSGLEN * 3, MAX_MSGLEN, "nc_frg_out");
 }
 
 /*
@@ -543,6 +686,22 @@ Netchan_Close
 void Netchan_Close(netchan_t *chan)
 {
     Q_assert(chan);
+    Netbuf_Put(chan->fragment_in);
+    Netbuf_Put(chan->fragment_out);
     Z_Free(chan->reliable_buf);
     memset(chan, 0, sizeof(*chan));
 }
+
+/*
+==============
+Netchan_Stats
+==============
+*/
+void Netchan_Stats(void)
+{
+    Com_Printf("Netchan copies: %"PRIu64" (%"PRIu64" bytes)\n",
+               netchan_copies, netchan_copied);
+    Com_Printf("Netchan buffers: %"PRIu64" allocated, %"PRIu64" reused, "
+               "%u in use, %u free\n", netbuf_allocs, netbuf_reuses,
+               netbuf_inuse, netbuf_numfree);
+}
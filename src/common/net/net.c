@@ -24,17 +24,22 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "common/common.h"
 #include "common/cvar.h"
 #include "common/fifo.h"
+#include "common/list.h"
 #if USE_DEBUG
 #include "common/files.h"
 #endif
 #include "common/msg.h"
+#include "common/net/chan.h"
 #include "common/net/net.h"
 #include "common/protocol.h"
 #include "common/zone.h"
 #include "client/client.h"
 #include "server/server.h"
+#include "system/pthread.h"
 #include "system/system.h"
 
+#include <stdatomic.h>
+
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -47,6 +52,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netdb.h>
 #include <sys/param.h>
@@ -65,6 +71,19 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 // prevents infinite retry loops caused by broken TCP/IP stacks
 #define MAX_ERROR_RETRIES   64
 
+// copies scattered packet into contiguous buffer
+static size_t NET_GatherPacket(byte *buf, const netvec_t *vec, int count)
+{
+    size_t len = 0;
+
+    for (int i = 0; i < count; i++) {
+        memcpy(buf + len, vec[i].data, vec[i].len);
+        len += vec[i].len;
+    }
+
+    return len;
+}
+
 #if USE_CLIENT
 
 #define MAX_LOOPBACK    4
@@ -103,12 +122,23 @@ static cvar_t   *net_log_flush;
 
 static cvar_t   *net_enable_ipv6;
 
+static cvar_t   *net_sim;
+static cvar_t   *net_sim_latency;
+static cvar_t   *net_sim_jitter;
+static cvar_t   *net_sim_loss;
+static cvar_t   *net_sim_dup;
+static cvar_t   *net_sim_reorder;
+static cvar_t   *net_sim_rate;
+static cvar_t   *net_sim_seed;
+
+static void NET_SimStats(void);
+
 #if USE_ICMP
 static cvar_t   *net_ignore_icmp;
 #endif
 
 static netflag_t    net_active;
-static int          net_error;
+static q_thread_local int   net_error;
 
 static struct pollfd    *udp_sockets[NS_COUNT];
 static struct pollfd    *tcp_socket;
@@ -143,6 +173,44 @@ static uint64_t     net_bytes_sent;
 static uint64_t     net_packets_rcvd;
 static uint64_t     net_packets_sent;
 
+// server sockets handed over to receive threads
+typedef struct {
+    struct pollfd   fds[2];
+    int             numfds;
+    qsocket_t       udp;
+    qsocket_t       udp6;
+    bool            owned;      // opened for this shard only
+} netshard_t;
+
+static netshard_t       net_shards[MAX_NET_SHARDS];
+static int              net_num_shards;
+static bool             net_reuseport;
+static struct pollfd    *net_wake_socket;
+
+// updated by receive threads, folded into main counters by NET_UpdateStats
+static struct {
+    atomic_size_t   bytes_rcvd;
+    atomic_size_t   bytes_sent;
+    atomic_uint     packets_rcvd;
+    atomic_uint     packets_sent;
+    atomic_uint     recv_errors;
+    atomic_uint     send_errors;
+} net_offload_stats;
+
+#if USE_ICMP
+#define MAX_OFFLOAD_ERRORS  64
+
+typedef struct {
+    netadr_t    from;
+    int         ee_errno;
+    int         ee_info;
+} neterror_t;
+
+static pthread_mutex_t  net_offload_lock = PTHREAD_MUTEX_INITIALIZER;
+static neterror_t       net_offload_errors[MAX_OFFLOAD_ERRORS];
+static int              net_offload_numerrors;
+#endif
+
 //=============================================================================
 
 static size_t NET_NetadrToSockadr(const netadr_t *a, struct sockaddr_storage *s)
@@ -467,10 +535,32 @@ static void NET_LogPacket(const netadr_t *address, const char *prefix,
 
 #define RATE_SECS    3
 
+static void NET_FoldOffloadStats(void)
+{
+    size_t rcvd, sent;
+
+    if (!net_num_shards)
+        return;
+
+    rcvd = atomic_exchange(&net_offload_stats.bytes_rcvd, 0);
+    sent = atomic_exchange(&net_offload_stats.bytes_sent, 0);
+
+    net_rate_rcvd += rcvd;
+    net_rate_sent += sent;
+    net_bytes_rcvd += rcvd;
+    net_bytes_sent += sent;
+    net_packets_rcvd += atomic_exchange(&net_offload_stats.packets_rcvd, 0);
+    net_packets_sent += atomic_exchange(&net_offload_stats.packets_sent, 0);
+    net_recv_errors += atomic_exchange(&net_offload_stats.recv_errors, 0);
+    net_send_errors += atomic_exchange(&net_offload_stats.send_errors, 0);
+}
+
 void NET_UpdateStats(void)
 {
     unsigned diff;
 
+    NET_FoldOffloadStats();
+
     if (net_rate_time > com_eventTime) {
         net_rate_time = com_eventTime;
     }
@@ -504,6 +594,8 @@ static void NET_Stats_f(void)
         diff = 1;
     }
 
+    NET_FoldOffloadStats();
+
     Com_FormatTime(buffer, sizeof(buffer), diff);
     Com_Printf("Network uptime: %s\n", buffer);
     Com_Printf("Bytes sent: %"PRIu64" (%"PRIu64" bytes/sec)\n",
@@ -523,6 +615,10 @@ static void NET_Stats_f(void)
 #endif
     Com_Printf("Current upload rate: %zu bytes/sec\n", net_rate_up);
     Com_Printf("Current download rate: %zu bytes/sec\n", net_rate_dn);
+    if (net_num_shards)
+        Com_Printf("Server receive threads: %d\n", net_num_shards);
+    Netchan_Stats();
+    NET_SimStats();
 }
 
 static size_t NET_UpRate_m(char *buffer, size_t size)
@@ -568,8 +664,8 @@ static void NET_GetLoopPackets(netsrc_t sock, void (*packet_cb)(void))
     }
 }
 
-static bool NET_SendLoopPacket(netsrc_t sock, const void *data,
-                               size_t len, const netadr_t *to)
+static bool NET_SendLoopPacket(netsrc_t sock, const netvec_t *vec,
+                               int count, const netadr_t *to)
 {
     loopback_t *loop;
     loopmsg_t *msg;
@@ -583,13 +679,12 @@ static bool NET_SendLoopPacket(netsrc_t sock, const void *data,
     msg = &loop->msgs[loop->send & (MAX_LOOPBACK - 1)];
     loop->send++;
 
-    memcpy(msg->data, data, len);
-    msg->datalen = len;
+    msg->datalen = NET_GatherPacket(msg->data, vec, count);
 
-    NET_LogPacket(to, "LP send", data, len);
+    NET_LogPacket(to, "LP send", msg->data, msg->datalen);
 
     if (sock == NS_CLIENT) {
-        net_rate_sent += len;
+        net_rate_sent += msg->datalen;
     }
 
     return true;
@@ -597,16 +692,334 @@ static bool NET_SendLoopPacket(netsrc_t sock, const void *data,
 
 #endif // USE_CLIENT
 
+/*
+===============================================================================
+
+NETWORK SIMULATOR
+
+Holds packets sent or received by main thread in per-direction queues to
+simulate latency, jitter, loss, duplication, reordering and bandwidth limit.
+Random decisions are made by seeded generator, so that the same traffic gets
+impaired the same way on every run.
+
+===============================================================================
+*/
+
+#define SIM_SEND        0
+#define SIM_RECV        1
+
+#define SIM_MAX_PACKETS 1024
+#define SIM_MAX_BACKLOG 1000000     // usec of data queued on bandwidth limit
+
+typedef struct {
+    list_t      entry;
+    uint64_t    queued;
+    uint64_t    time;       // when to release
+    netadr_t    adr;
+    unsigned    len;
+    byte        data[];
+} simpacket_t;
+
+typedef struct {
+    list_t      queue;      // sorted by release time
+    unsigned    count;
+    uint64_t    last;       // release time of last in-order packet
+    uint64_t    linkfree;   // when bandwidth limited link gets idle
+    uint32_t    rand;
+
+    // statistics
+    uint64_t    packets, bytes;
+    uint64_t    lost, dups, reorders, overflows;
+    uint64_t    delivered, delay;
+} simdir_t;
+
+static simdir_t     net_sim_dirs[NS_COUNT][2];
+static bool         net_sim_bypass;
+static netsrc_t     net_sim_sock;
+
+static const char *const net_sim_names[NS_COUNT][2] = {
+    { "client send", "client recv" },
+    { "server send", "server recv" },
+};
+
+static bool NET_SimEnabled(int dir)
+{
+    return net_sim->integer & BIT(dir);
+}
+
+static uint32_t NET_SimRand(simdir_t *d)
+{
+    // xorshift32
+    d->rand ^= d->rand << 13;
+    d->rand ^= d->rand >> 17;
+    d->rand ^= d->rand << 5;
+    return d->rand;
+}
+
+static bool NET_SimChance(simdir_t *d, const cvar_t *var)
+{
+    return var->value > 0 && NET_SimRand(d) % 10000 < var->value * 100;
+}
+
+static void NET_SimQueue(simdir_t *d, const void *data, unsigned len, const netadr_t *adr)
+{
+    uint64_t now = Sys_Microseconds();
+    int copies, latency, jitter, rate;
+    simpacket_t *p, *cursor;
+    uint64_t time;
+
+    d->packets++;
+    d->bytes += len;
+
+    if (NET_SimChance(d, net_sim_loss)) {
+        d->lost++;
+        return;
+    }
+
+    copies = 1;
+    if (NET_SimChance(d, net_sim_dup)) {
+        d->dups++;
+        copies++;
+    }
+
+    latency = Cvar_ClampInteger(net_sim_latency, 0, 10000);
+    jitter = Cvar_ClampInteger(net_sim_jitter, 0, 10000);
+    rate = Cvar_ClampInteger(net_sim_rate, 0, INT_MAX);
+
+    while (copies--) {
+        time = now;
+
+        // serialize on bandwidth limited link
+        if (rate) {
+            if (d->linkfree < now)
+                d->linkfree = now;
+            if (d->linkfree - now > SIM_MAX_BACKLOG) {
+                d->overflows++;
+                continue;
+            }
+            d->linkfree += len * UINT64_C(1000000) / rate;
+            time = d->linkfree;
+        }
+
+        time += latency * 1000;
+        if (jitter) {
+            int ofs = (int)(NET_SimRand(d) % (jitter * 2 + 1)) - jitter;
+            time = max(time + ofs * 1000, now);
+        }
+
+        // reordered packet is held back for others to overtake it,
+        // others never overtake each other
+        if (NET_SimChance(d, net_sim_reorder)) {
+            time += (1 + NET_SimRand(d) % max(latency, 20)) * 1000;
+            d->reorders++;
+        } else {
+            time = max(time, d->last);
+            d->last = time;
+        }
+
+        if (d->count >= SIM_MAX_PACKETS) {
+            d->overflows++;
+            continue;
+        }
+
+        p = Z_Malloc(sizeof(*p) + len);
+        p->queued = now;
+        p->time = time;
+        p->adr = *adr;
+        p->len = len;
+        memcpy(p->data, data, len);
+
+        // most packets go to the tail
+        for (cursor = LIST_LAST(simpacket_t, &d->queue, entry);
+             !LIST_TERM(cursor, &d->queue, entry) && cursor->time > time;
+             cursor = LIST_PREV(simpacket_t, cursor, entry))
+            ;
+        List_Insert(&cursor->entry, &p->entry);
+        d->count++;
+    }
+}
+
+// packet_cb for capturing received packets
+static void NET_SimRecv(void)
+{
+    NET_SimQueue(&net_sim_dirs[net_sim_sock][SIM_RECV],
+                 msg_read.data, msg_read.cursize, &net_from);
+}
+
+static simpacket_t *NET_SimNext(simdir_t *d, int dir, uint64_t now)
+{
+    simpacket_t *p;
+
+    if (LIST_EMPTY(&d->queue))
+        return NULL;
+
+    // release everything once disabled
+    p = LIST_FIRST(simpacket_t, &d->queue, entry);
+    if (p->time > now && NET_SimEnabled(dir))
+        return NULL;
+
+    List_Remove(&p->entry);
+    d->count--;
+    d->delivered++;
+    d->delay += now - p->queued;
+    return p;
+}
+
+static void NET_SimFlush(netsrc_t sock, void (*packet_cb)(void))
+{
+    simdir_t *d = net_sim_dirs[sock];
+    uint64_t now = Sys_Microseconds();
+    simpacket_t *p;
+
+    net_sim_bypass = true;
+    while ((p = NET_SimNext(&d[SIM_SEND], SIM_SEND, now))) {
+        NET_SendPacket(sock, p->data, p->len, &p->adr);
+        Z_Free(p);
+    }
+    net_sim_bypass = false;
+
+    while ((p = NET_SimNext(&d[SIM_RECV], SIM_RECV, now))) {
+        memcpy(msg_read_buffer, p->data, p->len);
+        SZ_InitRead(&msg_read, msg_read_buffer, p->len);
+        net_from = p->adr;
+        Z_Free(p);
+        (*packet_cb)();
+    }
+}
+
+// returns how long main thread can sleep before next packet is due
+static int NET_SimTimeout(int msec)
+{
+    uint64_t now = Sys_Microseconds();
+    const simpacket_t *p;
+
+    for (int i = 0; i < NS_COUNT; i++) {
+        for (int j = 0; j < 2; j++) {
+            if (LIST_EMPTY(&net_sim_dirs[i][j].queue))
+                continue;
+            p = LIST_FIRST(simpacket_t, &net_sim_dirs[i][j].queue, entry);
+            if (p->time <= now)
+                return 0;
+            msec = min(msec, (p->time - now + 999) / 1000);
+        }
+    }
+
+    return msec;
+}
+
+// restarts random generators and statistics, optionally drops queued packets
+static void NET_SimReset(bool clear)
+{
+    simpacket_t *p, *next;
+    uint32_t seed;
+
+    for (int i = 0; i < NS_COUNT; i++) {
+        for (int j = 0; j < 2; j++) {
+            simdir_t *d = &net_sim_dirs[i][j];
+
+            if (!d->queue.next) {
+                List_Init(&d->queue);
+            } else if (clear) {
+                LIST_FOR_EACH_SAFE(p, next, &d->queue, entry)
+                    Z_Free(p);
+                List_Init(&d->queue);
+                d->count = 0;
+            }
+
+            // independent sequence for each direction
+            seed = net_sim_seed->integer * 0x9e3779b9 + (i * 2 + j + 1) * 0x85ebca6b;
+            seed ^= seed >> 16;
+            seed *= 0x7feb352d;
+            seed ^= seed >> 15;
+            d->rand = seed ? seed : 1;
+
+            d->last = d->linkfree = 0;
+            d->packets = d->bytes = 0;
+            d->lost = d->dups = d->reorders = d->overflows = 0;
+            d->delivered = d->delay = 0;
+        }
+    }
+}
+
+static void NET_SimStats(void)
+{
+    for (int i = 0; i < NS_COUNT; i++) {
+        for (int j = 0; j < 2; j++) {
+            const simdir_t *d = &net_sim_dirs[i][j];
+            if (!d->packets)
+                continue;
+            Com_Printf("Simulator %s: %"PRIu64" packets, %"PRIu64" bytes, "
+                       "%"PRIu64" lost, %"PRIu64" duplicated, %"PRIu64" reordered, "
+                       "%"PRIu64" overflowed, %u queued, %"PRIu64" msec avg delay\n",
+                       net_sim_names[i][j], d->packets, d->bytes, d->lost, d->dups,
+                       d->reorders, d->overflows, d->count,
+                       d->delivered ? d->delay / d->delivered / 1000 : 0);
+        }
+    }
+}
+
+static void net_sim_changed(cvar_t *self)
+{
+    // queued packets are released on next poll if disabled
+    NET_SimReset(false);
+}
+
 //=============================================================================
 
 #if USE_ICMP
 
 static const char *os_error_string(int err);
 
+static bool NET_IsShardSocket(qsocket_t sock)
+{
+    for (int i = 0; i < net_num_shards; i++)
+        if (net_shards[i].udp == sock || net_shards[i].udp6 == sock)
+            return true;
+
+    return false;
+}
+
+static void NET_DeliverError(netsrc_t sock, const netadr_t *from,
+                             int ee_errno, int ee_info)
+{
+    Com_DPrintf("%s: %s from %s\n", __func__,
+                os_error_string(ee_errno), NET_AdrToString(from));
+    net_icmp_errors++;
+
+    switch (sock) {
+    case NS_CLIENT:
+        CL_ErrorEvent(from);
+        break;
+    case NS_SERVER:
+        SV_ErrorEvent(from, ee_errno, ee_info);
+        break;
+    default:
+        break;
+    }
+}
+
+// called on main thread to deliver errors caught by receive threads
+static void NET_FlushOffloadErrors(void)
+{
+    neterror_t errors[MAX_OFFLOAD_ERRORS];
+    int i, count;
+
+    pthread_mutex_lock(&net_offload_lock);
+    count = net_offload_numerrors;
+    memcpy(errors, net_offload_errors, sizeof(errors[0]) * count);
+    net_offload_numerrors = 0;
+    pthread_mutex_unlock(&net_offload_lock);
+
+    for (i = 0; i < count; i++)
+        NET_DeliverError(NS_SERVER, &errors[i].from,
+                         errors[i].ee_errno, errors[i].ee_info);
+}
+
 static void NET_ErrorEvent(qsocket_t sock, const netadr_t *from,
                            int ee_errno, int ee_info)
 {
     struct pollfd *s;
+    neterror_t *e;
     int i;
 
     if (net_ignore_icmp->integer > 0) {
@@ -617,23 +1030,25 @@ static void NET_ErrorEvent(qsocket_t sock, const netadr_t *from,
         return;
     }
 
-    Com_DPrintf("%s: %s from %s\n", __func__,
-                os_error_string(ee_errno), NET_AdrToString(from));
-    net_icmp_errors++;
+    // this may be called from receive thread, defer to main thread
+    if (NET_IsShardSocket(sock)) {
+        pthread_mutex_lock(&net_offload_lock);
+        if (net_offload_numerrors < MAX_OFFLOAD_ERRORS) {
+            e = &net_offload_errors[net_offload_numerrors++];
+            e->from = *from;
+            e->ee_errno = ee_errno;
+            e->ee_info = ee_info;
+        }
+        pthread_mutex_unlock(&net_offload_lock);
+        return;
+    }
 
     for (i = 0; i < NS_COUNT; i++)
         if (((s = udp_sockets[i]) && s->fd == sock) ||
             ((s = udp6_sockets[i]) && s->fd == sock))
             break;
 
-    switch (i) {
-    case NS_CLIENT:
-        CL_ErrorEvent(from);
-        break;
-    case NS_SERVER:
-        SV_ErrorEvent(from, ee_errno, ee_info);
-        break;
-    }
+    NET_DeliverError(i, from, ee_errno, ee_info);
 }
 
 #endif // USE_ICMP
@@ -713,6 +1128,9 @@ int NET_Sleep(int msec)
 {
     int ret;
 
+    // wake up for packets held by simulator
+    msec = NET_SimTimeout(msec);
+
     if (!io_numfds) {
         // don't bother with poll()
         Sys_Sleep(msec);
@@ -786,6 +1204,8 @@ static void NET_GetUdpPackets(struct pollfd *sock, void (*packet_cb)(void))
     }
 }
 
+static void NET_GetOffloadEvents(void);
+
 /*
 =============
 NET_GetPackets
@@ -796,19 +1216,35 @@ net_from variable receives source address.
 */
 void NET_GetPackets(netsrc_t sock, void (*packet_cb)(void))
 {
+    void (*read_cb)(void) = packet_cb;
+
+    // received packets go through simulator
+    if (NET_SimEnabled(SIM_RECV)) {
+        net_sim_sock = sock;
+        read_cb = NET_SimRecv;
+    }
+
 #if USE_CLIENT
     memset(&net_from, 0, sizeof(net_from));
     net_from.type = NA_LOOPBACK;
 
     // process loopback packets
-    NET_GetLoopPackets(sock, packet_cb);
+    NET_GetLoopPackets(sock, read_cb);
 #endif
 
-    // process UDP packets
-    NET_GetUdpPackets(udp_sockets[sock], packet_cb);
+    // server sockets are read by receive threads
+    if (sock == NS_SERVER && net_num_shards) {
+        NET_GetOffloadEvents();
+    } else {
+        // process UDP packets
+        NET_GetUdpPackets(udp_sockets[sock], read_cb);
 
-    // process UDP6 packets
-    NET_GetUdpPackets(udp6_sockets[sock], packet_cb);
+        // process UDP6 packets
+        NET_GetUdpPackets(udp6_sockets[sock], read_cb);
+    }
+
+    // send and deliver packets held by simulator
+    NET_SimFlush(sock, packet_cb);
 }
 
 /*
@@ -820,9 +1256,32 @@ NET_SendPacket
 bool NET_SendPacket(netsrc_t sock, const void *data,
                     size_t len, const netadr_t *to)
 {
+    netvec_t vec = { data, len };
+
+    return NET_SendPacketv(sock, &vec, 1, to);
+}
+
+/*
+=============
+NET_SendPacketv
+
+Sends packet gathered from several pieces without copying them together,
+unless packet goes to loopback, simulator or log.
+=============
+*/
+bool NET_SendPacketv(netsrc_t sock, const netvec_t *vec,
+                     int count, const netadr_t *to)
+{
+    byte buffer[MAX_PACKETLEN];
+    size_t len = 0;
     int ret;
     struct pollfd *s;
 
+    Q_assert(count > 0 && count <= MAX_NETVECS);
+
+    for (int i = 0; i < count; i++)
+        len += vec[i].len;
+
     if (len == 0)
         return false;
 
@@ -832,12 +1291,18 @@ bool NET_SendPacket(netsrc_t sock, const void *data,
         return false;
     }
 
+    if (!net_sim_bypass && NET_SimEnabled(SIM_SEND) && to->type != NA_UNSPECIFIED) {
+        NET_GatherPacket(buffer, vec, count);
+        NET_SimQueue(&net_sim_dirs[sock][SIM_SEND], buffer, len, to);
+        return true;
+    }
+
     switch (to->type) {
     case NA_UNSPECIFIED:
         return false;
 #if USE_CLIENT
     case NA_LOOPBACK:
-        return NET_SendLoopPacket(sock, data, len, to);
+        return NET_SendLoopPacket(sock, vec, count, to);
     case NA_BROADCAST:
 #endif
     case NA_IP:
@@ -853,7 +1318,7 @@ bool NET_SendPacket(netsrc_t sock, const void *data,
     if (!s)
         return false;
 
-    ret = os_udp_send(s->fd, data, len, to);
+    ret = os_udp_send(s->fd, vec, count, to);
     if (ret == NET_AGAIN)
         return false;
 
@@ -868,7 +1333,12 @@ bool NET_SendPacket(netsrc_t sock, const void *data,
         Com_WPrintf("%s: short send to %s\n", __func__,
                     NET_AdrToString(to));
 
-    NET_LogPacket(to, "UDP send", data, ret);
+#if USE_DEBUG
+    if (net_logFile) {
+        NET_GatherPacket(buffer, vec, count);
+        NET_LogPacket(to, "UDP send", buffer, ret);
+    }
+#endif
 
     net_rate_sent += ret;
     net_bytes_sent += ret;
@@ -885,7 +1355,7 @@ static void NET_CloseSocket(struct pollfd *s)
     NET_FreePollFd(s);
 }
 
-static struct pollfd *UDP_OpenSocket(const char *iface, int port, int family)
+static struct pollfd *UDP_OpenSocket(const char *iface, int port, int family, bool shared)
 {
     qsocket_t s;
     struct addrinfo hints, *res, *rp;
@@ -996,6 +1466,14 @@ static struct pollfd *UDP_OpenSocket(const char *iface, int port, int family)
 #endif
         }
 
+#ifdef SO_REUSEPORT
+        // let receive threads bind their own sockets to the same port
+        if (shared && os_setsockopt(s, SOL_SOCKET, SO_REUSEPORT, 1)) {
+            Com_WPrintf("%s: %s:%d: can't enable port sharing: %s\n",
+                        __func__, iface, port, NET_ErrorString());
+        }
+#endif
+
         if (os_bind(s, rp->ai_addr, rp->ai_addrlen)) {
             Com_EPrintf("%s: %s:%d: can't bind socket: %s\n",
                         __func__, iface, port, NET_ErrorString());
@@ -1135,7 +1613,7 @@ static void NET_OpenServer(void)
     if (udp_sockets[NS_SERVER])
         return;
 
-    s = UDP_OpenSocket(net_ip->string, net_port->integer, AF_INET);
+    s = UDP_OpenSocket(net_ip->string, net_port->integer, AF_INET, net_reuseport);
     if (s) {
         saved_port = net_port->integer;
         udp_sockets[NS_SERVER] = s;
@@ -1165,7 +1643,7 @@ static void NET_OpenServer6(void)
     if (udp6_sockets[NS_SERVER])
         return;
 
-    udp6_sockets[NS_SERVER] = UDP_OpenSocket(net_ip6->string, net_port->integer, AF_INET6);
+    udp6_sockets[NS_SERVER] = UDP_OpenSocket(net_ip6->string, net_port->integer, AF_INET6, net_reuseport);
 }
 
 #if USE_CLIENT
@@ -1177,11 +1655,11 @@ static void NET_OpenClient(void)
     if (udp_sockets[NS_CLIENT])
         return;
 
-    s = UDP_OpenSocket(net_ip->string, net_clientport->integer, AF_INET);
+    s = UDP_OpenSocket(net_ip->string, net_clientport->integer, AF_INET, false);
     if (!s) {
         // now try with random port
         if (net_clientport->integer != PORT_ANY)
-            s = UDP_OpenSocket(net_ip->string, PORT_ANY, AF_INET);
+            s = UDP_OpenSocket(net_ip->string, PORT_ANY, AF_INET, false);
 
         if (!s) {
             Com_WPrintf("Couldn't open client UDP port.\n");
@@ -1209,7 +1687,7 @@ static void NET_OpenClient6(void)
     if (udp6_sockets[NS_CLIENT])
         return;
 
-    udp6_sockets[NS_CLIENT] = UDP_OpenSocket(net_ip6->string, net_clientport->integer, AF_INET6);
+    udp6_sockets[NS_CLIENT] = UDP_OpenSocket(net_ip6->string, net_clientport->integer, AF_INET6, false);
 }
 #endif
 
@@ -1227,6 +1705,8 @@ void NET_Config(netflag_t flag)
     }
 
     if (flag == NET_NONE) {
+        Q_assert(!net_num_shards);
+
         // shut down any existing sockets
         for (sock = 0; sock < NS_COUNT; sock++) {
             if (udp_sockets[sock]) {
@@ -1257,6 +1737,319 @@ void NET_Config(netflag_t flag)
     net_active |= flag;
 }
 
+/*
+=============================================================================
+
+SERVER OFFLOADING
+
+Server UDP sockets can be handed over to receive threads. Main thread then
+no longer polls or reads them, but may still send from them. Where
+SO_REUSEPORT is available, each additional thread gets its own socket bound
+to the same port, and kernel spreads incoming traffic between them (packets
+from the same source address always land on the same socket).
+
+=============================================================================
+*/
+
+static qsocket_t NET_OpenShardSocket(const char *iface, int family)
+{
+    struct pollfd *e;
+    qsocket_t s;
+
+    e = UDP_OpenSocket(iface, net_port->integer, family, true);
+    if (!e)
+        return -1;
+
+    // not polled by main thread
+    s = e->fd;
+    NET_FreePollFd(e);
+    return s;
+}
+
+static void NET_AddShardSocket(netshard_t *shard, qsocket_t s)
+{
+    struct pollfd *e = &shard->fds[shard->numfds++];
+
+    e->fd = s;
+    e->events = POLLIN;
+    e->revents = 0;
+}
+
+// receive threads use this to wake up main thread from NET_Sleep
+static struct pollfd *NET_OpenWakeSocket(void)
+{
+    struct sockaddr_in sin;
+    struct pollfd *e;
+    netadr_t adr;
+    qsocket_t s;
+
+    e = NET_AllocPollFd();
+    if (!e) {
+        Com_EPrintf("%s: too many open sockets\n", __func__);
+        return NULL;
+    }
+
+    s = os_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == -1)
+        goto fail;
+
+    memset(&sin, 0, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (os_make_nonblock(s, 1) ||
+        os_bind(s, (struct sockaddr *)&sin, sizeof(sin)) ||
+        os_getsockname(s, &adr) ||
+        os_connect(s, &adr)) {
+        os_closesocket(s);
+        goto fail;
+    }
+
+    e->fd = s;
+    e->events = POLLIN;
+    return e;
+
+fail:
+    Com_EPrintf("%s: %s\n", __func__, NET_ErrorString());
+    NET_FreePollFd(e);
+    return NULL;
+}
+
+static void NET_GetOffloadEvents(void)
+{
+    byte buf[16];
+
+    if (net_wake_socket->revents & POLLIN) {
+        while (os_recv(net_wake_socket->fd, buf, sizeof(buf), 0) > 0)
+            ;
+        net_wake_socket->revents = 0;
+    }
+
+#if USE_ICMP
+    NET_FlushOffloadErrors();
+#endif
+}
+
+/*
+====================
+NET_OffloadServer
+
+Hands server sockets over to `count' receive threads, which must be started
+afterwards. Returns number of shards actually created, 0 on failure.
+====================
+*/
+int NET_OffloadServer(int count)
+{
+    netshard_t *shard;
+    netsrc_t sock;
+    int i;
+
+    Q_assert(!net_num_shards);
+
+    if (!udp_sockets[NS_SERVER] && !udp6_sockets[NS_SERVER])
+        return 0;
+
+#ifdef SO_REUSEPORT
+    count = Q_clip(count, 1, MAX_NET_SHARDS);
+#else
+    count = 1;
+#endif
+
+    // port can be shared only if all sockets agree on it
+    if (count > 1 && !net_reuseport) {
+        net_reuseport = true;
+        sock = NS_SERVER;
+        if (udp_sockets[sock]) {
+            NET_CloseSocket(udp_sockets[sock]);
+            udp_sockets[sock] = NULL;
+        }
+        if (udp6_sockets[sock]) {
+            NET_CloseSocket(udp6_sockets[sock]);
+            udp6_sockets[sock] = NULL;
+        }
+        NET_OpenServer();
+        NET_OpenServer6();
+        if (!udp_sockets[NS_SERVER] && !udp6_sockets[NS_SERVER])
+            return 0;
+    }
+
+    net_wake_socket = NET_OpenWakeSocket();
+    if (!net_wake_socket)
+        return 0;
+
+    // first shard takes over main sockets
+    shard = &net_shards[0];
+    memset(shard, 0, sizeof(*shard));
+    shard->udp = shard->udp6 = -1;
+    if (udp_sockets[NS_SERVER]) {
+        shard->udp = udp_sockets[NS_SERVER]->fd;
+        udp_sockets[NS_SERVER]->events = 0;
+        NET_AddShardSocket(shard, shard->udp);
+    }
+    if (udp6_sockets[NS_SERVER]) {
+        shard->udp6 = udp6_sockets[NS_SERVER]->fd;
+        udp6_sockets[NS_SERVER]->events = 0;
+        NET_AddShardSocket(shard, shard->udp6);
+    }
+
+    // others open their own
+    for (i = 1; i < count; i++) {
+        shard = &net_shards[i];
+        memset(shard, 0, sizeof(*shard));
+        shard->udp = shard->udp6 = -1;
+        shard->owned = true;
+        if (udp_sockets[NS_SERVER]) {
+            shard->udp = NET_OpenShardSocket(net_ip->string, AF_INET);
+            if (shard->udp != -1)
+                NET_AddShardSocket(shard, shard->udp);
+        }
+        if (udp6_sockets[NS_SERVER]) {
+            shard->udp6 = NET_OpenShardSocket(net_ip6->string, AF_INET6);
+            if (shard->udp6 != -1)
+                NET_AddShardSocket(shard, shard->udp6);
+        }
+        if (!shard->numfds)
+            break;
+    }
+
+    net_num_shards = i;
+    return i;
+}
+
+/*
+====================
+NET_RestoreServer
+
+Returns server sockets to main thread. Receive threads must be stopped.
+====================
+*/
+void NET_RestoreServer(void)
+{
+    netshard_t *shard;
+    int i;
+
+    if (!net_num_shards)
+        return;
+
+    NET_FoldOffloadStats();
+
+    for (i = 0, shard = net_shards; i < net_num_shards; i++, shard++) {
+        if (!shard->owned)
+            continue;
+        if (shard->udp != -1)
+            os_closesocket(shard->udp);
+        if (shard->udp6 != -1)
+            os_closesocket(shard->udp6);
+    }
+
+    if (udp_sockets[NS_SERVER])
+        udp_sockets[NS_SERVER]->events = POLLIN;
+    if (udp6_sockets[NS_SERVER])
+        udp6_sockets[NS_SERVER]->events = POLLIN;
+
+    NET_CloseSocket(net_wake_socket);
+    net_wake_socket = NULL;
+
+#if USE_ICMP
+    net_offload_numerrors = 0;
+#endif
+    net_num_shards = 0;
+}
+
+/*
+====================
+NET_OffloadWait
+
+Called from receive thread. Sleeps msec or until shard sockets are readable.
+====================
+*/
+int NET_OffloadWait(int shard, int msec)
+{
+    netshard_t *s = &net_shards[shard];
+
+    return os_poll(s->fds, s->numfds, msec);
+}
+
+/*
+====================
+NET_OffloadRecv
+
+Called from receive thread after NET_OffloadWait. Returns packet length, or
+NET_AGAIN when all shard sockets are drained.
+====================
+*/
+int NET_OffloadRecv(int shard, void *data, size_t len, netadr_t *from)
+{
+    netshard_t *s = &net_shards[shard];
+    struct pollfd *e;
+    int i, ret;
+
+    for (i = 0, e = s->fds; i < s->numfds; i++, e++) {
+        if (!(e->revents & (POLLIN | POLLERR)))
+            continue;
+
+        ret = os_udp_recv(e->fd, data, len, from);
+        if (ret < 0) {
+            if (ret == NET_ERROR)
+                atomic_fetch_add(&net_offload_stats.recv_errors, 1);
+            // poll again before retrying
+            e->revents = 0;
+            continue;
+        }
+
+        atomic_fetch_add(&net_offload_stats.bytes_rcvd, ret);
+        atomic_fetch_add(&net_offload_stats.packets_rcvd, 1);
+        return ret;
+    }
+
+    return NET_AGAIN;
+}
+
+/*
+====================
+NET_OffloadSend
+
+Called from receive thread to reply directly from shard socket.
+====================
+*/
+bool NET_OffloadSend(int shard, const void *data,
+                     size_t len, const netadr_t *to)
+{
+    netshard_t *s = &net_shards[shard];
+    qsocket_t sock = to->type == NA_IP6 ? s->udp6 : s->udp;
+    int ret;
+
+    if (sock == -1)
+        return false;
+
+    ret = os_udp_send(sock, &(netvec_t){ data, len }, 1, to);
+    if (ret == NET_AGAIN)
+        return false;
+
+    if (ret == NET_ERROR) {
+        atomic_fetch_add(&net_offload_stats.send_errors, 1);
+        return false;
+    }
+
+    atomic_fetch_add(&net_offload_stats.bytes_sent, ret);
+    atomic_fetch_add(&net_offload_stats.packets_sent, 1);
+    return true;
+}
+
+/*
+====================
+NET_OffloadWake
+
+Called from receive thread to make NET_Sleep return on main thread.
+====================
+*/
+void NET_OffloadWake(void)
+{
+    byte b = 0;
+
+    os_send(net_wake_socket->fd, &b, 1, 0);
+}
+
 /*
 ====================
 NET_GetAddress
@@ -1782,9 +2575,13 @@ static void NET_Restart_f(void)
     netflag_t flag = net_active;
     bool listen4 = tcp_socket;
     bool listen6 = tcp6_socket;
+    bool offload = net_num_shards;
 
     Com_DPrintf("%s\n", __func__);
 
+    if (offload)
+        SV_StopNetThreads();
+
     NET_Listen4(false);
     NET_Listen6(false);
     NET_Config(NET_NONE);
@@ -1796,6 +2593,9 @@ static void NET_Restart_f(void)
     NET_Listen4(listen4);
     NET_Listen6(listen6);
 
+    if (offload)
+        SV_StartNetThreads();
+
 #if USE_SYSCON
     SV_SetConsoleTitle();
 #endif
@@ -1839,6 +2639,18 @@ void NET_Init(void)
     net_dropsim = Cvar_Get("net_dropsim", "0", 0);
 #endif
 
+    net_sim = Cvar_Get("net_sim", "0", 0);
+    net_sim->changed = net_sim_changed;
+    net_sim_latency = Cvar_Get("net_sim_latency", "0", 0);
+    net_sim_jitter = Cvar_Get("net_sim_jitter", "0", 0);
+    net_sim_loss = Cvar_Get("net_sim_loss", "0", 0);
+    net_sim_dup = Cvar_Get("net_sim_dup", "0", 0);
+    net_sim_reorder = Cvar_Get("net_sim_reorder", "0", 0);
+    net_sim_rate = Cvar_Get("net_sim_rate", "0", 0);
+    net_sim_seed = Cvar_Get("net_sim_seed", "1", 0);
+    net_sim_seed->changed = net_sim_changed;
+    NET_SimReset(true);
+
 #if USE_DEBUG
     net_log_enable = Cvar_Get("net_log_enable", "0", 0);
     net_log_enable->changed = net_log_enable_changed;
@@ -1883,6 +2695,7 @@ void NET_Shutdown(void)
 
     NET_Listen(false);
     NET_Config(NET_NONE);
+    NET_SimReset(true);
     os_net_shutdown();
 
     Cmd_RemoveCommand("net_restart");
@@ -134,19 +134,28 @@ static int os_udp_recv(qsocket_t sock, void *data,
     return NET_ERROR;
 }
 
-static int os_udp_send(qsocket_t sock, const void *data,
-                       size_t len, const netadr_t *to)
+static int os_udp_send(qsocket_t sock, const netvec_t *vec,
+                       int count, const netadr_t *to)
 {
     struct sockaddr_storage addr;
-    socklen_t addrlen;
+    struct iovec iov[MAX_NETVECS];
+    struct msghdr msg;
     int ret;
     int tries;
 
-    addrlen = NET_NetadrToSockadr(to, &addr);
+    for (int i = 0; i < count; i++) {
+        iov[i].iov_base = (void *)vec[i].data;
+        iov[i].iov_len = vec[i].len;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &addr;
+    msg.msg_namelen = NET_NetadrToSockadr(to, &addr);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
 
     for (tries = 0; tries < MAX_ERROR_RETRIES; tries++) {
-        ret = sendto(sock, data, len, 0,
-                     (struct sockaddr *)&addr, addrlen);
+        ret = sendmsg(sock, &msg, 0);
         if (ret >= 0)
             return ret;
 
@@ -144,20 +144,27 @@ static int os_udp_recv(qsocket_t sock, void *data,
     return NET_ERROR;
 }
 
-static int os_udp_send(qsocket_t sock, const void *data,
-                       size_t len, const netadr_t *to)
+static int os_udp_send(qsocket_t sock, const netvec_t *vec,
+                       int count, const netadr_t *to)
 {
     struct sockaddr_storage addr;
+    WSABUF buf[MAX_NETVECS];
+    DWORD sent;
     int addrlen;
     int ret;
 
+    for (int i = 0; i < count; i++) {
+        buf[i].buf = (CHAR *)vec[i].data;
+        buf[i].len = vec[i].len;
+    }
+
     addrlen = NET_NetadrToSockadr(to, &addr);
 
-    ret = sendto(sock, data, len, 0,
-                 (struct sockaddr *)&addr, addrlen);
+    ret = WSASendTo(sock, buf, count, &sent, 0,
+                    (struct sockaddr *)&addr, addrlen, NULL, NULL);
 
     if (ret != SOCKET_ERROR)
-        return ret;
+        return sent;
 
     net_error = WSAGetLastError();
 
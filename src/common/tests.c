@@ -17,11 +17,14 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 */
 
 #include "shared/shared.h"
+#include "common/async.h"
 #include "common/bsp.h"
 #include "common/cmd.h"
 #include "common/common.h"
 #include "common/files.h"
+#include "common/hash_map.h"
 #include "common/mdfour.h"
+#include "common/msg.h"
 #include "common/tests.h"
 #include "common/utils.h"
 #include "refresh/refresh.h"
@@ -529,6 +532,321 @@ static void Com_TestSnprintf_f(void)
     Com_Printf("%d failures, %d strings tested\n", errors, num_snprintf_tests * 2);
 }
 
+static void Com_TestHashMap_f(void)
+{
+    int i, j, n, rounds, errors = 0;
+    uint32_t key, *val;
+    hash_map_t *map;
+    char (*names)[16];
+    const char **strs;
+    uint64_t start, t_insert, t_hit, t_miss, t_str, t_erase;
+
+    n = Cmd_Argc() > 1 ? Q_clip(Q_atoi(Cmd_Argv(1)), 1, 1 << 20) : 4096;
+    rounds = Cmd_Argc() > 2 ? Q_clip(Q_atoi(Cmd_Argv(2)), 1, 1000) : 100;
+
+    map = HashMap_Create(uint32_t, uint32_t, HashInt32, NULL);
+
+    start = Sys_Microseconds();
+    for (i = 0; i < n; i++) {
+        key = i * 2654435761u;
+        val = (uint32_t *)&i;
+        if (HashMap_Insert(map, &key, val))
+            errors++;
+    }
+    t_insert = Sys_Microseconds() - start;
+
+    start = Sys_Microseconds();
+    for (j = 0; j < rounds; j++) {
+        for (i = 0; i < n; i++) {
+            key = i * 2654435761u;
+            val = HashMap_Lookup(uint32_t, map, &key);
+            if (!val || *val != i)
+                errors++;
+        }
+    }
+    t_hit = Sys_Microseconds() - start;
+
+    start = Sys_Microseconds();
+    for (j = 0; j < rounds; j++) {
+        for (i = 0; i < n; i++) {
+            key = i * 2654435761u + 1;
+            if (HashMap_Lookup(uint32_t, map, &key))
+                errors++;
+        }
+    }
+    t_miss = Sys_Microseconds() - start;
+
+    start = Sys_Microseconds();
+    for (i = 0; i < n; i += 2) {
+        key = i * 2654435761u;
+        if (!HashMap_Erase(map, &key))
+            errors++;
+    }
+    t_erase = Sys_Microseconds() - start;
+
+    for (i = 0; i < n; i++) {
+        key = i * 2654435761u;
+        val = HashMap_Lookup(uint32_t, map, &key);
+        if (i & 1 ? !val || *val != i : !!val)
+            errors++;
+    }
+    if (HashMap_Size(map) != n / 2)
+        errors++;
+
+    HashMap_Destroy(map);
+
+    names = Z_Malloc(n * sizeof(names[0]));
+    strs = Z_Malloc(n * sizeof(strs[0]));
+    map = HashMap_Create(const char *, uint32_t, HashStr, HashStrCmp);
+    for (i = 0; i < n; i++) {
+        Q_snprintf(names[i], sizeof(names[i]), "var_%d", i);
+        strs[i] = names[i];
+        HashMap_Insert(map, &strs[i], (uint32_t *)&i);
+    }
+
+    start = Sys_Microseconds();
+    for (j = 0; j < rounds; j++) {
+        for (i = 0; i < n; i++) {
+            val = HashMap_Lookup(uint32_t, map, &strs[i]);
+            if (!val || *val != i)
+                errors++;
+        }
+    }
+    t_str = Sys_Microseconds() - start;
+
+    HashMap_Destroy(map);
+    Z_Free(strs);
+    Z_Free(names);
+
+    Com_Printf("%d failures, %d keys, %d rounds\n", errors, n, rounds);
+    Com_Printf("insert %.1f, hit %.1f, miss %.1f, string %.1f, erase %.1f ns/op\n",
+               t_insert * 1e3 / n, t_hit * 1e3 / ((uint64_t)n * rounds),
+               t_miss * 1e3 / ((uint64_t)n * rounds), t_str * 1e3 / ((uint64_t)n * rounds),
+               t_erase * 1e3 / (n / 2 + 1));
+}
+
+// alias loop counter is normally reset each frame, but the benchmark runs
+// hundreds of aliases per frame
+static void test_cmd_exec(cmdbuf_t *buf, const char *line)
+{
+    buf->aliasCount = 0;
+    Cmd_ExecuteString(buf, line);
+}
+
+static void Com_TestCmdExec_f(void)
+{
+    static char text[0x8000];
+    cmdbuf_t buf = {
+        .from = FROM_CONSOLE,
+        .text = text,
+        .maxsize = sizeof(text),
+        .exec = test_cmd_exec,
+    };
+    char line[MAX_QPATH];
+    int i, j, lines, rounds;
+    uint64_t start, total = 0;
+
+    lines = Cmd_Argc() > 1 ? Q_clip(Q_atoi(Cmd_Argv(1)), 1, 1000000) : 10000;
+    rounds = Cmd_Argc() > 2 ? Q_clip(Q_atoi(Cmd_Argv(2)), 1, 1000) : 10;
+
+    for (j = 0; j < rounds; j++) {
+        start = Sys_Microseconds();
+        for (i = 0; i < lines; i++) {
+            switch (i % 5) {
+            case 0:
+                Q_snprintf(line, sizeof(line), "set _cb%d %d\n", i % 1000, i);
+                break;
+            case 1:
+                Q_snprintf(line, sizeof(line), "_cb%d %d\n", (i - 1) % 1000, j);
+                break;
+            case 2:
+                Q_snprintf(line, sizeof(line), "alias _cba%d \"_cb%d 1\"\n", i % 1000, (i - 2) % 1000);
+                break;
+            case 3:
+                Q_snprintf(line, sizeof(line), "_cba%d\n", (i - 1) % 1000);
+                break;
+            default:
+                Q_snprintf(line, sizeof(line), "if $_cb%d == 1 then set _cb%d 2\n", (i - 4) % 1000, (i - 4) % 1000);
+                break;
+            }
+            // flush in config sized chunks
+            if (strlen(line) > buf.maxsize - buf.cursize) {
+                Cbuf_Execute(&buf);
+                Cbuf_Frame(&buf);
+            }
+            Cbuf_AddText(&buf, line);
+        }
+        Cbuf_Execute(&buf);
+        Cbuf_Frame(&buf);
+        total += Sys_Microseconds() - start;
+    }
+
+    // only aliases actually defined
+    for (i = 2; i < min(lines, 1000); i += 5) {
+        Q_snprintf(line, sizeof(line), "unalias _cba%d", i);
+        Cmd_ExecuteString(&buf, line);
+    }
+
+    Com_Printf("%d lines, %d rounds, %.1f ns/line\n", lines, rounds,
+               total * 1e3 / ((uint64_t)lines * rounds));
+}
+
+#define DELTA_TEST_ENTS     128
+
+static uint32_t delta_test_seed;
+
+static uint32_t delta_test_rand(uint32_t n)
+{
+    delta_test_seed = delta_test_seed * 1664525 + 1013904223;
+    return (delta_test_seed >> 8) % n;
+}
+
+static void delta_test_move(entity_state_t *s)
+{
+    s->old_origin = s->origin;
+    if (delta_test_rand(2))
+        s->origin.x += delta_test_rand(16) - 8.0f;
+    if (delta_test_rand(2))
+        s->origin.y += delta_test_rand(16) - 8.0f;
+    if (!delta_test_rand(4))
+        s->origin.z += delta_test_rand(64) * 0.125f;
+    if (!delta_test_rand(4))
+        s->angles.y = delta_test_rand(360);
+    if (!delta_test_rand(3))
+        s->frame = delta_test_rand(200);
+    if (!delta_test_rand(16))
+        s->event[0] = delta_test_rand(32);
+    else
+        s->event[0] = 0;
+    if (!delta_test_rand(32))
+        s->effects ^= BIT(delta_test_rand(32));
+    if (!delta_test_rand(64))
+        s->old_origin.z += 1000;
+}
+
+static void Com_TestDelta_f(void)
+{
+    static entity_state_t ents[2][DELTA_TEST_ENTS];
+    player_state_t ps[2];
+    int i, j, frames, bytes = 0;
+    uint32_t hash = 0x811c9dc5;
+    uint64_t start, total = 0;
+
+    frames = Cmd_Argc() > 1 ? Q_clip(Q_atoi(Cmd_Argv(1)), 1, 1000000) : 10000;
+
+    // deterministic stream, so that output hash can be compared
+    delta_test_seed = 1;
+    memset(ents, 0, sizeof(ents));
+    memset(ps, 0, sizeof(ps));
+    for (i = 0; i < DELTA_TEST_ENTS; i++) {
+        ents[0][i].number = i + 1;
+        ents[0][i].modelindex = delta_test_rand(256);
+        ents[0][i].skinnum = delta_test_rand(4);
+        ents[0][i].alpha = 1.0f;
+    }
+
+    for (j = 0; j < frames; j++) {
+        const entity_state_t *from = ents[j & 1];
+        entity_state_t *to = ents[~j & 1];
+        const player_state_t *ps_from = &ps[j & 1];
+        player_state_t *ps_to = &ps[~j & 1];
+
+        for (i = 0; i < DELTA_TEST_ENTS; i++) {
+            to[i] = from[i];
+            delta_test_move(&to[i]);
+        }
+
+        *ps_to = *ps_from;
+        ps_to->origin.x += delta_test_rand(32) - 16.0f;
+        ps_to->velocity.x = delta_test_rand(640) - 320.0f;
+        ps_to->viewangles.y = delta_test_rand(3600) * 0.1f;
+        ps_to->gunframe = delta_test_rand(40);
+        if (!delta_test_rand(8))
+            ps_to->stats[delta_test_rand(MAX_STATS)] = delta_test_rand(1000);
+        if (!delta_test_rand(8))
+            ps_to->ammo[delta_test_rand(MAX_AMMO)] = delta_test_rand(200);
+
+        start = Sys_Microseconds();
+        for (i = 0; i < DELTA_TEST_ENTS; i++) {
+            if (!(i & 31))
+                MSG_BeginWriting();
+            MSG_WriteDeltaEntity(&from[i], &to[i], false);
+            if ((i & 31) == 31) {
+                MSG_FlushBits();
+                bytes += msg_write.cursize;
+                for (int k = 0; k < msg_write.cursize; k++)
+                    hash = (hash ^ msg_write.data[k]) * 0x01000193;
+            }
+        }
+        MSG_BeginWriting();
+        MSG_WriteDeltaPlayerstate(ps_from, ps_to);
+        MSG_FlushBits();
+        total += Sys_Microseconds() - start;
+
+        bytes += msg_write.cursize;
+        for (int k = 0; k < msg_write.cursize; k++)
+            hash = (hash ^ msg_write.data[k]) * 0x01000193;
+    }
+
+    SZ_Clear(&msg_write);
+
+    Com_Printf("%d frames, %d bytes, hash %08x, %.1f ns/entity\n", frames, bytes, hash,
+               total * 1e3 / ((uint64_t)frames * (DELTA_TEST_ENTS + 1)));
+}
+
+#define ZONE_TEST_BLOCKS    1024
+
+static void Com_TestZone_f(void)
+{
+    static byte *blocks[ZONE_TEST_BLOCKS];
+    static size_t sizes[ZONE_TEST_BLOCKS];
+    int i, j, k, count, errors = 0;
+
+    count = Cmd_Argc() > 1 ? Q_atoi(Cmd_Argv(1)) : 100000;
+
+    for (i = 0; i < count; i++) {
+        j = Q_rand_uniform(ZONE_TEST_BLOCKS);
+
+        if (blocks[j]) {
+            for (k = 0; k < sizes[j]; k++) {
+                if (blocks[j][k] != (byte)j) {
+                    errors++;
+                    break;
+                }
+            }
+        }
+
+        switch (Q_rand_uniform(3)) {
+        case 0:
+            Z_Free(blocks[j]);
+            blocks[j] = NULL;
+            sizes[j] = 0;
+            break;
+        case 1:
+            k = Q_rand_uniform(2048) + 1;
+            blocks[j] = Z_Realloc(blocks[j], k);
+            if (k > sizes[j]) {
+                memset(blocks[j] + sizes[j], j, k - sizes[j]);
+            }
+            sizes[j] = k;
+            break;
+        default:
+            Z_Free(blocks[j]);
+            sizes[j] = Q_rand_uniform(Q_rand() & 1 ? 64 : 1024) + 1;
+            blocks[j] = memset(Z_Malloc(sizes[j]), j, sizes[j]);
+            break;
+        }
+    }
+
+    for (i = 0; i < ZONE_TEST_BLOCKS; i++) {
+        Z_Free(blocks[i]);
+        blocks[i] = NULL;
+        sizes[i] = 0;
+    }
+
+    Com_Printf("%d failures, %d operations tested\n", errors, count);
+}
+
 #if USE_REF
 static void Com_TestModels_f(void)
 {
@@ -649,6 +967,48 @@ static void Com_TestSounds_f(void)
 
     FS_FreeList(list);
 }
+
+static int async_test_done;
+
+static void async_test_work(void *arg)
+{
+    Sys_Sleep(1);
+}
+
+static void async_test_complete(void *arg)
+{
+    async_test_done++;
+}
+
+static void Com_TestAsync_f(void)
+{
+    int i, count = Q_clip(Q_atoi(Cmd_Argv(1)), 1, 10000);
+    unsigned start, end;
+
+    if (Cmd_Argc() < 2)
+        count = 100;
+
+    async_test_done = 0;
+    start = Sys_Milliseconds();
+
+    for (i = 0; i < count; i++) {
+        asyncwork_t work = {
+            .work_cb = async_test_work,
+            .done_cb = async_test_complete,
+            .priority = i % ASYNC_PRIO_MAX,
+        };
+        Com_QueueAsyncWork(&work);
+    }
+
+    while (async_test_done < count && Sys_Milliseconds() - start < 10000) {
+        Sys_Sleep(1);
+        Com_CompleteAsyncWork();
+    }
+
+    end = Sys_Milliseconds();
+
+    Com_Printf("%d msec, %d of %d jobs completed\n", end - start, async_test_done, count);
+}
 #endif
 
 static const char *const mdfour_str[] = {
@@ -899,12 +1259,17 @@ static const cmdreg_t c_test[] = {
     { "normtest", Com_TestNorm_f },
     { "infotest", Com_TestInfo_f },
     { "snprintftest", Com_TestSnprintf_f },
+    { "zonetest", Com_TestZone_f },
+    { "hashmaptest", Com_TestHashMap_f },
+    { "cmdexectest", Com_TestCmdExec_f },
+    { "deltatest", Com_TestDelta_f },
 #if USE_REF
     { "modeltest", Com_TestModels_f },
     { "imagetest", Com_TestImages_f },
 #endif
 #if USE_CLIENT
     { "soundtest", Com_TestSounds_f },
+    { "asynctest", Com_TestAsync_f },
     { "activate", Com_Activate_f },
     { "utf8test", UTF8_Test_f },
 #endif
@@ -204,6 +204,21 @@ static const void *dispatch_table[] = {
     OP(I64_Extend8_s),
     OP(I64_Extend16_s),
     OP(I64_Extend32_s),
+
+    OP(F32_Sin),
+    OP(F32_Cos),
+    OP(F32_Tan),
+    OP(F32_Asin),
+    OP(F32_Acos),
+    OP(F32_Atan),
+    OP(F32_Atan2),
+    OP(F32_Pow),
+    OP(F32_Fmod),
+
+    OP(Memcmp),
+    OP(Strlen),
+    OP(Strcmp),
+    OP(Strncmp),
 };
 
 #undef OP
@@ -665,6 +665,92 @@ void VM_Interpret(vm_t *m)
     SEX_OP(I64_Extend8_s,  i64,  8)
     SEX_OP(I64_Extend16_s, i64, 16)
     SEX_OP(I64_Extend32_s, i64, 32)
+
+    // intrinsics
+    UN_OP(F32_Sin,  f32, sinf)
+    UN_OP(F32_Cos,  f32, cosf)
+    UN_OP(F32_Tan,  f32, tanf)
+    UN_OP(F32_Asin, f32, asinf)
+    UN_OP(F32_Acos, f32, acosf)
+    UN_OP(F32_Atan, f32, atanf)
+
+    BOP_F32(F32_Atan2, atan2f(a, b))
+    BOP_F32(F32_Pow,   powf(a, b))
+    BOP_F32(F32_Fmod,  fmodf(a, b))
+
+    // memory is followed by zero padding, so strings are always terminated
+    do_Memcmp:
+        fetch_op;
+        have(3);
+        dst = stack[cur_sp - 2].u32;
+        src = stack[cur_sp - 1].u32;
+        n   = stack[cur_sp    ].u32;
+        VM_ASSERT((uint64_t)dst + n <= msize &&
+                  (uint64_t)src + n <= msize, "Memory compare out of bounds");
+        cur_sp -= 2;
+        stack[cur_sp].i32 = memcmp(m->memory.bytes + dst, m->memory.bytes + src, n);
+        dispatch_op;
+
+    do_Strlen:
+        fetch_op;
+        have(1);
+        src = stack[cur_sp].u32;
+        VM_ASSERT(src && src < msize, "Out of bounds VM pointer");
+        stack[cur_sp].u32 = strlen((const char *)m->memory.bytes + src);
+        dispatch_op;
+
+    do_Strcmp:
+        fetch_op;
+        have(2);
+        dst = stack[cur_sp - 1].u32;
+        src = stack[cur_sp    ].u32;
+        VM_ASSERT(dst && dst < msize && src && src < msize, "Out of bounds VM pointer");
+        cur_sp -= 1;
+        stack[cur_sp].i32 = strcmp((const char *)m->memory.bytes + dst,
+                                   (const char *)m->memory.bytes + src);
+        dispatch_op;
+
+    do_Strncmp:
+        fetch_op;
+        have(3);
+        dst = stack[cur_sp - 2].u32;
+        src = stack[cur_sp - 1].u32;
+        n   = stack[cur_sp    ].u32;
+        VM_ASSERT(dst && dst < msize && src && src < msize, "Out of bounds VM pointer");
+        cur_sp -= 2;
+        stack[cur_sp].i32 = strncmp((const char *)m->memory.bytes + dst,
+                                    (const char *)m->memory.bytes + src, n);
+        dispatch_op;
+}
+
+static const struct {
+    const char  *name;
+    vm_opcode_t  opcode;
+} intrinsics[] = {
+    { "sinf",       OP_F32_Sin },
+    { "cosf",       OP_F32_Cos },
+    { "tanf",       OP_F32_Tan },
+    { "asinf",      OP_F32_Asin },
+    { "acosf",      OP_F32_Acos },
+    { "atanf",      OP_F32_Atan },
+    { "atan2f",     OP_F32_Atan2 },
+    { "powf",       OP_F32_Pow },
+    { "fmodf",      OP_F32_Fmod },
+    { "memcmp",     OP_Memcmp },
+    { "strlen",     OP_Strlen },
+    { "strcmp",     OP_Strcmp },
+    { "strncmp",    OP_Strncmp },
+};
+
+// Returns interpreter opcode that replaces calls to the given stdlib import,
+// or OP_Unreachable if there is none.
+vm_opcode_t VM_GetIntrinsic(const char *name)
+{
+    for (int i = 0; i < q_countof(intrinsics); i++)
+        if (!strcmp(intrinsics[i].name, name))
+            return intrinsics[i].opcode;
+
+    return OP_Unreachable;
 }
 
 static vm_opcode_t extended_opcode(wa_extended_opcode_t opcode)
@@ -837,6 +923,10 @@ static int VM_PrepareFunction(vm_t *m, vm_block_t *func, uint32_t func_end_addr,
         case Call:
             index = SZ_ReadLeb(in);
             ASSERT(index < m->num_funcs, "Bad function index");
+            if (index < m->num_imports && m->funcs[index].opcode != OP_Unreachable) {
+                put_u8(out, m->funcs[index].opcode);   // inline intrinsic
+                break;
+            }
             put_u8(out, OP_Call);
             put_u16(out, index);
             break;
@@ -96,6 +96,7 @@ static bool vm_type_eq(const vm_type_t *type, const char *s)
 static bool import_function(vm_t *m, bstr_t module, bstr_t name, const vm_type_t *type)
 {
     const vm_import_t *import;
+    vm_opcode_t intrinsic = OP_Unreachable;
 
     ASSERT(Bstr_IsEqualStr(module, "env"), "Unknown import module %.*s", (int)module.len, module.str);
 
@@ -103,10 +104,13 @@ static bool import_function(vm_t *m, bstr_t module, bstr_t name, const vm_type_t
         if (Bstr_IsEqualStr(name, import->name))
             break;
 
-    if (!import->name)
+    if (!import->name) {
         for (import = vm_stdlib; import->name; import++)
             if (Bstr_IsEqualStr(name, import->name))
                 break;
+        if (import->name)
+            intrinsic = VM_GetIntrinsic(import->name);
+    }
 
     ASSERT(import->name, "Import %.*s not found", (int)name.len, name.str);
 
@@ -118,6 +122,7 @@ static bool import_function(vm_t *m, bstr_t module, bstr_t name, const vm_type_t
     m->funcs = VM_Realloc(m->funcs, m->num_imports * sizeof(m->funcs[0]));
 
     vm_block_t *func = &m->funcs[m->num_imports - 1];
+    func->opcode = intrinsic;
     func->type = type;
     func->thunk = import->thunk;
     return true;
@@ -399,4 +399,20 @@ typedef enum {
     OP_I64_Extend8_s,
     OP_I64_Extend16_s,
     OP_I64_Extend32_s,
+
+    // Intrinsics for hot stdlib imports
+    OP_F32_Sin,
+    OP_F32_Cos,
+    OP_F32_Tan,
+    OP_F32_Asin,
+    OP_F32_Acos,
+    OP_F32_Atan,
+    OP_F32_Atan2,
+    OP_F32_Pow,
+    OP_F32_Fmod,
+
+    OP_Memcmp,
+    OP_Strlen,
+    OP_Strcmp,
+    OP_Strncmp,
 } vm_opcode_t;
@@ -78,6 +78,18 @@ VM_THUNK(memcmp) {
     VM_I32(0) = memcmp(m->bytes + p1, m->bytes + p2, size);
 }
 
+VM_THUNK(strlen) {
+    VM_U32(0) = strlen(VM_STR(0));
+}
+
+VM_THUNK(strcmp) {
+    VM_I32(0) = strcmp(VM_STR(0), VM_STR(1));
+}
+
+VM_THUNK(strncmp) {
+    VM_I32(0) = strncmp(VM_STR(0), VM_STR(1), VM_U32(2));
+}
+
 // Varargs WASM functions pass implicit va_list as the last argument, which is
 // a pointer to array of I32/I64 params on shadow stack. snprintf and vsnprintf
 // signatures are thus equivalent.
@@ -165,6 +177,9 @@ const vm_import_t vm_stdlib[] = {
     VM_IMPORT_RAW(log10f, "f f"),
     VM_IMPORT_RAW(fmodf, "f ff"),
     VM_IMPORT_RAW(memcmp, "i iii"),
+    VM_IMPORT_RAW(strlen, "i i"),
+    VM_IMPORT_RAW(strcmp, "i ii"),
+    VM_IMPORT_RAW(strncmp, "i iii"),
     VM_IMPORT_RAW(snprintf, "i iiii"),
     VM_IMPORT_RAW(sprintf, "i iii"),
     VM_IMPORT_RAW(strtof, "f ii"),
@@ -74,6 +74,7 @@ typedef struct {
 // A block or function
 typedef struct {
     uint32_t   opcode;          // 0x00: function, 0x02: block, 0x03: loop, 0x04: if
+                                // imported function: intrinsic opcode, OP_Unreachable if none
     uint32_t   num_locals;      // function only
     union {
         uint32_t  *locals;      // function only
@@ -149,4 +150,5 @@ extern const vm_import_t vm_stdlib[];
 void VM_SetupCall(vm_t *m, uint32_t fidx);
 void VM_Interpret(vm_t *m);
 const vm_type_t *VM_GetBlockType(uint32_t value_type);
+vm_opcode_t VM_GetIntrinsic(const char *name);
 bool VM_PrepareInterpreter(vm_t *m, sizebuf_t *sz);
@@ -23,29 +23,78 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #define Z_MAGIC     0x1d0d
 
-typedef struct {
+/*
+Small blocks are carved from fixed size slabs owned by per-tag arenas.
+Freeing a tag drops the slabs wholesale. Large blocks still come from
+the heap and are linked into the per-tag chain for leak tracking.
+*/
+
+#define Z_SLAB_SIZE     0x2000
+#define Z_NUM_CLASSES   9
+#define Z_CLASS_SHIFT   5
+#define Z_MAX_SMALL     1024
+
+typedef struct zhead_s {
     uint16_t        magic;
     uint16_t        tag;        // for group free
+    uint16_t        cls;        // size class + 1, 0 if from heap
     size_t          size;
-    list_t          entry;
+    union {
+        list_t          entry;  // heap block: link in tag chain
+        struct zslab_s  *slab;  // slab block: owning slab
+        struct zhead_s  *next;  // free slab block
+    };
 } zhead_t;
 
+typedef struct zslab_s {
+    list_t      entry;      // all slabs of this arena
+    list_t      avail;      // slabs of this class with free blocks
+    zhead_t     *free;
+    uint16_t    tag;
+    uint16_t    cls;
+    int         used;
+    int         capacity;
+    size_t      bytes;
+    int         bumped;     // blocks handed out at least once
+} zslab_t;
+
+#define Z_SLAB_HEADER   Q_ALIGN(sizeof(zslab_t), 32)
+
 typedef struct {
-    zhead_t     z;
-    char        data[2];
-} zstatic_t;
+    list_t      chain;      // heap blocks
+    list_t      slabs;
+    list_t      avail[Z_NUM_CLASSES];
+} zarena_t;
 
 typedef struct {
     size_t      count;
     size_t      bytes;
 } zstats_t;
 
-static list_t       z_chain;
+typedef struct {
+    size_t      slabs;
+    size_t      used;
+    size_t      bytes;      // requested bytes in used blocks
+    size_t      peak_slabs;
+} zclass_t;
+
+static zarena_t     z_arenas[TAG_MAX];
 static zstats_t     z_stats[TAG_MAX];
+static zclass_t     z_classes[Z_NUM_CLASSES];
+static uint8_t      z_classmap[Z_MAX_SMALL >> Z_CLASS_SHIFT];
+
+static const uint16_t z_classsizes[Z_NUM_CLASSES] = {
+    64, 96, 128, 192, 256, 384, 512, 768, 1024
+};
 
 #define S(d) \
     { .z = { .magic = Z_MAGIC, .tag = TAG_STATIC, .size = sizeof(zstatic_t) }, .data = d }
 
+typedef struct {
+    zhead_t     z;
+    char        data[2];
+} zstatic_t;
+
 static const zstatic_t z_static[11] = {
     S("0"), S("1"), S("2"), S("3"), S("4"), S("5"), S("6"), S("7"), S("8"), S("9"), S("")
 };
@@ -88,16 +137,110 @@ static inline void Z_CountAlloc(const zhead_t *z)
 #define Z_Validate(z) \
     Q_assert((z)->magic == Z_MAGIC && (z)->tag != TAG_FREE)
 
-void Z_LeakTest(memtag_t tag)
+static void Z_FreeSlab(zslab_t *slab)
+{
+    zclass_t *c = &z_classes[slab->cls];
+
+    c->slabs--;
+    List_Remove(&slab->entry);
+    List_Remove(&slab->avail);
+    free(slab);
+}
+
+static zhead_t *Z_SlabAlloc(size_t size, memtag_t tag)
 {
+    int cls = z_classmap[(size - 1) >> Z_CLASS_SHIFT];
+    zarena_t *arena = &z_arenas[tag];
+    list_t *avail = &arena->avail[cls];
+    zclass_t *c = &z_classes[cls];
+    zslab_t *slab;
     zhead_t *z;
+
+    if (LIST_EMPTY(avail)) {
+        slab = malloc(Z_SLAB_SIZE);
+        if (!slab) {
+            Com_Error(ERR_FATAL, "%s: couldn't allocate %d bytes", __func__, Z_SLAB_SIZE);
+        }
+        slab->free = NULL;
+        slab->tag = tag;
+        slab->cls = cls;
+        slab->used = 0;
+        slab->bytes = 0;
+        slab->capacity = (Z_SLAB_SIZE - Z_SLAB_HEADER) / z_classsizes[cls];
+        slab->bumped = 0;
+        List_Append(&arena->slabs, &slab->entry);
+        List_Append(avail, &slab->avail);
+        c->slabs++;
+        c->peak_slabs = max(c->peak_slabs, c->slabs);
+    } else {
+        slab = LIST_FIRST(zslab_t, avail, avail);
+    }
+
+    if (slab->free) {
+        z = slab->free;
+        slab->free = z->next;
+    } else {
+        z = (zhead_t *)((byte *)slab + Z_SLAB_HEADER + slab->bumped * z_classsizes[cls]);
+        slab->bumped++;
+    }
+
+    if (++slab->used == slab->capacity) {
+        List_Delete(&slab->avail);
+    }
+
+    z->cls = cls + 1;
+    z->slab = slab;
+
+    slab->bytes += size;
+    c->used++;
+    c->bytes += size;
+
+    return z;
+}
+
+static void Z_SlabFree(zhead_t *z)
+{
+    zslab_t *slab = z->slab;
+    zarena_t *arena = &z_arenas[slab->tag];
+    list_t *avail = &arena->avail[slab->cls];
+    zclass_t *c = &z_classes[slab->cls];
+
+    slab->bytes -= z->size;
+    c->used--;
+    c->bytes -= z->size;
+
+    if (slab->used-- == slab->capacity) {
+        List_Insert(avail, &slab->avail);
+    }
+
+    // keep one empty slab around to avoid thrashing
+    if (!slab->used && !LIST_SINGLE(avail)) {
+        Z_FreeSlab(slab);
+        return;
+    }
+
+    z->magic = 0xdead;
+    z->tag = TAG_FREE;
+    z->next = slab->free;
+    slab->free = z;
+}
+
+void Z_LeakTest(memtag_t tag)
+{
     size_t numLeaks = 0, numBytes = 0;
+    zhead_t *z;
 
-    LIST_FOR_EACH(z, &z_chain, entry) {
-        Z_Validate(z);
-        if (z->tag == tag || (tag == TAG_FREE && z->tag >= TAG_MAX)) {
-            numLeaks++;
-            numBytes += z->size;
+    // slab blocks are only tracked in aggregate
+    if (tag > TAG_STATIC && tag < TAG_MAX) {
+        numLeaks = z_stats[tag].count;
+        numBytes = z_stats[tag].bytes;
+    } else {
+        LIST_FOR_EACH(z, &z_arenas[TAG_INDEX(tag)].chain, entry) {
+            Z_Validate(z);
+            if (z->tag == tag || (tag == TAG_FREE && z->tag >= TAG_MAX)) {
+                numLeaks++;
+                numBytes += z->size;
+            }
         }
     }
 
@@ -129,12 +272,19 @@ void Z_Free(void *ptr)
 
     Z_CountFree(z);
 
-    if (z->tag != TAG_STATIC) {
-        List_Remove(&z->entry);
-        z->magic = 0xdead;
-        z->tag = TAG_FREE;
-        free(z);
+    if (z->tag == TAG_STATIC) {
+        return;
+    }
+
+    if (z->cls) {
+        Z_SlabFree(z);
+        return;
     }
+
+    List_Remove(&z->entry);
+    z->magic = 0xdead;
+    z->tag = TAG_FREE;
+    free(z);
 }
 
 /*
@@ -160,8 +310,9 @@ Z_Stats_f
 */
 void Z_Stats_f(void)
 {
-    size_t bytes = 0, count = 0;
+    size_t bytes = 0, count = 0, slabs = 0, slack = 0;
     zstats_t *s;
+    zclass_t *c;
     int i;
 
     Com_Printf("    bytes blocks name\n"
@@ -177,8 +328,29 @@ void Z_Stats_f(void)
     }
 
     Com_Printf("--------- ------ -------\n"
-               "%9zu %6zu total\n",
+               "%9zu %6zu total\n\n",
                bytes, count);
+
+    Com_Printf("class  slabs  peak   used  total  frag\n"
+               "----- ------ ----- ------ ------ -----\n");
+
+    for (i = 0, c = z_classes; i < Z_NUM_CLASSES; i++, c++) {
+        size_t total = c->slabs * ((Z_SLAB_SIZE - Z_SLAB_HEADER) / z_classsizes[i]);
+        size_t waste = c->slabs * Z_SLAB_SIZE - c->bytes;
+
+        if (!c->peak_slabs) {
+            continue;
+        }
+        Com_Printf("%5d %6zu %5zu %6zu %6zu %4zu%%\n", z_classsizes[i],
+                   c->slabs, c->peak_slabs, c->used, total,
+                   c->slabs ? waste * 100 / (c->slabs * Z_SLAB_SIZE) : 0);
+        slabs += c->slabs;
+        slack += waste;
+    }
+
+    Com_Printf("----- ------ ----- ------ ------ -----\n"
+               "%zu bytes in %zu slabs, %zu bytes unused\n",
+               slabs * Z_SLAB_SIZE, slabs, slack);
 }
 
 /*
@@ -188,14 +360,36 @@ Z_FreeTags
 */
 void Z_FreeTags(memtag_t tag)
 {
+    zarena_t *arena = &z_arenas[TAG_INDEX(tag)];
+    zslab_t *slab, *next;
     zhead_t *z, *n;
+    int i;
 
-    LIST_FOR_EACH_SAFE(z, n, &z_chain, entry) {
+    LIST_FOR_EACH_SAFE(z, n, &arena->chain, entry) {
         Z_Validate(z);
         if (z->tag == tag) {
             Z_Free(z + 1);
         }
     }
+
+    if (tag <= TAG_STATIC || tag >= TAG_MAX) {
+        return;
+    }
+
+    // heap blocks are gone, so whatever is left belongs to slabs
+    LIST_FOR_EACH_SAFE(slab, next, &arena->slabs, entry) {
+        zclass_t *c = &z_classes[slab->cls];
+        c->used -= slab->used;
+        c->bytes -= slab->bytes;
+        Z_FreeSlab(slab);
+    }
+
+    for (i = 0; i < Z_NUM_CLASSES; i++) {
+        Q_assert(LIST_EMPTY(&arena->avail[i]));
+    }
+
+    z_stats[tag].count = 0;
+    z_stats[tag].bytes = 0;
 }
 
 /*
@@ -215,16 +409,23 @@ static void *Z_TagMallocInternal(size_t size, memtag_t tag, bool init)
     Q_assert(tag > TAG_FREE && tag <= UINT16_MAX);
 
     size += sizeof(*z);
-    z = init ? calloc(1, size) : malloc(size);
-    if (!z) {
-        Com_Error(ERR_FATAL, "%s: couldn't allocate %zu bytes", __func__, size);
+    if (size <= Z_MAX_SMALL && tag > TAG_STATIC && tag < TAG_MAX) {
+        z = Z_SlabAlloc(size, tag);
+        if (init) {
+            memset(z + 1, 0, size - sizeof(*z));
+        }
+    } else {
+        z = init ? calloc(1, size) : malloc(size);
+        if (!z) {
+            Com_Error(ERR_FATAL, "%s: couldn't allocate %zu bytes", __func__, size);
+        }
+        z->cls = 0;
+        List_Insert(&z_arenas[TAG_INDEX(tag)].chain, &z->entry);
     }
     z->magic = Z_MAGIC;
     z->tag = tag;
     z->size = size;
 
-    List_Insert(&z_chain, &z->entry);
-
 #if USE_TESTS
     if (!init && z_perturb && z_perturb->integer) {
         memset(z + 1, z_perturb->integer, size - sizeof(*z));
@@ -287,6 +488,32 @@ static void *Z_TagReallocInternal(void *ptr, size_t size, memtag_t tag, bool ini
 
     Q_assert(z->tag != TAG_STATIC);
 
+    if (z->cls) {
+        zclass_t *c = &z_classes[z->cls - 1];
+        void *ptr;
+
+        // still fits in the same block
+        if (size <= z_classsizes[z->cls - 1] && size > z_classsizes[z->cls - 1] / 2) {
+            Z_CountFree(z);
+            z->slab->bytes += size - z->size;
+            c->bytes += size - z->size;
+            if (init && size > z->size) {
+                memset((byte *)z + z->size, 0, size - z->size);
+            }
+            z->size = size;
+            Z_CountAlloc(z);
+            return z + 1;
+        }
+
+        ptr = Z_TagMallocInternal(size - sizeof(*z), z->tag, false);
+        memcpy(ptr, z + 1, min(size, z->size) - sizeof(*z));
+        if (init && size > z->size) {
+            memset((byte *)ptr + z->size - sizeof(*z), 0, size - z->size);
+        }
+        Z_Free(z + 1);
+        return ptr;
+    }
+
     Z_CountFree(z);
 
     z = realloc(z, size);
@@ -334,7 +561,22 @@ Z_Init
 */
 void Z_Init(void)
 {
-    List_Init(&z_chain);
+    int i, j;
+
+    for (i = 0; i < TAG_MAX; i++) {
+        List_Init(&z_arenas[i].chain);
+        List_Init(&z_arenas[i].slabs);
+        for (j = 0; j < Z_NUM_CLASSES; j++) {
+            List_Init(&z_arenas[i].avail[j]);
+        }
+    }
+
+    for (i = j = 0; i < q_countof(z_classmap); i++) {
+        while (z_classsizes[j] < (i + 1) << Z_CLASS_SHIFT) {
+            j++;
+        }
+        z_classmap[i] = j;
+    }
 }
 
 /*
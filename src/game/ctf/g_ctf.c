@@ -725,7 +725,7 @@ void CTFDeadDropFlag(edict_t *self)
 
     if (dropped) {
         dropped->think = CTFDropFlagThink;
-        dropped->nextthink = level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT;
+        G_SetNextThink(dropped, level.time + CTF_AUTO_FLAG_RETURN_TIMEOUT);
         dropped->touch = CTFDropFlagTouch;
     }
 }
@@ -742,7 +742,7 @@ void THINK(CTFFlagThink)(edict_t *ent)
 {
     if (ent->r.solid != SOLID_NOT)
         ent->s.frame = 173 + (((ent->s.frame - 173) + 1) % 16);
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 void THINK(CTFFlagSetup)(edict_t *ent)
@@ -776,7 +776,7 @@ void THINK(CTFFlagSetup)(edict_t *ent)
 
     trap_LinkEntity(ent);
 
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->think = CTFFlagThink;
 }
 
@@ -1200,7 +1200,7 @@ static void CTFGrappleDrawCable(edict_t *self)
 
     te->s.old_origin = G_SnapVector(aim.start);
     te->s.origin = G_SnapVector(self->s.origin);
-    te->nextthink = level.time + SEC(0.2f);
+    G_SetNextThink(te, level.time + SEC(0.2f));
     trap_LinkEntity(te);
 }
 
@@ -1765,7 +1765,7 @@ void THINK(TechThink)(edict_t *tech)
         SpawnTech(tech->item, spot);
         G_FreeEdict(tech);
     } else {
-        tech->nextthink = level.time + CTF_TECH_TIMEOUT;
+        G_SetNextThink(tech, level.time + CTF_TECH_TIMEOUT);
         tech->think = TechThink;
     }
 }
@@ -1775,7 +1775,7 @@ void CTFDrop_Tech(edict_t *ent, const gitem_t *item)
     edict_t *tech;
 
     tech = Drop_Item(ent, item);
-    tech->nextthink = level.time + CTF_TECH_TIMEOUT;
+    G_SetNextThink(tech, level.time + CTF_TECH_TIMEOUT);
     tech->think = TechThink;
     ent->client->pers.inventory[item->id] = 0;
 }
@@ -1790,7 +1790,7 @@ void CTFDeadDropTech(edict_t *ent)
             // hack the velocity to make it bounce random
             dropped->velocity.x = crandom_open() * 300;
             dropped->velocity.y = crandom_open() * 300;
-            dropped->nextthink = level.time + CTF_TECH_TIMEOUT;
+            G_SetNextThink(dropped, level.time + CTF_TECH_TIMEOUT);
             dropped->think = TechThink;
             dropped->r.ownernum = ENTITYNUM_NONE;
             ent->client->pers.inventory[tech_ids[i]] = 0;
@@ -1828,7 +1828,7 @@ static void SpawnTech(const gitem_t *item, edict_t *spot)
     ent->velocity = Vec3_Scale(forward, 100);
     ent->velocity.z = 300;
 
-    ent->nextthink = level.time + CTF_TECH_TIMEOUT;
+    G_SetNextThink(ent, level.time + CTF_TECH_TIMEOUT);
     ent->think = TechThink;
 
     trap_LinkEntity(ent);
@@ -1871,7 +1871,7 @@ void CTFSetupTechSpawn(void)
         return;
 
     ent = G_Spawn();
-    ent->nextthink = level.time + SEC(2);
+    G_SetNextThink(ent, level.time + SEC(2));
     ent->think = SpawnTechs;
 }
 
@@ -2026,7 +2026,7 @@ The banner is 248 tall.
 void THINK(misc_ctf_banner_think)(edict_t *ent)
 {
     ent->s.frame = (ent->s.frame + 1) % 16;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 #define SPAWNFLAG_CTF_BANNER_BLUE   1
@@ -2043,7 +2043,7 @@ void SP_misc_ctf_banner(edict_t *ent)
     trap_LinkEntity(ent);
 
     ent->think = misc_ctf_banner_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 /*QUAKED misc_ctf_small_banner (1 .5 0) (-4 -32 0) (4 32 124) TEAM2
@@ -2062,7 +2062,7 @@ void SP_misc_ctf_small_banner(edict_t *ent)
     trap_LinkEntity(ent);
 
     ent->think = misc_ctf_banner_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 /*-----------------------------------------------------------------------*/
@@ -2168,7 +2168,7 @@ static void CTFResetAllPlayers(void)
         ent = g_edicts + i;
         if (ent->r.inuse && ent->r.solid == SOLID_NOT &&
             ent->think == DoRespawn && ent->nextthink >= level.time) {
-            ent->nextthink = 0;
+            G_SetNextThink(ent, 0);
             DoRespawn(ent);
         }
     }
@@ -347,6 +347,118 @@ float range_to(edict_t *self, edict_t *other)
     return Box3_Distance(self->r.absbox, other->r.absbox);
 }
 
+/*
+==============================================================================
+
+SIGHT CACHE
+
+Sight traces only hit world and brush models, so the result doesn't depend
+on which monster is looking. Results are cached for the current frame keyed
+by eye position snapped to a small grid, target entity and mask, so monsters
+standing close to each other (or the same monster asking several times)
+share one trace. Eye positions that are not in each other's PVS are rejected
+without tracing.
+
+==============================================================================
+*/
+
+#define SIGHT_CACHE_SIZE    256     // must be power of 2
+#define SIGHT_GRID_SHIFT    3       // 8 units
+
+typedef struct {
+    gtime_t     time;
+    int         cell[3];
+    int         target;
+    contents_t  mask;
+    vec3_t      spot;
+    bool        visible;
+} sight_entry_t;
+
+typedef struct {
+    unsigned    checks;
+    unsigned    hits;
+    unsigned    pvs_rejects;
+    unsigned    traces;
+} sight_stats_t;
+
+static sight_entry_t    sight_cache[SIGHT_CACHE_SIZE];
+static sight_stats_t    sight_frame, sight_last, sight_total;
+static gtime_t          sight_time;
+
+static void G_AddSightStats(sight_stats_t *out, const sight_stats_t *in)
+{
+    out->checks += in->checks;
+    out->hits += in->hits;
+    out->pvs_rejects += in->pvs_rejects;
+    out->traces += in->traces;
+}
+
+static bool G_SightTrace(edict_t *self, edict_t *other, vec3_t spot1, vec3_t spot2, contents_t mask)
+{
+    sight_entry_t *e;
+    int cell[3];
+    unsigned hash;
+    bool result;
+
+    if (sight_time != level.time) {
+        // time went backwards after map change or loadgame
+        if (level.time < sight_time)
+            memset(sight_cache, 0, sizeof(sight_cache));
+        G_AddSightStats(&sight_total, &sight_frame);
+        sight_last = sight_frame;
+        memset(&sight_frame, 0, sizeof(sight_frame));
+        sight_time = level.time;
+    }
+
+    sight_frame.checks++;
+
+    for (int i = 0; i < 3; i++)
+        cell[i] = (int)floorf(spot1.xyz[i]) >> SIGHT_GRID_SHIFT;
+
+    hash = cell[0] * 73856093U ^ cell[1] * 19349663U ^ cell[2] * 83492791U;
+    hash ^= other->s.number * 2654435761U ^ mask;
+    e = &sight_cache[hash & (SIGHT_CACHE_SIZE - 1)];
+
+    if (e->time == level.time && e->target == other->s.number && e->mask == mask &&
+        e->cell[0] == cell[0] && e->cell[1] == cell[1] && e->cell[2] == cell[2] &&
+        Vec3_IsEqual(e->spot, spot2)) {
+        sight_frame.hits++;
+        return e->visible;
+    }
+
+    if (!trap_InVis(spot1, spot2, VIS_PVS)) {
+        sight_frame.pvs_rejects++;
+        result = false;
+    } else {
+        trace_t trace = G_TraceLine(spot1, spot2, self->s.number, mask);
+        sight_frame.traces++;
+        result = trace.fraction == 1.0f || trace.entnum == other->s.number; // PGM
+    }
+
+    e->time = level.time;
+    e->cell[0] = cell[0];
+    e->cell[1] = cell[1];
+    e->cell[2] = cell[2];
+    e->target = other->s.number;
+    e->mask = mask;
+    e->spot = spot2;
+    e->visible = result;
+
+    return result;
+}
+
+void G_SightInfo_f(void)
+{
+    sight_stats_t total = sight_total;
+
+    G_AddSightStats(&total, &sight_frame);
+
+    G_Printf("last frame: %u checks, %u cached, %u PVS rejects, %u traces\n",
+             sight_last.checks, sight_last.hits, sight_last.pvs_rejects, sight_last.traces);
+    G_Printf("total: %u checks, %u cached, %u PVS rejects, %u traces\n",
+             total.checks, total.hits, total.pvs_rejects, total.traces);
+}
+
 /*
 =============
 visible
@@ -384,7 +496,6 @@ bool visible_ex(edict_t *self, edict_t *other, bool through_glass)
 
     vec3_t  spot1;
     vec3_t  spot2;
-    trace_t trace;
 
     spot1 = self->s.origin;
     spot1.z += self->viewheight;
@@ -396,8 +507,7 @@ bool visible_ex(edict_t *self, edict_t *other, bool through_glass)
     if (!through_glass)
         mask |= CONTENTS_WINDOW;
 
-    trace = G_TraceLine(spot1, spot2, self->s.number, mask);
-    return trace.fraction == 1.0f || trace.entnum == other->s.number; // PGM
+    return G_SightTrace(self, other, spot1, spot2, mask);
 }
 
 /*
@@ -386,7 +386,7 @@ static void Cmd_Spawn_f(edict_t *ent, cmdflags_t flags)
     trap_LinkEntity(ent);
 
     edict_t *other = G_Spawn();
-    other->classname = G_CopyString(buf);
+    other->classname = G_PoolCopyString(buf);
 
     vec3_t forward;
     AngleVectors(ent->client->v_angle, &forward, NULL, NULL);
@@ -64,6 +64,7 @@ static void Killed(edict_t *targ, edict_t *inflictor, edict_t *attacker, int dam
     if (targ->r.svflags & SVF_MONSTER)
         return;
 
+    G_WakeEntity(targ);
     targ->die(targ, inflictor, attacker, damage, point, mod);
 
     if (targ->monsterinfo.setskin)
@@ -656,8 +657,10 @@ void T_Damage(edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir,
 
         if (targ->monsterinfo.setskin)
             targ->monsterinfo.setskin(targ);
-    } else if (take && targ->pain)
+    } else if (take && targ->pain) {
+        G_WakeEntity(targ);
         targ->pain(targ, attacker, knockback, take, mod);
+    }
 
     // add to the damage inflicted on a player this frame
     // the total will be turned into screen blends and view angle kicks
@@ -119,7 +119,7 @@ void THINK(Move_Final)(edict_t *ent)
     ent->velocity = Vec3_Scale(dir, 1.0f / FRAME_TIME_SEC);
 
     ent->think = Move_Done;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 }
 
 void THINK(Move_Begin)(edict_t *ent)
@@ -133,7 +133,7 @@ void THINK(Move_Begin)(edict_t *ent)
     ent->velocity = Vec3_Scale(ent->moveinfo.dir, ent->moveinfo.speed);
     frames = floorf((ent->moveinfo.remaining_distance / ent->moveinfo.speed) / FRAME_TIME_SEC);
     ent->moveinfo.remaining_distance -= frames * ent->moveinfo.speed * FRAME_TIME_SEC;
-    ent->nextthink = level.time + (FRAME_TIME * frames);
+    G_SetNextThink(ent, level.time + (FRAME_TIME * frames));
     ent->think = Move_Final;
 }
 
@@ -151,14 +151,14 @@ void Move_Calc(edict_t *ent, vec3_t dest, void (*endfunc)(edict_t *self))
         if (level.current_entity == ((ent->flags & FL_TEAMSLAVE) ? ent->teammaster : ent)) {
             Move_Begin(ent);
         } else {
-            ent->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(ent, level.time + FRAME_TIME);
             ent->think = Move_Begin;
         }
     } else {
         // accelerative
         ent->moveinfo.current_speed = 0;
         ent->think = Think_AccelMove;
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
     }
 }
 
@@ -194,7 +194,7 @@ void THINK(AngleMove_Final)(edict_t *ent)
     ent->avelocity = Vec3_Scale(move, 1.0f / FRAME_TIME_SEC);
 
     ent->think = AngleMove_Done;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 }
 
 void THINK(AngleMove_Begin)(edict_t *ent)
@@ -236,10 +236,10 @@ void THINK(AngleMove_Begin)(edict_t *ent)
     //  if we're done accelerating, act as a normal rotation
     if (ent->moveinfo.speed >= ent->speed) {
         // set nextthink to trigger a think when dest is reached
-        ent->nextthink = level.time + (FRAME_TIME * frames);
+        G_SetNextThink(ent, level.time + (FRAME_TIME * frames));
         ent->think = AngleMove_Final;
     } else {
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
         ent->think = AngleMove_Begin;
     }
     // PGM
@@ -259,7 +259,7 @@ static void AngleMove_Calc(edict_t *ent, void (*endfunc)(edict_t *self))
     if (level.current_entity == ((ent->flags & FL_TEAMSLAVE) ? ent->teammaster : ent)) {
         AngleMove_Begin(ent);
     } else {
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
         ent->think = AngleMove_Begin;
     }
 }
@@ -404,7 +404,7 @@ void THINK(Think_AccelMove)(edict_t *ent)
     }
 
     ent->velocity = Vec3_Scale(ent->moveinfo.dir, ent->moveinfo.current_speed * TICK_RATE);
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->think = Think_AccelMove;
 }
 
@@ -419,7 +419,7 @@ void MOVEINFO_ENDFUNC(plat_hit_top)(edict_t *ent)
     ent->moveinfo.state = STATE_TOP;
 
     ent->think = plat_go_down;
-    ent->nextthink = level.time + SEC(3);
+    G_SetNextThink(ent, level.time + SEC(3));
 }
 
 void MOVEINFO_ENDFUNC(plat_hit_bottom)(edict_t *ent)
@@ -525,7 +525,7 @@ void TOUCH(Touch_Plat_Center)(edict_t *ent, edict_t *other, const trace_t *tr, b
     if (ent->moveinfo.state == STATE_BOTTOM)
         plat_go_up(ent);
     else if (ent->moveinfo.state == STATE_TOP)
-        ent->nextthink = level.time + SEC(1); // the player is still on the plat, so delay going down
+        G_SetNextThink(ent, level.time + SEC(1)); // the player is still on the plat, so delay going down
 }
 
 // PGM - plat2's change the trigger field
@@ -686,7 +686,7 @@ void THINK(rotating_accel)(edict_t *self)
         current_speed += self->accel;
         self->avelocity = Vec3_Scale(self->movedir, current_speed);
         self->think = rotating_accel;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 }
 
@@ -702,7 +702,7 @@ void THINK(rotating_decel)(edict_t *self)
         current_speed -= self->decel;
         self->avelocity = Vec3_Scale(self->movedir, current_speed);
         self->think = rotating_decel;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 }
 // PGM
@@ -833,7 +833,7 @@ void THINK(func_spinning_think)(edict_t *ent)
             ent->avelocity.xyz[i] = max(ent->movedir.xyz[i], ent->avelocity.xyz[i] - ent->accel);
     }
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 }
 
 // [Paril-KEX]
@@ -849,7 +849,7 @@ void SP_func_spinning(edict_t *ent)
     ent->movetype = MOVETYPE_PUSH;
 
     ent->timestamp = 0;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->think = func_spinning_think;
 
     trap_SetBrushModel(ent, ent->model);
@@ -920,7 +920,7 @@ void MOVEINFO_ENDFUNC(button_wait)(edict_t *self)
     G_UseTargets(self, self->activator);
 
     if (self->moveinfo.wait >= 0) {
-        self->nextthink = level.time + SEC(self->moveinfo.wait);
+        G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
         self->think = button_return;
     }
 }
@@ -1102,7 +1102,7 @@ void MOVEINFO_ENDFUNC(door_hit_top)(edict_t *self)
 
     if (self->moveinfo.wait >= 0) {
         self->think = door_go_down;
-        self->nextthink = level.time + SEC(self->moveinfo.wait);
+        G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
     }
 
     if (self->spawnflags & SPAWNFLAG_DOOR_START_OPEN)
@@ -1153,7 +1153,7 @@ static void door_go_up(edict_t *self, edict_t *activator)
     if (self->moveinfo.state == STATE_TOP) {
         // reset top wait time
         if (self->moveinfo.wait >= 0)
-            self->nextthink = level.time + SEC(self->moveinfo.wait);
+            G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
         return;
     }
 
@@ -1189,13 +1189,13 @@ void THINK(smart_water_go_up)(edict_t *self)
     if (self->moveinfo.state == STATE_TOP) {
         // reset top wait time
         if (self->moveinfo.wait >= 0)
-            self->nextthink = level.time + SEC(self->moveinfo.wait);
+            G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
         return;
     }
 
     if (self->health && self->r.absbox.maxs.z >= self->health) {
         self->velocity = vec3_origin;
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         self->moveinfo.state = STATE_TOP;
         return;
     }
@@ -1247,7 +1247,7 @@ void THINK(smart_water_go_up)(edict_t *self)
     }
 
     self->think = smart_water_go_up;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 // PGM
 //======
@@ -1528,7 +1528,7 @@ void SP_func_door(edict_t *ent)
 
     trap_LinkEntity(ent);
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 
     if (ent->spawnflags & SPAWNFLAG_DOOR_START_OPEN)
         ent->think = Think_DoorActivateAreaPortal;
@@ -1553,7 +1553,7 @@ void USE(Door_Activate)(edict_t *self, edict_t *other, edict_t *activator)
         self->think = Think_CalcMoveSpeed;
     else
         self->think = Think_SpawnDoorTrigger;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 // PGM
 
@@ -1693,7 +1693,7 @@ void SP_func_door_rotating(edict_t *ent)
 
     trap_LinkEntity(ent);
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     if (ent->health || ent->targetname)
         ent->think = Think_CalcMoveSpeed;
     else
@@ -1704,7 +1704,7 @@ void SP_func_door_rotating(edict_t *ent)
         ent->takedamage = false;
         ent->die = NULL;
         ent->think = NULL;
-        ent->nextthink = 0;
+        G_SetNextThink(ent, 0);
         ent->use = Door_Activate;
     }
     // PGM
@@ -1866,7 +1866,7 @@ void MOVEINFO_ENDFUNC(train_wait)(edict_t *self)
 
     if (self->moveinfo.wait) {
         if (self->moveinfo.wait > 0) {
-            self->nextthink = level.time + SEC(self->moveinfo.wait);
+            G_SetNextThink(self, level.time + SEC(self->moveinfo.wait));
             self->think = train_next;
         } else if (self->spawnflags & SPAWNFLAG_TRAIN_TOGGLE) { // && wait < 0
             // PMM - clear target_ent, let train_next get called when we get used
@@ -1875,7 +1875,7 @@ void MOVEINFO_ENDFUNC(train_wait)(edict_t *self)
             // pmm
             self->spawnflags &= ~SPAWNFLAG_TRAIN_START_ON;
             self->velocity = vec3_origin;
-            self->nextthink = 0;
+            G_SetNextThink(self, 0);
         }
 
         if (!(self->flags & FL_TEAMSLAVE) && self->moveinfo.sound_end)
@@ -2073,7 +2073,7 @@ void THINK(func_train_find)(edict_t *self)
         self->spawnflags |= SPAWNFLAG_TRAIN_START_ON;
 
     if (self->spawnflags & SPAWNFLAG_TRAIN_START_ON) {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->think = train_next;
         self->activator = self;
     }
@@ -2088,7 +2088,7 @@ void USE(train_use)(edict_t *self, edict_t *other, edict_t *activator)
             return;
         self->spawnflags &= ~SPAWNFLAG_TRAIN_START_ON;
         self->velocity = vec3_origin;
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
     } else {
         if (self->target_ent)
             train_resume(self);
@@ -2126,7 +2126,7 @@ void SP_func_train(edict_t *self)
     if (self->target) {
         // start trains on the second frame, to make sure their targets have had
         // a chance to spawn
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->think = func_train_find;
     } else {
         G_Printf("%s: no target\n", etos(self));
@@ -2180,7 +2180,7 @@ void THINK(trigger_elevator_init)(edict_t *self)
 void SP_trigger_elevator(edict_t *self)
 {
     self->think = trigger_elevator_init;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 /*QUAKED func_timer (0.3 0.1 0.6) (-8 -8 -8) (8 8 8) START_ON
@@ -2203,7 +2203,7 @@ These can used but not touched.
 void THINK(func_timer_think)(edict_t *self)
 {
     G_UseTargets(self, self->activator);
-    self->nextthink = level.time + SEC(self->wait + crandom() * self->random);
+    G_SetNextThink(self, level.time + SEC(self->wait + crandom() * self->random));
 }
 
 void USE(func_timer_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -2212,13 +2212,13 @@ void USE(func_timer_use)(edict_t *self, edict_t *other, edict_t *activator)
 
     // if on, turn it off
     if (self->nextthink) {
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         return;
     }
 
     // turn it on
     if (self->delay)
-        self->nextthink = level.time + SEC(self->delay);
+        G_SetNextThink(self, level.time + SEC(self->delay));
     else
         func_timer_think(self);
 }
@@ -2237,7 +2237,7 @@ void SP_func_timer(edict_t *self)
     }
 
     if (self->spawnflags & SPAWNFLAG_TIMER_START_ON) {
-        self->nextthink = level.time + SEC(1 + st.pausetime + self->delay + self->wait + crandom() * self->random);
+        G_SetNextThink(self, level.time + SEC(1 + st.pausetime + self->delay + self->wait + crandom() * self->random));
         self->activator = self;
     }
 
@@ -2321,7 +2321,7 @@ void USE(door_secret_use)(edict_t *self, edict_t *other, edict_t *activator)
 
 void MOVEINFO_ENDFUNC(door_secret_move1)(edict_t *self)
 {
-    self->nextthink = level.time + SEC(1);
+    G_SetNextThink(self, level.time + SEC(1));
     self->think = door_secret_move2;
 }
 
@@ -2334,7 +2334,7 @@ void MOVEINFO_ENDFUNC(door_secret_move3)(edict_t *self)
 {
     if (self->wait == -1)
         return;
-    self->nextthink = level.time + SEC(self->wait);
+    G_SetNextThink(self, level.time + SEC(self->wait));
     self->think = door_secret_move4;
 }
 
@@ -2345,7 +2345,7 @@ void THINK(door_secret_move4)(edict_t *self)
 
 void MOVEINFO_ENDFUNC(door_secret_move5)(edict_t *self)
 {
-    self->nextthink = level.time + SEC(1);
+    G_SetNextThink(self, level.time + SEC(1));
     self->think = door_secret_move6;
 }
 
@@ -2577,7 +2577,7 @@ void THINK(func_eye_think)(edict_t *self)
         self->s.angles.xyz[i] = anglemod(current + move);
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void THINK(func_eye_setup)(edict_t *self)
@@ -2592,7 +2592,7 @@ void THINK(func_eye_setup)(edict_t *self)
     }
 
     self->think = func_eye_think;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void SP_func_eye(edict_t *ent)
@@ -2622,10 +2622,10 @@ void SP_func_eye(edict_t *ent)
 
     if (ent->pathtarget) {
         ent->think = func_eye_setup;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     } else {
         ent->think = func_eye_think;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     }
 
     trap_LinkEntity(ent);
@@ -200,7 +200,7 @@ void SetRespawnEx(edict_t *ent, gtime_t delay, bool hide_self)
         trap_LinkEntity(ent);
     }
 
-    ent->nextthink = level.time + delay;
+    G_SetNextThink(ent, level.time + delay);
     ent->think = DoRespawn;
 }
 
@@ -635,7 +635,7 @@ void THINK(MegaHealth_think)(edict_t *self)
         //ZOID
        )
     {
-        self->nextthink = level.time + SEC(1);
+        G_SetNextThink(self, level.time + SEC(1));
         owner->health -= 1;
         return;
     }
@@ -682,7 +682,7 @@ static bool Pickup_Health(edict_t *ent, edict_t *other)
             other->client->pers.megahealth_time = SEC(5);
         } else {
             ent->think = MegaHealth_think;
-            ent->nextthink = level.time + SEC(5);
+            G_SetNextThink(ent, level.time + SEC(5));
             ent->r.ownernum = other->s.number;
             ent->flags |= FL_RESPAWN;
             ent->r.svflags |= SVF_NOCLIENT;
@@ -975,7 +975,7 @@ void THINK(drop_make_touchable)(edict_t *ent)
 {
     ent->touch = Touch_Item;
     if (deathmatch.integer) {
-        ent->nextthink = level.time + SEC(29);
+        G_SetNextThink(ent, level.time + SEC(29));
         ent->think = G_FreeEdict;
     }
 }
@@ -1014,7 +1014,7 @@ edict_t *Drop_Item(edict_t *ent, const gitem_t *item)
     dropped->velocity.z = 300;
 
     dropped->think = drop_make_touchable;
-    dropped->nextthink = level.time + SEC(1);
+    G_SetNextThink(dropped, level.time + SEC(1));
 
     if (coop.integer && P_UseCoopInstancedItems())
         dropped->r.svflags |= SVF_INSTANCED;
@@ -1104,7 +1104,7 @@ void THINK(droptofloor)(edict_t *ent)
         ent->r.solid = SOLID_NOT;
 
         if (ent == ent->teammaster) {
-            ent->nextthink = level.time + HZ(10);
+            G_SetNextThink(ent, level.time + HZ(10));
             ent->think = DoRespawn;
         }
     }
@@ -1346,7 +1346,7 @@ void SpawnItem(edict_t *ent, const gitem_t *item)
         ent->r.svflags |= SVF_INSTANCED;
 
     ent->item = item;
-    ent->nextthink = level.time + HZ(5); // items start after other solids
+    G_SetNextThink(ent, level.time + HZ(5)); // items start after other solids
     ent->think = droptofloor;
     if (!(level.is_spawning && ED_WasKeySpecified("effects")) && !ent->s.effects)
         ent->s.effects = item->world_model_flags;
@@ -1439,7 +1439,7 @@ static void Use_Compass(edict_t *ent, const gitem_t *inv)
 
     vec3_t *points = level.poi_points[ent->s.number];
     if (!points)
-        level.poi_points[ent->s.number] = points = G_Malloc(sizeof(vec3_t) * MAX_TEMP_POI_POINTS);
+        level.poi_points[ent->s.number] = points = G_PoolAlloc(sizeof(vec3_t) * MAX_TEMP_POI_POINTS);
 
     PathRequest request = {
         .start = ent->s.origin,
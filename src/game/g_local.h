@@ -1299,6 +1299,10 @@ void      Compass_Update(edict_t *ent, bool first);
 //
 vec3_t G_ProjectSource(vec3_t point, vec3_t distance, vec3_t forward, vec3_t right);
 vec3_t G_ProjectSource2(vec3_t point, vec3_t distance, vec3_t forward, vec3_t right, vec3_t up);
+void     G_LinkTargetname(const edict_t *ent);
+void     G_SetTargetname(edict_t *ent, const char *targetname);
+void     G_ClearTargetnames(void);
+void     G_TargetnameInfo_f(void);
 edict_t *G_Find(edict_t *from, int fieldofs, const char *match);
 edict_t *findradius(edict_t *from, vec3_t org, float rad);
 edict_t *G_PickTarget(const char *targetname);
@@ -1319,6 +1323,9 @@ void G_TouchProjectiles(edict_t *ent, vec3_t previous_origin);
 void G_FreeMemory(void);
 void *G_Malloc(size_t len);
 char *G_CopyString(const char *in);
+void *G_PoolAlloc(size_t len);
+void G_PoolFree(void *ptr);
+char *G_PoolCopyString(const char *in);
 void G_MemoryInfo_f(void);
 
 void G_PlayerNotifyGoal(edict_t *player);
@@ -1626,6 +1633,7 @@ void HuntTarget(edict_t *self, bool animate_state);
 bool infront_cone(edict_t *self, edict_t *other, float cone);
 bool infront(edict_t *self, edict_t *other);
 bool visible_ex(edict_t *self, edict_t *other, bool through_glass);
+void G_SightInfo_f(void);
 bool FacingIdeal(edict_t *self);
 
 static inline bool visible(edict_t *self, edict_t *other)
@@ -1799,6 +1807,12 @@ vec3_t Vec3_SLerp(vec3_t from, vec3_t to, float t);
 
 void G_RunEntity(edict_t *ent);
 bool SV_RunThink(edict_t *ent);
+void G_ClearThinks(void);
+void G_WakeEntity(edict_t *ent);
+void G_SetNextThink(edict_t *ent, gtime_t time);
+void G_WakeThinks(void);
+int  G_NextAwakeEntity(int num);
+void G_SleepEntity(edict_t *ent);
 void SV_AddRotationalFriction(edict_t *ent);
 void SV_AddGravity(edict_t *ent);
 void SV_CheckVelocity(edict_t *ent);
@@ -2328,6 +2342,7 @@ struct edict_s {
     float    ideal_yaw;
 
     gtime_t nextthink;
+    int     thinkslot;  // 1-based think heap slot, 0 if not sleeping
     void (*prethink)(edict_t *self);
     void (*postthink)(edict_t *self);
     void (*think)(edict_t *self);
@@ -824,8 +824,13 @@ qvm_exported void G_RunFrame(int64_t time)
     // treat each object in turn
     // even the world gets a chance to think
     //
-    ent = g_edicts;
-    for (int i = 0; i < level.num_edicts; i++, ent++) {
+    // sleeping entities are skipped until their think is due
+    //
+    G_WakeThinks();
+
+    for (int i = G_NextAwakeEntity(0); i < level.num_edicts; i = G_NextAwakeEntity(i + 1)) {
+        ent = &g_edicts[i];
+
         if (!ent->r.inuse) {
             // defer removing client info so that disconnected, etc works
             if (i < game.maxclients) {
@@ -834,6 +839,7 @@ qvm_exported void G_RunFrame(int64_t time)
                     ent->timestamp = 0;
                 }
             }
+            G_SleepEntity(ent);
             continue;
         }
 
@@ -864,6 +870,7 @@ qvm_exported void G_RunFrame(int64_t time)
         }
 
         G_RunEntity(ent);
+        G_SleepEntity(ent);
     }
 
     // see if it is time to end a deathmatch
@@ -169,9 +169,9 @@ edict_t *ThrowGibEx(edict_t *self, const char *gibname, int damage, gib_type_t t
     gib->think = G_FreeEdict;
 
     if (g_instagib.integer)
-        gib->nextthink = level.time + random_time_sec(1, 5);
+        G_SetNextThink(gib, level.time + random_time_sec(1, 5));
     else
-        gib->nextthink = level.time + random_time_sec(10, 20);
+        G_SetNextThink(gib, level.time + random_time_sec(10, 20));
 
     trap_LinkEntity(gib);
 
@@ -221,7 +221,7 @@ void ThrowClientHead(edict_t *self, int damage)
         self->client->anim_end = self->s.frame;
     } else {
         self->think = NULL;
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
     }
 
     trap_LinkEntity(self);
@@ -486,7 +486,7 @@ static void setup_shadow_light(edict_t *self)
     self->itemtarget = st.sl.lightstyletarget;
 
     self->think = find_shadow_light_targets;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     self->s.modelindex  = Q_clipf(st.sl.radius,     1, MAX_MODELS - 1);
     self->s.modelindex2 = Q_clipf(st.sl.fade_start, 0, MAX_MODELS - 1);
@@ -716,7 +716,7 @@ void SP_func_object(edict_t *self)
         self->r.solid = SOLID_BSP;
         self->movetype = MOVETYPE_PUSH;
         self->think = func_object_release;
-        self->nextthink = level.time + HZ(5);
+        G_SetNextThink(self, level.time + HZ(5));
     } else {
         self->r.solid = SOLID_NOT;
         self->movetype = MOVETYPE_PUSH;
@@ -947,7 +947,7 @@ void THINK(barrel_burn)(edict_t *self)
 
     self->s.morefx |= EFX_BARREL_EXPLODING;
     self->s.sound = G_SoundIndex("weapons/bfg__l1a.wav");
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void DIE(barrel_delay)(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage, vec3_t point, mod_t mod)
@@ -973,7 +973,7 @@ void THINK(barrel_think)(edict_t *self)
 {
     // the think needs to be first since later stuff may override.
     self->think = barrel_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     M_CategorizePosition(self, self->s.origin, &self->waterlevel, &self->watertype);
     self->flags |= FL_IMMUNE_SLIME;
@@ -985,7 +985,7 @@ void THINK(barrel_start)(edict_t *self)
 {
     M_droptofloor(self);
     self->think = barrel_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 // PGM
 //=========
@@ -1028,7 +1028,7 @@ void SP_misc_explobox(edict_t *self)
 
     // PGM - change so barrels will think and hence, blow up
     self->think = barrel_start;
-    self->nextthink = level.time + HZ(5);
+    G_SetNextThink(self, level.time + HZ(5));
     // PGM
 
     trap_LinkEntity(self);
@@ -1062,7 +1062,7 @@ void THINK(misc_blackhole_think)(edict_t *self)
         self->s.angles.yaw += 50.0f * FRAME_TIME_SEC;
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void SP_misc_blackhole(edict_t *ent)
@@ -1074,7 +1074,7 @@ void SP_misc_blackhole(edict_t *ent)
     ent->s.renderfx = RF_TRANSLUCENT | RF_NOSHADOW;
     ent->use = misc_blackhole_use;
     ent->think = misc_blackhole_think;
-    ent->nextthink = level.time + HZ(5);
+    G_SetNextThink(ent, level.time + HZ(5));
 
     if (ent->spawnflags & SPAWNFLAG_BLACKHOLE_AUTO_NOISE)
         ent->s.sound = G_EncodeSound(CHAN_AUTO, G_SoundIndex("world/blackhole.wav"), 1, ATTN_NORM);
@@ -1088,10 +1088,10 @@ void SP_misc_blackhole(edict_t *ent)
 void THINK(misc_eastertank_think)(edict_t *self)
 {
     if (++self->s.frame < 293)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     else {
         self->s.frame = 254;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -1103,7 +1103,7 @@ void SP_misc_eastertank(edict_t *ent)
     ent->s.modelindex = G_ModelIndex("models/monsters/tank/tris.md2");
     ent->s.frame = 254;
     ent->think = misc_eastertank_think;
-    ent->nextthink = level.time + HZ(5);
+    G_SetNextThink(ent, level.time + HZ(5));
     trap_LinkEntity(ent);
 }
 
@@ -1113,10 +1113,10 @@ void SP_misc_eastertank(edict_t *ent)
 void THINK(misc_easterchick_think)(edict_t *self)
 {
     if (++self->s.frame < 247)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     else {
         self->s.frame = 208;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -1128,7 +1128,7 @@ void SP_misc_easterchick(edict_t *ent)
     ent->s.modelindex = G_ModelIndex("models/monsters/bitch/tris.md2");
     ent->s.frame = 208;
     ent->think = misc_easterchick_think;
-    ent->nextthink = level.time + HZ(5);
+    G_SetNextThink(ent, level.time + HZ(5));
     trap_LinkEntity(ent);
 }
 
@@ -1138,10 +1138,10 @@ void SP_misc_easterchick(edict_t *ent)
 void THINK(misc_easterchick2_think)(edict_t *self)
 {
     if (++self->s.frame < 287)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     else {
         self->s.frame = 248;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -1153,7 +1153,7 @@ void SP_misc_easterchick2(edict_t *ent)
     ent->s.modelindex = G_ModelIndex("models/monsters/bitch/tris.md2");
     ent->s.frame = 248;
     ent->think = misc_easterchick2_think;
-    ent->nextthink = level.time + HZ(5);
+    G_SetNextThink(ent, level.time + HZ(5));
     trap_LinkEntity(ent);
 }
 
@@ -1165,9 +1165,9 @@ There should be a item_commander_head that has this as it's target.
 void THINK(commander_body_think)(edict_t *self)
 {
     if (++self->s.frame < 24)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     else
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
 
     if (self->s.frame == 22)
         G_StartSound(self, CHAN_BODY, G_SoundIndex("tank/thud.wav"), 1, ATTN_NORM);
@@ -1176,7 +1176,7 @@ void THINK(commander_body_think)(edict_t *self)
 void USE(commander_body_use)(edict_t *self, edict_t *other, edict_t *activator)
 {
     self->think = commander_body_think;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     G_StartSound(self, CHAN_BODY, G_SoundIndex("tank/pain.wav"), 1, ATTN_NORM);
 }
 
@@ -1202,7 +1202,7 @@ void SP_monster_commander_body(edict_t *self)
     G_SoundIndex("tank/pain.wav");
 
     self->think = commander_body_drop;
-    self->nextthink = level.time + HZ(2);
+    G_SetNextThink(self, level.time + HZ(2));
 }
 
 /*QUAKED misc_banner (1 .5 0) (-4 -4 -4) (4 4 4)
@@ -1213,7 +1213,7 @@ model="models/objects/banner/tris.md2"
 void THINK(misc_banner_think)(edict_t *ent)
 {
     ent->s.frame = (ent->s.frame + 1) % 16;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 void SP_misc_banner(edict_t *ent)
@@ -1226,7 +1226,7 @@ void SP_misc_banner(edict_t *ent)
     trap_LinkEntity(ent);
 
     ent->think = misc_banner_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 /*QUAKED misc_deadsoldier (1 .5 0) (-16 -16 0) (16 16 16) ON_BACK ON_STOMACH BACK_DECAP FETAL_POS SIT_DECAP IMPALED
@@ -1326,7 +1326,7 @@ void SP_misc_viper(edict_t *ent)
     ent->r.box = Box3_FromSize(16, 0, 32);
 
     ent->think = func_train_find;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->use = misc_viper_use;
     ent->r.svflags |= SVF_NOCLIENT;
     ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed = ent->speed;
@@ -1444,7 +1444,7 @@ void SP_misc_strogg_ship(edict_t *ent)
     ent->r.box = Box3_FromSize(16, 0, 32);
 
     ent->think = func_train_find;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->use = misc_strogg_ship_use;
     ent->r.svflags |= SVF_NOCLIENT;
     ent->moveinfo.accel = ent->moveinfo.decel = ent->moveinfo.speed = ent->speed;
@@ -1459,14 +1459,14 @@ void THINK(misc_satellite_dish_think)(edict_t *self)
 {
     self->s.frame++;
     if (self->s.frame < 38)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void USE(misc_satellite_dish_use)(edict_t *self, edict_t *other, edict_t *activator)
 {
     self->s.frame = 0;
     self->think = misc_satellite_dish_think;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void SP_misc_satellite_dish(edict_t *ent)
@@ -1515,7 +1515,7 @@ void SP_misc_gib_arm(edict_t *ent)
     ent->deadflag = true;
     ent->avelocity = Vec3_Scale(Vec3_Random(), 200);
     ent->think = G_FreeEdict;
-    ent->nextthink = level.time + SEC(10);
+    G_SetNextThink(ent, level.time + SEC(10));
     trap_LinkEntity(ent);
 }
 
@@ -1533,7 +1533,7 @@ void SP_misc_gib_leg(edict_t *ent)
     ent->deadflag = true;
     ent->avelocity = Vec3_Scale(Vec3_Random(), 200);
     ent->think = G_FreeEdict;
-    ent->nextthink = level.time + SEC(10);
+    G_SetNextThink(ent, level.time + SEC(10));
     trap_LinkEntity(ent);
 }
 
@@ -1551,7 +1551,7 @@ void SP_misc_gib_head(edict_t *ent)
     ent->deadflag = true;
     ent->avelocity = Vec3_Scale(Vec3_Random(), 200);
     ent->think = G_FreeEdict;
-    ent->nextthink = level.time + SEC(10);
+    G_SetNextThink(ent, level.time + SEC(10));
     trap_LinkEntity(ent);
 }
 
@@ -1684,6 +1684,7 @@ void THINK(func_clock_think)(edict_t *self)
     }
 
     self->enemy->message = self->clock_message;
+    G_WakeEntity(self->enemy);
     self->enemy->use(self->enemy, self, self);
 
     if (((self->spawnflags & SPAWNFLAG_TIMER_UP) && (self->health > self->wait)) ||
@@ -1706,7 +1707,7 @@ void THINK(func_clock_think)(edict_t *self)
             return;
     }
 
-    self->nextthink = level.time + SEC(1);
+    G_SetNextThink(self, level.time + SEC(1));
 }
 
 void USE(func_clock_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -1743,7 +1744,7 @@ void SP_func_clock(edict_t *self)
     if (self->spawnflags & SPAWNFLAG_TIMER_START_OFF)
         self->use = func_clock_use;
     else
-        self->nextthink = level.time + SEC(1);
+        G_SetNextThink(self, level.time + SEC(1));
 }
 
 //=================================================================================
@@ -1915,7 +1916,7 @@ void SP_misc_flare(edict_t *ent)
 void THINK(misc_hologram_think)(edict_t *ent)
 {
     ent->s.angles.yaw += 100 * FRAME_TIME_SEC;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->s.alpha = frandom2(0.2f, 0.6f);
 }
 
@@ -1929,7 +1930,7 @@ void SP_misc_hologram(edict_t *ent)
     ent->r.box = Box3_FromSize(16, 0, 32);
     ent->s.morefx = EFX_HOLOGRAM;
     ent->think = misc_hologram_think;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->s.alpha = frandom2(0.2f, 0.6f);
     ent->s.scale = 0.75f;
     trap_LinkEntity(ent);
@@ -1974,18 +1975,18 @@ void THINK(fire_fly)(edict_t *self)
     fireball->classname = "fireball";
     fireball->s.modelindex = G_ModelIndex("models/objects/gibs/sm_meat/tris.md2");
     fireball->s.origin = self->s.origin;
-    fireball->nextthink = level.time + SEC(5);
+    G_SetNextThink(fireball, level.time + SEC(5));
     fireball->think = G_FreeEdict;
     fireball->touch = fire_touch;
     fireball->spawnflags = self->spawnflags;
     trap_LinkEntity(fireball);
-    self->nextthink = level.time + random_time_sec(0, 5);
+    G_SetNextThink(self, level.time + random_time_sec(0, 5));
 }
 
 void SP_misc_lavaball(edict_t *self)
 {
     self->classname = "fireball";
-    self->nextthink = level.time + random_time_sec(0, 5);
+    G_SetNextThink(self, level.time + random_time_sec(0, 5));
     self->think = fire_fly;
     if (!self->speed)
         self->speed = 185;
@@ -2006,7 +2007,7 @@ void USE(info_world_text_use)(edict_t *self, edict_t *other, edict_t *activator)
         self->activator = activator;
         self->think(self);
     } else {
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         self->activator = NULL;
     }
 
@@ -2015,8 +2016,10 @@ void USE(info_world_text_use)(edict_t *self, edict_t *other, edict_t *activator)
 
     if (self->target) {
         edict_t *target = G_PickTarget(self->target);
-        if (target && target->use && target != self)
+        if (target && target->use && target != self) {
+            G_WakeEntity(target);
             target->use(target, self, self);
+        }
     }
 
     if (self->spawnflags & SPAWNFLAG_WORLD_TEXT_REMOVE_ON_TRIGGER)
@@ -2042,7 +2045,7 @@ void THINK(info_world_text_think)(edict_t *self)
         vec3_t textAngle = { .yaw = anglemod(self->s.angles.yaw + 180) };
         trap_R_AddDebugAngledText(self->s.origin, textAngle, self->message, self->dmg_radius, colors[self->sounds], FRAME_TIME, true);
     }
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 /*QUAKED info_world_text (1.0 1.0 0.0) (-16 -16 0) (16 16 32)
@@ -2062,7 +2065,7 @@ void SP_info_world_text(edict_t *self)
     self->dmg_radius *= 16;
 
     if (!(self->spawnflags & SPAWNFLAG_WORLD_TEXT_START_OFF)) {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->activator = self;
     }
 }
@@ -2127,7 +2130,7 @@ void THINK(misc_player_mannequin_think)(edict_t *self)
         M_ChangeYaw(self);
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 static void SetupMannequinModel(edict_t *self, int model_type, const char *weapon, const char *skin)
@@ -2204,7 +2207,7 @@ void SP_misc_player_mannequin(edict_t *self)
     self->r.box = Box3_Scale(self->r.box, self->s.scale);
 
     self->think = misc_player_mannequin_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     if (self->targetname)
         self->use = misc_player_mannequin_use;
@@ -466,7 +466,7 @@ static void M_MoveFrame(edict_t *self)
     // 10hz, but will run aifuncs at full speed with
     // distance spread over 10hz
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     // time to run next 10hz move yet?
     bool run_frame = self->monsterinfo.next_move_time <= level.time;
@@ -671,13 +671,13 @@ void THINK(monster_dead_think)(edict_t *self)
             self->s.frame++;
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void monster_dead(edict_t *self)
 {
     self->think = monster_dead_think;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     self->movetype = MOVETYPE_TOSS;
     self->r.svflags |= SVF_DEADMONSTER;
     self->monsterinfo.damage_blood = 0;
@@ -847,7 +847,7 @@ void USE(monster_triggered_spawn_use)(edict_t *self, edict_t *other, edict_t *ac
 {
     // we have a one frame delay here so we don't telefrag the guy who activated us
     self->think = monster_triggered_spawn;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     if (activator && activator->client && !(self->hackflags & HACKFLAG_END_CUTSCENE))
         self->enemy = activator;
     self->use = monster_use;
@@ -855,7 +855,7 @@ void USE(monster_triggered_spawn_use)(edict_t *self, edict_t *other, edict_t *ac
     if (self->spawnflags & SPAWNFLAG_MONSTER_SCENIC) {
         M_droptofloor(self);
 
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         self->think(self);
 
         if (self->spawnflags & SPAWNFLAG_MONSTER_AMBUSH)
@@ -882,7 +882,7 @@ static void monster_triggered_start(edict_t *self)
     self->r.solid = SOLID_NOT;
     self->movetype = MOVETYPE_NONE;
     self->r.svflags |= SVF_NOCLIENT;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     self->use = monster_triggered_spawn_use;
 
     if (self->targetname)
@@ -1004,7 +1004,7 @@ bool monster_start(edict_t *self)
     // ROGUE
         level.total_monsters++;
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     self->r.svflags |= SVF_MONSTER;
     self->takedamage = true;
     self->air_finished = level.time + SEC(12);
@@ -1230,9 +1230,9 @@ void monster_start_go(edict_t *self)
     } else {
         self->think = monster_think;
         if (level.time < BASE_FRAMETIME)
-            self->nextthink = level.time + irandom2(1, TICK_RATE / BASE_FRAMERATE + 1) * FRAME_TIME;
+            G_SetNextThink(self, level.time + irandom2(1, TICK_RATE / BASE_FRAMERATE + 1) * FRAME_TIME);
         else
-            self->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(self, level.time + FRAME_TIME);
         self->monsterinfo.aiflags |= AI_SPAWNED_ALIVE;
     }
 }
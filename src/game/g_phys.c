@@ -100,7 +100,7 @@ bool SV_RunThink(edict_t *ent)
     if (thinktime > level.time)
         return true;
 
-    ent->nextthink = 0;
+    G_SetNextThink(ent, 0);
     if (!ent->think)
         G_Error("NULL ent->think");
     ent->think(ent);
@@ -108,6 +108,200 @@ bool SV_RunThink(edict_t *ent)
     return false;
 }
 
+/*
+==============================================================================
+
+THINK SCHEDULE
+
+Entities that only think (no movement, no per-frame callbacks) are put to
+sleep after their visit in G_RunFrame and parked in a min-heap keyed by
+nextthink. They are woken up when their think is due, when nextthink is
+changed through G_SetNextThink, or when one of their callbacks is invoked
+by another entity. Awake entities are tracked in a bit set so that the
+frame loop can skip sleeping ones without touching them.
+
+==============================================================================
+*/
+
+static int      think_heap[MAX_EDICTS];
+static int      think_count;
+static uint32_t think_awake[MAX_EDICTS / 32];
+
+static inline bool ThinkBefore(int a, int b)
+{
+    return g_edicts[a].nextthink < g_edicts[b].nextthink;
+}
+
+static void ThinkHeapSet(int slot, int num)
+{
+    think_heap[slot] = num;
+    g_edicts[num].thinkslot = slot + 1;
+}
+
+static void ThinkHeapUp(int slot)
+{
+    int num = think_heap[slot];
+
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if (!ThinkBefore(num, think_heap[parent]))
+            break;
+        ThinkHeapSet(slot, think_heap[parent]);
+        slot = parent;
+    }
+
+    ThinkHeapSet(slot, num);
+}
+
+static void ThinkHeapDown(int slot)
+{
+    int num = think_heap[slot];
+
+    while (1) {
+        int child = slot * 2 + 1;
+        if (child >= think_count)
+            break;
+        if (child + 1 < think_count && ThinkBefore(think_heap[child + 1], think_heap[child]))
+            child++;
+        if (!ThinkBefore(think_heap[child], num))
+            break;
+        ThinkHeapSet(slot, think_heap[child]);
+        slot = child;
+    }
+
+    ThinkHeapSet(slot, num);
+}
+
+static void ThinkHeapRemove(edict_t *ent)
+{
+    int slot = ent->thinkslot - 1;
+
+    ent->thinkslot = 0;
+    if (slot == --think_count)
+        return;
+
+    ThinkHeapSet(slot, think_heap[think_count]);
+    ThinkHeapUp(slot);
+    ThinkHeapDown(g_edicts[think_heap[slot]].thinkslot - 1);
+}
+
+/*
+=============
+G_ClearThinks
+
+Called when g_edicts is cleared for new level or savegame. Entities that are
+initialized afterwards start awake.
+=============
+*/
+void G_ClearThinks(void)
+{
+    for (int i = 0; i < think_count; i++)
+        g_edicts[think_heap[i]].thinkslot = 0;
+
+    think_count = 0;
+    memset(think_awake, 0, sizeof(think_awake));
+
+    // clients are always visited
+    for (int i = 0; i < game.maxclients; i++)
+        think_awake[i >> 5] |= BIT(i & 31);
+}
+
+/*
+=============
+G_WakeEntity
+
+Makes sure entity is visited by the next G_RunFrame.
+=============
+*/
+void G_WakeEntity(edict_t *ent)
+{
+    int num = ent - g_edicts;
+
+    if (ent->thinkslot)
+        ThinkHeapRemove(ent);
+
+    think_awake[num >> 5] |= BIT(num & 31);
+}
+
+void G_SetNextThink(edict_t *ent, gtime_t time)
+{
+    ent->nextthink = time;
+    G_WakeEntity(ent);
+}
+
+/*
+=============
+G_WakeThinks
+
+Wakes up all sleeping entities with think due this frame.
+=============
+*/
+void G_WakeThinks(void)
+{
+    while (think_count && g_edicts[think_heap[0]].nextthink <= level.time)
+        G_WakeEntity(&g_edicts[think_heap[0]]);
+}
+
+/*
+=============
+G_NextAwakeEntity
+
+Returns number of the first awake entity >= num, or level.num_edicts.
+=============
+*/
+int G_NextAwakeEntity(int num)
+{
+    while (num < level.num_edicts) {
+        uint32_t bits = think_awake[num >> 5] >> (num & 31);
+
+        if (!bits) {
+            num = (num | 31) + 1;
+            continue;
+        }
+
+        while (!(bits & 1)) {
+            bits >>= 1;
+            num++;
+        }
+
+        return min(num, level.num_edicts);
+    }
+
+    return level.num_edicts;
+}
+
+/*
+=============
+G_SleepEntity
+
+Called after entity has been run for this frame. Puts entity to sleep if it
+doesn't need to be visited until its next think.
+=============
+*/
+void G_SleepEntity(edict_t *ent)
+{
+    int num = ent - g_edicts;
+
+    if (num < game.maxclients)
+        return;
+
+    if (ent->r.inuse) {
+        if (ent->movetype != MOVETYPE_NONE)
+            return;
+        if (ent->prethink || ent->postthink || ent->bmodel_anim.enabled)
+            return;
+        if (ent->groundentity || (ent->r.svflags & SVF_MONSTER))
+            return;
+        if (ent->nextthink > 0) {
+            think_heap[think_count] = num;
+            ent->thinkslot = ++think_count;
+            ThinkHeapUp(think_count - 1);
+        }
+    }
+
+    think_awake[num >> 5] &= ~BIT(num & 31);
+}
+
 /*
 ==================
 G_Impact
@@ -122,8 +316,10 @@ void G_Impact(edict_t *e1, const trace_t *trace)
     if (e1->touch && (e1->r.solid != SOLID_NOT || (e1->flags & FL_ALWAYS_TOUCH)))
         e1->touch(e1, e2, trace, false);
 
-    if (e2->touch && (e2->r.solid != SOLID_NOT || (e2->flags & FL_ALWAYS_TOUCH)))
+    if (e2->touch && (e2->r.solid != SOLID_NOT || (e2->flags & FL_ALWAYS_TOUCH))) {
+        G_WakeEntity(e2);
         e2->touch(e2, e1, trace, true);
+    }
 }
 
 /*
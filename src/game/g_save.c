@@ -1736,6 +1736,8 @@ qvm_exported void G_ReadLevel(qhandle_t handle)
     // wipe all the entities except world
     memset(g_edicts, 0, sizeof(g_edicts[0]) * ENTITYNUM_WORLD);
     level.num_edicts = game.maxclients;
+    G_ClearTargetnames();
+    G_ClearThinks();
 
     // load the level locals
     expect("level");
@@ -1754,6 +1756,7 @@ qvm_exported void G_ReadLevel(qhandle_t handle)
 
         G_InitEdict(ent);
         read_fields(edict_t_fields, ent);
+        G_LinkTargetname(ent);
     }
 
     // set final amount of edicts
@@ -1779,7 +1782,7 @@ qvm_exported void G_ReadLevel(qhandle_t handle)
         // fire any cross-level triggers
         if (strcmp(ent->classname, "target_crosslevel_target") == 0 ||
             strcmp(ent->classname, "target_crossunit_target") == 0)
-            ent->nextthink = level.time + SEC(ent->delay);
+            G_SetNextThink(ent, level.time + SEC(ent->delay));
 
         // let the server rebuild world links for this ent
         trap_LinkEntity(ent);
@@ -1437,6 +1437,8 @@ q_exported void G_SpawnEntities(void)
     memset(&level, 0, sizeof(level));
     memset(g_edicts, 0, sizeof(g_edicts));
     memset(precache_bitmap, 0, sizeof(precache_bitmap));
+    G_ClearTargetnames();
+    G_ClearThinks();
     level.num_edicts = game.maxclients;
     level.is_spawning = true;
 
@@ -1480,6 +1482,7 @@ q_exported void G_SpawnEntities(void)
         else
             ent = G_Spawn();
         ED_ParseEdict(ent);
+        G_LinkTargetname(ent);
 
         // remove things (except the world) from different skill levels or deathmatch
         if (ent != world) {
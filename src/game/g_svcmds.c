@@ -35,6 +35,10 @@ qvm_exported void G_ServerCommand(void)
         SVCmd_NextMap_f();
     else if (Q_strcasecmp(cmd, "meminfo") == 0)
         G_MemoryInfo_f();
+    else if (Q_strcasecmp(cmd, "targetinfo") == 0)
+        G_TargetnameInfo_f();
+    else if (Q_strcasecmp(cmd, "sightinfo") == 0)
+        G_SightInfo_f();
     else
         G_Printf("Unknown server command \"%s\"\n", cmd);
 }
@@ -57,6 +61,8 @@ qvm_exported void G_CompleteCommand(int firstarg, int argnum)
             trap_AddCommandCompletion("test");
             trap_AddCommandCompletion("nextmap");
             trap_AddCommandCompletion("meminfo");
+            trap_AddCommandCompletion("targetinfo");
+            trap_AddCommandCompletion("sightinfo");
         }
         return;
     }
@@ -28,6 +28,7 @@ void trap_Trace(trace_t *tr, const trace_args_t *args);
 void trap_Clip(trace_t *tr, const trace_args_t *args);
 contents_t trap_PointContents(vec3_t point);
 int trap_BoxEdicts(box3_t box, int *list, int maxcount, int areatype);
+int trap_RadiusEdicts(vec3_t origin, float radius, int *list, int maxcount, int areatype);
 
 bool trap_InVis(vec3_t p1, vec3_t p2, vis_t vis);
 void trap_SetAreaPortalState(unsigned portalnum, bool open);
@@ -113,6 +114,7 @@ void trap_R_AddDebugAngledText(vec3_t origin, vec3_t angles, const char *text,
 #define trap_Clip gi->Clip
 #define trap_PointContents gi->PointContents
 #define trap_BoxEdicts gi->BoxEdicts
+#define trap_RadiusEdicts gi->RadiusEdicts
 
 #define trap_InVis gi->InVis
 #define trap_SetAreaPortalState gi->SetAreaPortalState
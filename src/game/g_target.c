@@ -249,7 +249,7 @@ void SP_target_secret(edict_t *ent)
     }
 
     ent->think = G_VerifyTargetted;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 
     ent->use = use_target_secret;
     if (!st.noise)
@@ -425,7 +425,7 @@ void USE(use_target_explosion)(edict_t *self, edict_t *other, edict_t *activator
     }
 
     self->think = target_explosion_explode;
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
 }
 
 void SP_target_explosion(edict_t *ent)
@@ -727,7 +727,7 @@ void SP_target_crosslevel_target(edict_t *self)
     self->r.svflags = SVF_NOCLIENT;
 
     self->think = target_crosslevel_target_think;
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
 }
 
 //==========================================================
@@ -821,7 +821,7 @@ void THINK(target_laser_think)(edict_t *self)
     if (damaged_thing)
         self->damage_debounce_time = level.time + HZ(10);
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     trap_LinkEntity(self);
 }
 
@@ -840,7 +840,7 @@ void target_laser_off(edict_t *self)
     self->spawnflags &= ~SPAWNFLAG_LASER_ON;
     self->r.svflags |= SVF_NOCLIENT;
     self->r.svflags &= ~SVF_TRAP;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
 }
 
 void USE(target_laser_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -943,7 +943,7 @@ void SP_target_laser(edict_t *self)
     // let everything else get spawned before we start firing
     self->think = target_laser_start;
     self->r.svflags |= SVF_LASER_FIELD;
-    self->nextthink = level.time + SEC(1);
+    G_SetNextThink(self, level.time + SEC(1));
 }
 
 //==========================================================
@@ -967,7 +967,7 @@ void THINK(target_lightramp_think)(edict_t *self)
     trap_SetConfigstring(CS_LIGHTS + self->enemy->style, style);
 
     if (diff < self->speed) {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     } else if (self->spawnflags & SPAWNFLAG_LIGHTRAMP_TOGGLE) {
         SWAP(float, self->movedir.x, self->movedir.y);
         self->movedir.z = -self->movedir.z;
@@ -1058,7 +1058,7 @@ void THINK(target_earthquake_think)(edict_t *self)
     G_AddEvent(self, EV_EARTHQUAKE, self->speed);
 
     if (level.time < self->timestamp)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void USE(target_earthquake_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -1072,13 +1072,13 @@ void USE(target_earthquake_use)(edict_t *self, edict_t *other, edict_t *activato
 
     if (self->spawnflags & SPAWNFLAGS_EARTHQUAKE_TOGGLE) {
         if (self->style)
-            self->nextthink = 0;
+            G_SetNextThink(self, 0);
         else
-            self->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(self, level.time + FRAME_TIME);
 
         self->style = !self->style;
     } else {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         self->last_move_time = 0;
     }
 
@@ -1150,7 +1150,7 @@ void THINK(update_target_camera)(edict_t *self)
             }
 
             self->s.origin = self->movetarget->s.origin;
-            self->nextthink = level.time + SEC(self->movetarget->wait);
+            G_SetNextThink(self, level.time + SEC(self->movetarget->wait));
             if (self->movetarget->target) {
                 self->movetarget = G_PickTarget(self->movetarget->target);
 
@@ -1199,8 +1199,10 @@ void THINK(update_target_camera)(edict_t *self)
             level.intermissiontime = 0;
             level.level_intermission_set = true;
 
-            while ((t = G_Find(t, FOFS(targetname), self->killtarget)))
+            while ((t = G_Find(t, FOFS(targetname), self->killtarget))) {
+                G_WakeEntity(t);
                 t->use(t, self, self->activator);
+            }
 
             level.intermissiontime = level.time;
             //level.intermission_server_frame = gi.ServerFrame();
@@ -1214,7 +1216,7 @@ void THINK(update_target_camera)(edict_t *self)
         return;
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void G_SetClientFrame(edict_t *ent);
@@ -1234,7 +1236,7 @@ void THINK(target_camera_dummy_think)(edict_t *self)
         self->s.alpha = max(1.0f / 255, frac);
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void USE(use_target_camera)(edict_t *self, edict_t *other, edict_t *activator)
@@ -1263,7 +1265,7 @@ void USE(use_target_camera)(edict_t *self, edict_t *other, edict_t *activator)
         dummy->groundentity = activator->groundentity;
         dummy->groundentity_linkcount = dummy->groundentity ? dummy->groundentity->r.linkcount : 0;
         dummy->think = target_camera_dummy_think;
-        dummy->nextthink = level.time + HZ(10);
+        G_SetNextThink(dummy, level.time + HZ(10));
         dummy->r.solid = SOLID_BBOX;
         dummy->movetype = MOVETYPE_STEP;
         dummy->r.box = activator->r.box;
@@ -1307,7 +1309,7 @@ void USE(use_target_camera)(edict_t *self, edict_t *other, edict_t *activator)
 
     self->activator = activator;
     self->think = update_target_camera;
-    self->nextthink = level.time + SEC(self->wait);
+    G_SetNextThink(self, level.time + SEC(self->wait));
     self->moveinfo.move_speed = self->speed;
 
     self->moveinfo.remaining_distance = Vec3_Distance(self->movetarget->s.origin, self->s.origin);
@@ -1357,7 +1359,7 @@ void THINK(update_target_soundfx)(edict_t *self)
 void USE(use_target_soundfx)(edict_t *self, edict_t *other, edict_t *activator)
 {
     self->think = update_target_soundfx;
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
 }
 
 void SP_target_soundfx(edict_t *self)
@@ -1412,7 +1414,7 @@ void THINK(target_light_flicker_think)(edict_t *self)
     if (brandom())
         self->r.svflags ^= SVF_NOCLIENT;
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 // think function handles interpolation from start to finish.
@@ -1454,7 +1456,7 @@ void THINK(target_light_think)(edict_t *self)
 
     self->s.skinnum = MakeBigLong(r, g, b, 0);
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void USE(target_light_use)(edict_t *self, edict_t *other, edict_t *activator)
@@ -1468,17 +1470,17 @@ void USE(target_light_use)(edict_t *self, edict_t *other, edict_t *activator)
 
     if (!self->health) {
         self->think = NULL;
-        self->nextthink = 0;
+        G_SetNextThink(self, 0);
         return;
     }
 
     // has dynamic light "target"
     if (self->chain) {
         self->think = target_light_think;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     } else if (self->spawnflags & SPAWNFLAG_TARGET_LIGHT_FLICKER) {
         self->think = target_light_flicker_think;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -1780,7 +1782,7 @@ void SP_target_poi(edict_t *self)
 
     if (self->team) {
         self->think = target_poi_setup;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     } else {
         if (self->spawnflags & SPAWNFLAG_POI_NEAREST)
             G_Printf("%s has useless spawnflag 'NEAREST'\n", etos(self));
@@ -1873,7 +1875,7 @@ void SP_target_healthbar(edict_t *self)
 
     self->use = use_target_healthbar;
     self->think = check_target_healthbar;
-    self->nextthink = level.time + SEC(0.025f);
+    G_SetNextThink(self, level.time + SEC(0.025f));
 }
 
 /*QUAKED target_autosave (0 1 0) (-8 -8 -8) (8 8 8)
@@ -2002,7 +2004,7 @@ void SP_target_crossunit_target(edict_t *self)
     self->r.svflags = SVF_NOCLIENT;
 
     self->think = target_crossunit_target_think;
-    self->nextthink = level.time + SEC(self->delay);
+    G_SetNextThink(self, level.time + SEC(self->delay));
 }
 
 /*QUAKED target_achievement (.5 .5 .5) (-8 -8 -8) (8 8 8)
@@ -98,7 +98,7 @@ void THINK(turret_breach_think)(edict_t *self)
 
     self->avelocity = delta;
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     for (ent = self->teammaster; ent; ent = ent->teamchain)
         ent->avelocity.yaw = self->avelocity.yaw;
@@ -197,7 +197,7 @@ void SP_turret_breach(edict_t *self)
     self->moveinfo.blocked = turret_blocked;
 
     self->think = turret_breach_finish_init;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     trap_LinkEntity(self);
 }
 
@@ -270,7 +270,7 @@ void THINK(turret_driver_think)(edict_t *self)
     vec3_t target;
     vec3_t dir;
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     if (self->enemy && (!self->enemy->r.inuse || self->enemy->health <= 0))
         self->enemy = NULL;
@@ -315,7 +315,7 @@ void THINK(turret_driver_link)(edict_t *self)
     edict_t *ent;
 
     self->think = turret_driver_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     self->target_ent = G_PickTarget(self->target);
     if (!self->target_ent) {
@@ -383,7 +383,7 @@ void SP_turret_driver(edict_t *self)
     }
 
     self->think = turret_driver_link;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     trap_LinkEntity(self);
 }
@@ -404,7 +404,7 @@ void THINK(turret_brain_think)(edict_t *self)
     vec3_t  dir;
     trace_t trace;
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     if (self->enemy) {
         if (!self->enemy->r.inuse)
@@ -461,7 +461,7 @@ void THINK(turret_brain_link)(edict_t *self)
         self->enemy = G_PickTarget(self->killtarget);
 
     self->think = turret_brain_think;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 
     self->target_ent = G_PickTarget(self->target);
     if (!self->target_ent) {
@@ -493,7 +493,7 @@ void THINK(turret_brain_link)(edict_t *self)
 void USE(turret_brain_deactivate)(edict_t *self, edict_t *other, edict_t *activator)
 {
     self->think = NULL;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
 }
 
 void USE(turret_brain_activate)(edict_t *self, edict_t *other, edict_t *activator)
@@ -513,7 +513,7 @@ void USE(turret_brain_activate)(edict_t *self, edict_t *other, edict_t *activato
     self->activator = activator;
 
     self->think = turret_brain_link;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 /*QUAKED turret_invisible_brain (1 .5 0) (-16 -16 -16) (16 16 16)
@@ -545,7 +545,7 @@ void SP_turret_invisible_brain(edict_t *self)
         self->use = turret_brain_activate;
     } else {
         self->think = turret_brain_link;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 
     self->movetype = MOVETYPE_PUSH;
@@ -6,6 +6,25 @@
 
 static byte g_mem_pool[0x100000];
 static int  g_mem_used;
+static int  g_mem_peak;
+static int  g_mem_generation;
+
+// small object pool for data that is allocated and freed during a level
+#define POOL_SIZE       0x40000
+#define POOL_SLAB_SIZE  0x4000
+#define POOL_SLABS      (POOL_SIZE / POOL_SLAB_SIZE)
+#define POOL_CLASSES    8       // 16 .. 2048 bytes
+
+typedef struct pool_block_s {
+    struct pool_block_s *next;
+} pool_block_t;
+
+static uint64_t      g_pool_mem[POOL_SIZE / sizeof(uint64_t)];
+static int           g_pool_slabs;
+static byte          g_pool_slab_class[POOL_SLABS];
+static pool_block_t *g_pool_free[POOL_CLASSES];
+static int           g_pool_live[POOL_CLASSES];
+static int           g_pool_fallback;
 
 vec3_t G_ProjectSource(vec3_t point, vec3_t distance, vec3_t forward, vec3_t right)
 {
@@ -23,6 +42,144 @@ vec3_t G_ProjectSource2(vec3_t point, vec3_t distance, vec3_t forward, vec3_t ri
     return point;
 }
 
+/*
+=============
+Targetname index
+
+Entities are hashed by targetname so that looking up targets doesn't need to
+scan all edicts. Chains are sorted by entity number to keep G_Find order.
+Matches are always verified, so stale entries are harmless, but targetname
+must be changed through G_SetTargetname to be found.
+=============
+*/
+#define TARGET_HASH_SIZE    1024
+
+static int  target_hash[TARGET_HASH_SIZE];  // entity number + 1
+static int  target_next[MAX_EDICTS];        // entity number + 1
+static int  target_bucket[MAX_EDICTS];      // bucket + 1, 0 if not linked
+
+static struct {
+    unsigned    lookups;
+    unsigned    checked;    // entities compared using index
+    unsigned    scanned;    // entities a linear search would compare
+} target_stats;
+
+static unsigned G_HashTargetname(const char *s)
+{
+    unsigned hash = 0;
+
+    while (*s)
+        hash = hash * 31 + Q_tolower(*s++);
+
+    return hash & (TARGET_HASH_SIZE - 1);
+}
+
+static void G_UnlinkTargetname(const edict_t *ent)
+{
+    int num = ent - g_edicts;
+    int *link;
+
+    if (!target_bucket[num])
+        return;
+
+    for (link = &target_hash[target_bucket[num] - 1]; *link; link = &target_next[*link - 1]) {
+        if (*link == num + 1) {
+            *link = target_next[num];
+            break;
+        }
+    }
+
+    target_next[num] = 0;
+    target_bucket[num] = 0;
+}
+
+/*
+=============
+G_LinkTargetname
+
+Updates targetname index for the entity. Must be called after targetname
+is changed.
+=============
+*/
+void G_LinkTargetname(const edict_t *ent)
+{
+    int num = ent - g_edicts;
+    unsigned hash;
+    int *link;
+
+    G_UnlinkTargetname(ent);
+
+    if (!ent->targetname)
+        return;
+
+    hash = G_HashTargetname(ent->targetname);
+    for (link = &target_hash[hash]; *link; link = &target_next[*link - 1])
+        if (*link > num + 1)
+            break;
+
+    target_next[num] = *link;
+    target_bucket[num] = hash + 1;
+    *link = num + 1;
+}
+
+void G_SetTargetname(edict_t *ent, const char *targetname)
+{
+    ent->targetname = targetname;
+    G_LinkTargetname(ent);
+}
+
+void G_ClearTargetnames(void)
+{
+    memset(target_hash, 0, sizeof(target_hash));
+    memset(target_next, 0, sizeof(target_next));
+    memset(target_bucket, 0, sizeof(target_bucket));
+    memset(&target_stats, 0, sizeof(target_stats));
+}
+
+static edict_t *G_FindTargetname(edict_t *from, const char *match)
+{
+    int start = from ? from - g_edicts + 1 : 0;
+    edict_t *ent;
+
+    target_stats.lookups++;
+    target_stats.scanned += max(level.num_edicts - start, 0);
+
+    for (int link = target_hash[G_HashTargetname(match)]; link; link = target_next[link - 1]) {
+        if (link - 1 < start)
+            continue;
+        if (link - 1 >= level.num_edicts)
+            break;
+        target_stats.checked++;
+        ent = &g_edicts[link - 1];
+        if (!ent->r.inuse || !ent->targetname)
+            continue;
+        if (!Q_stricmp(ent->targetname, match))
+            return ent;
+    }
+
+    return NULL;
+}
+
+void G_TargetnameInfo_f(void)
+{
+    int used = 0, longest = 0, total = 0;
+
+    for (int i = 0; i < TARGET_HASH_SIZE; i++) {
+        int len = 0;
+        for (int link = target_hash[i]; link; link = target_next[link - 1])
+            len++;
+        if (len)
+            used++;
+        longest = max(longest, len);
+        total += len;
+    }
+
+    G_Printf("%d entities in %d/%d buckets, longest chain %d\n",
+             total, used, TARGET_HASH_SIZE, longest);
+    G_Printf("%u lookups, %u entities compared, %u for linear search\n",
+             target_stats.lookups, target_stats.checked, target_stats.scanned);
+}
+
 /*
 =============
 G_Find
@@ -37,6 +194,9 @@ edict_t *G_Find(edict_t *from, int fieldofs, const char *match)
 {
     char    *s;
 
+    if (fieldofs == FOFS(targetname))
+        return G_FindTargetname(from, match);
+
     if (!from)
         from = g_edicts;
     else
@@ -55,6 +215,13 @@ edict_t *G_Find(edict_t *from, int fieldofs, const char *match)
     return NULL;
 }
 
+static struct {
+    vec3_t  org;
+    float   rad;
+    int     count;
+    int     list[MAX_EDICTS];
+} radius_cache;
+
 /*
 =================
 findradius
@@ -62,15 +229,37 @@ findradius
 Returns entities that have origins within a spherical area
 
 findradius (origin, radius)
+
+Candidates come from the server area tree and are cached between calls, so
+iterating over the results doesn't rescan the whole edict array. A NULL
+`from' or a different sphere (nested search) starts a new query.
 =================
 */
 edict_t *findradius(edict_t *from, vec3_t org, float rad)
 {
-    if (!from)
-        from = g_edicts;
-    else
-        from++;
-    for (; from < &g_edicts[level.num_edicts]; from++) {
+    int i, lo, hi, num;
+
+    if (!from || rad != radius_cache.rad || !Vec3_IsEqual(org, radius_cache.org)) {
+        radius_cache.org = org;
+        radius_cache.rad = rad;
+        radius_cache.count = trap_RadiusEdicts(org, rad, radius_cache.list, MAX_EDICTS,
+                                               AREA_SOLID | AREA_TRIGGERS);
+    }
+
+    // find first candidate past `from'
+    num = from ? from - g_edicts : -1;
+    lo = 0;
+    hi = radius_cache.count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (radius_cache.list[mid] <= num)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    for (i = lo; i < radius_cache.count; i++) {
+        from = &g_edicts[radius_cache.list[i]];
         if (!from->r.inuse)
             continue;
         if (from->r.solid == SOLID_NOT)
@@ -203,7 +392,7 @@ void G_UseTargets(edict_t *ent, edict_t *activator)
         // create a temp object to fire at a later time
         t = G_Spawn();
         t->classname = "DelayedUse";
-        t->nextthink = level.time + SEC(ent->delay);
+        G_SetNextThink(t, level.time + SEC(ent->delay));
         t->think = Think_Delay;
         t->activator = activator;
         if (!activator)
@@ -253,8 +442,10 @@ void G_UseTargets(edict_t *ent, edict_t *activator)
 
             if (t == ent)
                 G_Printf("WARNING: Entity used itself.\n");
-            else if (t->use)
+            else if (t->use) {
+                G_WakeEntity(t);
                 t->use(t, ent, activator);
+            }
 
             if (!ent->r.inuse) {
                 G_Printf("entity was removed while using targets\n");
@@ -306,9 +497,24 @@ float vectoyaw(vec3_t vec)
     return yaw;
 }
 
+/*
+=================
+G_FreeMemory
+
+Frees everything allocated from the level arena and the small object pool.
+Called on every map change, so memory use is bounded by a single level.
+=================
+*/
 void G_FreeMemory(void)
 {
+    g_mem_peak = max(g_mem_peak, g_mem_used);
     g_mem_used = 0;
+    g_mem_generation++;
+
+    g_pool_slabs = 0;
+    g_pool_fallback = 0;
+    memset(g_pool_free, 0, sizeof(g_pool_free));
+    memset(g_pool_live, 0, sizeof(g_pool_live));
 }
 
 void *G_Malloc(size_t len)
@@ -333,9 +539,115 @@ char *G_CopyString(const char *in)
     return out;
 }
 
+static bool G_PoolOwns(const void *ptr)
+{
+    const byte *p = ptr;
+    const byte *base = (const byte *)g_pool_mem;
+
+    return p >= base && p < base + sizeof(g_pool_mem);
+}
+
+static int G_PoolClass(size_t len)
+{
+    int c = 0;
+
+    while ((16U << c) < len)
+        c++;
+
+    return c;
+}
+
+/*
+=================
+G_PoolAlloc
+
+Allocates zero filled memory that can be returned with G_PoolFree before the
+end of the level. Falls back to the level arena for large blocks or when the
+pool runs out of slabs.
+=================
+*/
+void *G_PoolAlloc(size_t len)
+{
+    int c = G_PoolClass(len);
+
+    if (c >= POOL_CLASSES) {
+        g_pool_fallback++;
+        return memset(G_Malloc(len), 0, len);
+    }
+
+    if (!g_pool_free[c]) {
+        if (g_pool_slabs == POOL_SLABS) {
+            g_pool_fallback++;
+            return memset(G_Malloc(len), 0, len);
+        }
+
+        // carve a new slab into blocks of this class
+        size_t size = 16U << c;
+        byte *slab = (byte *)g_pool_mem + g_pool_slabs * POOL_SLAB_SIZE;
+
+        g_pool_slab_class[g_pool_slabs++] = c;
+        for (size_t ofs = POOL_SLAB_SIZE; ofs >= size; ofs -= size) {
+            pool_block_t *b = (pool_block_t *)(slab + ofs - size);
+            b->next = g_pool_free[c];
+            g_pool_free[c] = b;
+        }
+    }
+
+    pool_block_t *b = g_pool_free[c];
+    g_pool_free[c] = b->next;
+    g_pool_live[c]++;
+
+    return memset(b, 0, 16U << c);
+}
+
+/*
+=================
+G_PoolFree
+
+Returns memory obtained from G_PoolAlloc. Pointers that don't belong to the
+pool (NULL, arena or static data) are ignored.
+=================
+*/
+void G_PoolFree(void *ptr)
+{
+    if (!G_PoolOwns(ptr))
+        return;
+
+    size_t ofs = (byte *)ptr - (byte *)g_pool_mem;
+    int c = g_pool_slab_class[ofs / POOL_SLAB_SIZE];
+    pool_block_t *b = ptr;
+
+    Q_assert(ofs / POOL_SLAB_SIZE < g_pool_slabs);
+    Q_assert(!(ofs % POOL_SLAB_SIZE % (16U << c)));
+
+    b->next = g_pool_free[c];
+    g_pool_free[c] = b;
+    g_pool_live[c]--;
+}
+
+char *G_PoolCopyString(const char *in)
+{
+    if (!in)
+        return NULL;
+    size_t len = strlen(in) + 1;
+    char *out = G_PoolAlloc(len);
+    memcpy(out, in, len);
+    return out;
+}
+
 void G_MemoryInfo_f(void)
 {
-    G_Printf("%d bytes allocated (%.1f%%)\n", g_mem_used, g_mem_used * 100.0f / sizeof(g_mem_pool));
+    G_Printf("%d bytes allocated (%.1f%%), peak %d, level %d\n", g_mem_used,
+             g_mem_used * 100.0f / sizeof(g_mem_pool), max(g_mem_peak, g_mem_used), g_mem_generation);
+
+    G_Printf("pool: %d/%d slabs, %d fallback allocations\n", g_pool_slabs, POOL_SLABS, g_pool_fallback);
+    for (int c = 0; c < POOL_CLASSES; c++) {
+        int slabs = 0;
+        for (int i = 0; i < g_pool_slabs; i++)
+            slabs += g_pool_slab_class[i] == c;
+        if (slabs)
+            G_Printf("%5u bytes: %d slabs, %d live\n", 16U << c, slabs, g_pool_live[c]);
+    }
 }
 
 void G_InitEdict(edict_t *e)
@@ -351,6 +663,7 @@ void G_InitEdict(edict_t *e)
 
     e->r.inuse = true;
     e->r.ownernum = ENTITYNUM_NONE;
+    G_WakeEntity(e);
     e->classname = "noclass";
     e->gravity = 1.0f;
     e->attenuation = ATTN_STATIC;
@@ -414,11 +727,14 @@ void THINK(G_FreeEdict)(edict_t *ed)
         return;
 
     trap_UnlinkEntity(ed); // unlink from world
+    G_UnlinkTargetname(ed);
+    G_WakeEntity(ed);
 
     if ((ed - g_edicts) < (game.maxclients + BODY_QUEUE_SIZE))
         return;
 
     G_RemoveTeamchain(ed);
+    G_PoolFree((void *)ed->classname);
 
     uint32_t id = ed->spawn_count + 1;
     memset(ed, 0, sizeof(*ed));
@@ -456,6 +772,7 @@ void G_TouchTriggers(edict_t *ent)
             continue;
         if (!hit->touch)
             continue;
+        G_WakeEntity(hit);
         hit->touch(hit, ent, &null_trace, true);
     }
 }
@@ -327,7 +327,7 @@ edict_t *fire_blaster(edict_t *self, vec3_t start, vec3_t dir, int damage, int s
     bolt->s.modelindex = G_ModelIndex("models/objects/laser/tris.md2");
     bolt->s.sound = G_SoundIndex("misc/lasfly.wav");
     bolt->touch = blaster_touch;
-    bolt->nextthink = level.time + SEC(2);
+    G_SetNextThink(bolt, level.time + SEC(2));
     bolt->think = G_FreeEdict;
     bolt->dmg = damage;
     bolt->classname = "bolt";
@@ -427,7 +427,7 @@ void THINK(Grenade4_Think)(edict_t *self)
         self->s.angles.roll = r + (FRAME_TIME_SEC * 360 * speed_frac);
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void fire_grenade(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int speed, gtime_t timer, float damage_radius, float right_adjust, float up_adjust)
@@ -458,13 +458,13 @@ void fire_grenade(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int sp
             grenade->s.modelindex = G_ModelIndex("models/objects/grenade_zombie/tris.md2");
         else
             grenade->s.modelindex = G_ModelIndex("models/objects/grenade/tris.md2");
-        grenade->nextthink = level.time + timer;
+        G_SetNextThink(grenade, level.time + timer);
         grenade->think = Grenade_Explode;
         grenade->s.morefx |= EFX_GRENADE_LIGHT;
     } else {
         grenade->s.modelindex = G_ModelIndex("models/objects/grenade4/tris.md2");
         grenade->s.angles = vectoangles(grenade->velocity);
-        grenade->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(grenade, level.time + FRAME_TIME);
         grenade->timestamp = level.time + timer;
         grenade->think = Grenade4_Think;
         grenade->s.renderfx |= RF_MINLIGHT;
@@ -507,7 +507,7 @@ void fire_grenade2(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int s
     grenade->s.modelindex = G_ModelIndex("models/objects/grenade3/tris.md2");
     grenade->r.ownernum = self->s.number;
     grenade->touch = Grenade_Touch;
-    grenade->nextthink = level.time + timer;
+    G_SetNextThink(grenade, level.time + timer);
     grenade->think = Grenade_Explode;
     grenade->dmg = damage;
     grenade->dmg_radius = damage_radius;
@@ -570,7 +570,7 @@ edict_t *fire_rocket(edict_t *self, vec3_t start, vec3_t dir, int damage, int sp
     rocket->s.modelindex = G_ModelIndex("models/objects/rocket/tris.md2");
     rocket->s.sound = G_SoundIndex("weapons/rockfly.wav");
     rocket->touch = rocket_touch;
-    rocket->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(rocket, level.time + SEC(8000.0f / speed));
     rocket->think = G_FreeEdict;
     rocket->dmg = damage;
     rocket->radius_dmg = radius_damage;
@@ -658,7 +658,7 @@ void THINK(bfg_laser_update)(edict_t *self)
     }
 
     self->s.origin = G_SnapVector(owner->s.origin);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     trap_LinkEntity(self);
 }
 
@@ -679,7 +679,7 @@ static void bfg_spawn_laser(edict_t *self)
     laser->s.old_origin = G_SnapVector(tr.endpos);
     laser->s.skinnum = 0xD0D0D0D0;
     laser->think = bfg_laser_update;
-    laser->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(laser, level.time + FRAME_TIME);
     laser->timestamp = level.time + SEC(0.3f);
     laser->r.ownernum = self->s.number;
     trap_LinkEntity(laser);
@@ -732,7 +732,7 @@ void THINK(bfg_explode)(edict_t *self)
         }
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     self->s.frame++;
     if (self->s.frame == 5)
         self->think = G_FreeEdict;
@@ -771,7 +771,7 @@ void TOUCH(bfg_touch)(edict_t *self, edict_t *other, const trace_t *tr, bool oth
     self->s.sound = 0;
     self->s.effects &= ~EF_ANIM_ALLFAST;
     self->think = bfg_explode;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
     self->enemy = other;
 
     G_AddEvent(self, EV_BFG_EXPLOSION_BIG, 0);
@@ -856,7 +856,7 @@ void THINK(bfg_think)(edict_t *self)
         G_SpawnTrail(self->s.origin, tr.endpos, EV_BFG_LASER);
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void fire_bfg(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, float damage_radius)
@@ -871,13 +871,13 @@ void fire_bfg(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, fl
         bfg->s.modelindex = G_ModelIndex("sprites/s_bfg1.sp2");
     bfg->s.sound = G_SoundIndex("weapons/bfg__l1a.wav");
     bfg->touch = bfg_touch;
-    bfg->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(bfg, level.time + SEC(8000.0f / speed));
     bfg->think = G_FreeEdict;
     bfg->radius_dmg = damage;
     bfg->dmg_radius = damage_radius;
     bfg->classname = "bfg blast";
     bfg->think = bfg_think;
-    bfg->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(bfg, level.time + FRAME_TIME);
     bfg->teammaster = bfg;
     bfg->teamchain = NULL;
 
@@ -909,7 +909,7 @@ void fire_disintegrator(edict_t *self, vec3_t start, vec3_t dir, int speed)
     bfg->s.modelindex = G_ModelIndex("sprites/s_bfg1.sp2");
     bfg->s.sound = G_SoundIndex("weapons/bfg__l1a.wav");
     bfg->touch = disintegrator_touch;
-    bfg->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(bfg, level.time + SEC(8000.0f / speed));
     bfg->think = G_FreeEdict;
     bfg->classname = "disint ball";
 
@@ -253,7 +253,7 @@ static void actor_dead(edict_t *self)
     self->r.box.maxs.z = -8 * G_EntityScale(self);
     self->movetype = MOVETYPE_TOSS;
     self->r.svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     trap_LinkEntity(self);
 }
 
@@ -435,7 +435,7 @@ static void arachnid_spawn(edict_t *self)
             return;
 
         if (ent->think) {
-            ent->nextthink = level.time;
+            G_SetNextThink(ent, level.time);
             ent->think(ent);
         }
 
@@ -513,7 +513,7 @@ static void arachnid_dead(edict_t *self)
     M_ScaleBox(self);
     self->movetype = MOVETYPE_TOSS;
     self->r.svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     trap_LinkEntity(self);
 }
 
@@ -447,7 +447,7 @@ static void brain_tounge_attack(edict_t *self)
     te->s.scale = self->s.scale;
     te->s.old_origin = G_SnapVector(start);
     te->s.origin = G_SnapVector(end);
-    te->nextthink = level.time + SEC(0.2f);
+    G_SetNextThink(te, level.time + SEC(0.2f));
     te->think = G_FreeEdict;
     trap_LinkEntity(te);
 
@@ -569,7 +569,7 @@ static void floater_dead(edict_t *self)
     self->r.box = Box3_FromSize(16, -24, -8);
     self->movetype = MOVETYPE_TOSS;
     self->r.svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     trap_LinkEntity(self);
 }
 #endif
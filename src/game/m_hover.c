@@ -231,7 +231,7 @@ static void hover_gib(edict_t *self)
 void THINK(hover_deadthink)(edict_t *self)
 {
     if (!self->groundentity && level.time < self->timestamp) {
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
         return;
     }
 
@@ -447,7 +447,7 @@ static void hover_dead(edict_t *self)
     M_ScaleBox(self);
     self->movetype = MOVETYPE_TOSS;
     self->think = hover_deadthink;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     self->timestamp = level.time + SEC(15);
     trap_LinkEntity(self);
 }
@@ -247,7 +247,7 @@ bool finishHeal(edict_t *self)
     healee->spawnflags = SPAWNFLAG_NONE;
     healee->monsterinfo.aiflags &= AI_RESPAWN_MASK;
     healee->target = NULL;
-    healee->targetname = NULL;
+    G_SetTargetname(healee, NULL);
     healee->combattarget = NULL;
     healee->deathtarget = NULL;
     healee->healthtarget = NULL;
@@ -306,7 +306,7 @@ bool finishHeal(edict_t *self)
         healee->monsterinfo.setskin(healee);
 
     if (healee->think) {
-        healee->nextthink = level.time;
+        G_SetNextThink(healee, level.time);
         healee->think(healee);
     }
 
@@ -1266,7 +1266,7 @@ static void medic_finish_spawn(edict_t *self)
             continue;
 
         if (ent->think) {
-            ent->nextthink = level.time;
+            G_SetNextThink(ent, level.time);
             ent->think(ent);
         }
 
@@ -397,7 +397,7 @@ void TOUCH(proboscis_touch)(edict_t *self, edict_t *other, const trace_t *tr, bo
     G_PositionedSound(tr->endpos, NULL, CHAN_AUTO, sound_impact, 1, ATTN_NORM);
 
     self->s.origin = p;
-    self->nextthink = level.time + FRAME_TIME; // start doing stuff on next frame
+    G_SetNextThink(self, level.time + FRAME_TIME); // start doing stuff on next frame
     trap_LinkEntity(self);
 }
 
@@ -462,7 +462,7 @@ void THINK(proboscis_think)(edict_t *self)
 {
     edict_t *owner = &g_edicts[self->r.ownernum];
 
-    self->nextthink = level.time + FRAME_TIME; // start doing stuff on next frame
+    G_SetNextThink(self, level.time + FRAME_TIME); // start doing stuff on next frame
 
     // retracting; keep pulling until we hit the parasite
     if (self->style == 2) {
@@ -564,7 +564,7 @@ static void fire_proboscis(edict_t *self, vec3_t start, vec3_t dir, float speed)
     tip->die = proboscis_die;
     tip->touch = proboscis_touch;
     tip->think = proboscis_think;
-    tip->nextthink = level.time + FRAME_TIME; // start doing stuff on next frame
+    G_SetNextThink(tip, level.time + FRAME_TIME); // start doing stuff on next frame
     self->proboscus = tip;
 
     edict_t *segment = G_Spawn();
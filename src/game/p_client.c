@@ -35,7 +35,7 @@ void SP_info_player_start(edict_t *self)
     // allow them to "ride" the elevators so respawning works
     if (level.is_n64 || level.is_psx || (self->spawnflags & SPAWNFLAG_SPAWN_RIDE)) {
         self->think = info_player_start_drop;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 
     if (level.is_psx)
@@ -456,7 +456,7 @@ static void TossClientWeapon(edict_t *self)
         drop->r.svflags &= ~SVF_INSTANCED;
 
         drop->touch = Touch_Item;
-        drop->nextthink = self->client->quad_time;
+        G_SetNextThink(drop, self->client->quad_time);
         drop->think = G_FreeEdict;
     }
 
@@ -470,7 +470,7 @@ static void TossClientWeapon(edict_t *self)
         drop->r.svflags &= ~SVF_INSTANCED;
 
         drop->touch = Touch_Item;
-        drop->nextthink = self->client->quadfire_time;
+        G_SetNextThink(drop, self->client->quadfire_time);
         drop->think = G_FreeEdict;
     }
     // RAFAEL
@@ -2358,6 +2358,9 @@ qvm_exported void G_ClientDisconnect(int clientnum)
 
     PlayerTrail_Destroy(ent);
 
+    G_PoolFree(level.poi_points[clientnum]);
+    level.poi_points[clientnum] = NULL;
+
     //============
     // ROGUE
     // make sure no trackers are still hurting us.
@@ -2739,8 +2742,10 @@ qvm_exported void G_ClientThink(int clientnum)
             trace_t *tr = &pm.touch.traces[i];
             other = &g_edicts[tr->entnum];
 
-            if (other->touch)
+            if (other->touch) {
+                G_WakeEntity(other);
                 other->touch(other, ent, tr, true);
+            }
         }
     }
 
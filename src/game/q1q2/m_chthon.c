@@ -21,7 +21,7 @@ static void fire_lavaball(edict_t *self, vec3_t start, vec3_t dir, int damage, i
     lavaball->s.modelindex = G_ModelIndex("models/objects/lavaball/tris.md2");
     lavaball->s.sound = G_SoundIndex("weapons/rockfly.wav");
     lavaball->touch = rocket_touch;
-    lavaball->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(lavaball, level.time + SEC(8000.0f / speed));
     lavaball->think = G_FreeEdict;
     lavaball->dmg = damage;
     lavaball->radius_dmg = radius_damage;
@@ -208,7 +208,7 @@ const mmove_t MMOVE_T(chthon_move_rise) = { FRAME_rise3, FRAME_rise17, chthon_fr
 static void chthon_dead(edict_t *self)
 {
     self->r.svflags |= SVF_DEADMONSTER;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     self->think = G_FreeEdict;
 }
 
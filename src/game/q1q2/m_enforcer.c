@@ -128,7 +128,7 @@ static void fire_enfbolt(edict_t *self, vec3_t start, vec3_t dir, int damage, in
     bolt->s.effects |= EF_HYPERBLASTER;
     bolt->s.modelindex = G_ModelIndex("models/monsters/laserstrogg/tris.md2");
     bolt->touch = enfbolt_touch;
-    bolt->nextthink = level.time + SEC(2);
+    G_SetNextThink(bolt, level.time + SEC(2));
     bolt->think = G_FreeEdict;
     bolt->dmg = damage;
     trap_LinkEntity(bolt);
@@ -200,7 +200,7 @@ static void fire_magic(edict_t *self, vec3_t start, vec3_t dir, int damage, int
     magic->s.effects |= EF_IONRIPPER;
     magic->s.modelindex = G_ModelIndex("models/monsters/spikestrogg/tris.md2");
     magic->touch = magic_touch;
-    magic->nextthink = level.time + SEC(10);
+    G_SetNextThink(magic, level.time + SEC(10));
     magic->think = G_FreeEdict;
     magic->dmg = damage;
     magic->enemy = self->enemy;
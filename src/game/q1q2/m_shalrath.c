@@ -126,7 +126,7 @@ void THINK(shalrath_pod_home)(edict_t *self)
 
     G_AddEvent(self, EV_TUNNEL_SPARKS, MakeLittleLong(0, 15, 255, 0));
 
-    self->nextthink = level.time + HZ(5);
+    G_SetNextThink(self, level.time + HZ(5));
     self->think = shalrath_pod_home;
 }
 
@@ -139,7 +139,7 @@ void fire_shalrath_pod(edict_t *self, vec3_t start, vec3_t dir, int damage, int
     pod->s.modelindex = G_ModelIndex("models/monsters/podstrogg/tris.md2");
     pod->s.effects |= EF_IONRIPPER;
     pod->touch = shalrath_pod_touch;
-    pod->nextthink = level.time + HZ(10);
+    G_SetNextThink(pod, level.time + HZ(10));
     pod->think = shalrath_pod_home;
     pod->dmg = damage;
     pod->enemy = self->enemy;
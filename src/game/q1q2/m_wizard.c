@@ -169,7 +169,7 @@ static void fire_spit(edict_t *self, vec3_t start, vec3_t dir, int damage, int s
     spit->s.effects |= (EF_BLASTER | EF_TRACKER);
     spit->s.modelindex = G_ModelIndex("models/monsters/spitstrogg/tris.md2");
     spit->touch = spit_touch;
-    spit->nextthink = level.time + SEC(10);
+    G_SetNextThink(spit, level.time + SEC(10));
     spit->think = G_FreeEdict;
     spit->dmg = damage;
     trap_LinkEntity(spit);
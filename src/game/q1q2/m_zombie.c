@@ -156,7 +156,7 @@ void TOUCH(zombie_gib_touch)(edict_t *self, edict_t *other, const trace_t *tr, b
     self->velocity = vec3_origin;
     self->touch = NULL;
     self->think = G_FreeEdict;
-    self->nextthink = level.time + random_time_sec(10, 20);
+    G_SetNextThink(self, level.time + random_time_sec(10, 20));
 }
 
 static void fire_zombie_gib(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int speed, float right_adjust, float up_adjust)
@@ -45,7 +45,7 @@ void MOVEINFO_ENDFUNC(plat2_hit_top)(edict_t *ent)
         ent->plat2flags = PLAT2_WAITING;
         if (!(ent->spawnflags & SPAWNFLAGS_PLAT2_TOGGLE)) {
             ent->think = plat2_go_down;
-            ent->nextthink = level.time + SEC(ent->wait * 2.5f);
+            G_SetNextThink(ent, level.time + SEC(ent->wait * 2.5f));
         }
         if (deathmatch.integer)
             ent->last_move_time = level.time - SEC(ent->wait * 0.5f);
@@ -54,7 +54,7 @@ void MOVEINFO_ENDFUNC(plat2_hit_top)(edict_t *ent)
     } else if (!(ent->spawnflags & SPAWNFLAGS_PLAT2_TOP) && !(ent->spawnflags & SPAWNFLAGS_PLAT2_TOGGLE)) {
         ent->plat2flags = PLAT2_NONE;
         ent->think = plat2_go_down;
-        ent->nextthink = level.time + SEC(ent->wait);
+        G_SetNextThink(ent, level.time + SEC(ent->wait));
         ent->last_move_time = level.time;
     } else {
         ent->plat2flags = PLAT2_NONE;
@@ -75,7 +75,7 @@ void MOVEINFO_ENDFUNC(plat2_hit_bottom)(edict_t *ent)
         ent->plat2flags = PLAT2_WAITING;
         if (!(ent->spawnflags & SPAWNFLAGS_PLAT2_TOGGLE)) {
             ent->think = plat2_go_up;
-            ent->nextthink = level.time + SEC(ent->wait * 2.5f);
+            G_SetNextThink(ent, level.time + SEC(ent->wait * 2.5f));
         }
         if (deathmatch.integer)
             ent->last_move_time = level.time - SEC(ent->wait * 0.5f);
@@ -84,7 +84,7 @@ void MOVEINFO_ENDFUNC(plat2_hit_bottom)(edict_t *ent)
     } else if ((ent->spawnflags & SPAWNFLAGS_PLAT2_TOP) && !(ent->spawnflags & SPAWNFLAGS_PLAT2_TOGGLE)) {
         ent->plat2flags = PLAT2_NONE;
         ent->think = plat2_go_up;
-        ent->nextthink = level.time + SEC(ent->wait);
+        G_SetNextThink(ent, level.time + SEC(ent->wait));
         ent->last_move_time = level.time;
     } else {
         ent->plat2flags = PLAT2_NONE;
@@ -172,10 +172,10 @@ static void plat2_operate(edict_t *ent, edict_t *other)
 
     if (ent->moveinfo.state == STATE_BOTTOM) {
         ent->think = plat2_go_up;
-        ent->nextthink = level.time + pauseTime;
+        G_SetNextThink(ent, level.time + pauseTime);
     } else {
         ent->think = plat2_go_down;
-        ent->nextthink = level.time + pauseTime;
+        G_SetNextThink(ent, level.time + pauseTime);
     }
 }
 
@@ -208,7 +208,7 @@ void SetTriggeredSpawn(edict_t *ent)
         return;
 
     ent->think = NULL;
-    ent->nextthink = 0;
+    G_SetNextThink(ent, 0);
     ent->use = Item_TriggeredSpawn;
     ent->r.svflags |= SVF_NOCLIENT;
     ent->r.solid = SOLID_NOT;
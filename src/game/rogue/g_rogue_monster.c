@@ -56,7 +56,7 @@ void USE(stationarymonster_triggered_spawn_use)(edict_t *self, edict_t *other, e
 {
     // we have a one frame delay here so we don't telefrag the guy who activated us
     self->think = stationarymonster_triggered_spawn;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     if (activator && activator->client)
         self->enemy = activator;
     self->use = monster_use;
@@ -67,7 +67,7 @@ static void stationarymonster_triggered_start(edict_t *self)
     self->r.solid = SOLID_NOT;
     self->movetype = MOVETYPE_NONE;
     self->r.svflags |= SVF_NOCLIENT;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     self->use = stationarymonster_triggered_spawn_use;
 }
 
@@ -559,7 +559,7 @@ void TOUCH(hint_path_touch)(edict_t *self, edict_t *other, const trace_t *tr, bo
     // have the monster freeze if the hint path we just touched has a wait time
     // on it, for example, when riding a plat.
     if (self->wait)
-        other->nextthink = level.time + SEC(self->wait);
+        G_SetNextThink(other, level.time + SEC(self->wait));
 }
 
 /*QUAKED hint_path (.5 .3 0) (-8 -8 -8) (8 8 8) END
@@ -731,7 +731,7 @@ edict_t *SpawnBadArea(box3_t absbox, gtime_t lifespan, edict_t *owner)
 
     if (lifespan) {
         badarea->think = G_FreeEdict;
-        badarea->nextthink = level.time + lifespan;
+        G_SetNextThink(badarea, level.time + lifespan);
     }
     if (owner)
         badarea->r.ownernum = owner->s.number;
@@ -1197,7 +1197,7 @@ void THINK(BossExplode_think)(edict_t *self)
     G_TempEntity(org, !(self->viewheight % 3) ? EV_EXPLOSION1 : EV_EXPLOSION1_NL, 0);
 
     self->viewheight++;
-    self->nextthink = level.time + random_time_sec(0.05f, 0.2f);
+    G_SetNextThink(self, level.time + random_time_sec(0.05f, 0.2f));
 }
 
 void BossExplode(edict_t *self)
@@ -1211,6 +1211,6 @@ void BossExplode(edict_t *self)
     exploder->count = self->spawn_count;
     exploder->style = self->s.modelindex;
     exploder->think = BossExplode_think;
-    exploder->nextthink = level.time + random_time_sec(0.075f, 0.25f);
+    G_SetNextThink(exploder, level.time + random_time_sec(0.075f, 0.25f));
     exploder->viewheight = 0;
 }
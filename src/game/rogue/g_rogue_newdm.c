@@ -188,7 +188,7 @@ void THINK(body_think)(edict_t *self)
         self->teleport_time = level.time + HZ(10);
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void fire_doppleganger(edict_t *ent, vec3_t start, vec3_t aimdir)
@@ -214,7 +214,7 @@ void fire_doppleganger(edict_t *ent, vec3_t start, vec3_t aimdir)
     base->pain = doppleganger_pain;
     base->die = doppleganger_die;
 
-    base->nextthink = level.time + SEC(30);
+    G_SetNextThink(base, level.time + SEC(30));
     base->think = doppleganger_timeout;
 
     base->classname = "doppleganger";
@@ -232,7 +232,7 @@ void fire_doppleganger(edict_t *ent, vec3_t start, vec3_t aimdir)
     body->s.origin.z += 8;
     body->teleport_time = level.time + HZ(10);
     body->think = body_think;
-    body->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(body, level.time + FRAME_TIME);
     trap_LinkEntity(body);
 
     base->teamchain = body;
@@ -54,7 +54,7 @@ void USE(use_target_steam)(edict_t *self, edict_t *other, edict_t *activator)
     self->s.skinnum = MakeBigLong(self->style, self->count, self->sounds, DirToByte(self->movedir));
     self->s.morefx = EFX_STEAM;
 
-    self->nextthink = level.time + SEC(self->wait);
+    G_SetNextThink(self, level.time + SEC(self->wait));
     self->think = target_steam_think;
 }
 
@@ -94,7 +94,7 @@ void SP_target_steam(edict_t *self)
 
     if (self->target) {
         self->think = target_steam_start;
-        self->nextthink = level.time + SEC(1);
+        G_SetNextThink(self, level.time + SEC(1));
     } else
         target_steam_start(self);
 }
@@ -224,7 +224,7 @@ void THINK(blacklight_think)(edict_t *self)
     self->s.angles.pitch += frandom1(10);
     self->s.angles.yaw += frandom1(10);
     self->s.angles.roll += frandom1(10);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void SP_target_blacklight(edict_t *ent)
@@ -240,7 +240,7 @@ void SP_target_blacklight(edict_t *ent)
     ent->s.modelindex = G_ModelIndex("models/items/spawngro3/tris.md2");
     ent->s.scale = 6;
     ent->s.skinnum = 0;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     trap_LinkEntity(ent);
 }
 
@@ -256,7 +256,7 @@ void SP_target_orb(edict_t *ent)
     }
 
     ent->think = blacklight_think;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     ent->s.skinnum = 1;
     ent->s.modelindex = G_ModelIndex("models/items/spawngro3/tris.md2");
     ent->s.frame = 2;
@@ -40,7 +40,7 @@ void fire_flechette(edict_t *self, vec3_t start, vec3_t dir, int damage, int spe
     bolt->s.renderfx |= RF_FULLBRIGHT;
     bolt->s.modelindex = G_ModelIndex("models/proj/flechette/tris.md2");
     bolt->touch = flechette_touch;
-    bolt->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(bolt, level.time + SEC(8000.0f / speed));
     bolt->think = G_FreeEdict;
     bolt->dmg = damage;
     bolt->dmg_radius = kick;
@@ -109,7 +109,7 @@ void DIE(prox_die)(edict_t *self, edict_t *inflictor, edict_t *attacker, int dam
     } else {
         self->takedamage = false;
         self->think = Prox_Explode;
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     }
 }
 
@@ -139,7 +139,7 @@ void TOUCH(Prox_Field_Touch)(edict_t *ent, edict_t *other, const trace_t *tr, bo
     if (prox->teamchain == ent) {
         G_StartSound(ent, CHAN_VOICE, G_SoundIndex("weapons/proxwarn.wav"), 1, ATTN_NORM);
         prox->think = Prox_Explode;
-        prox->nextthink = level.time + PROX_TIME_DELAY;
+        G_SetNextThink(prox, level.time + PROX_TIME_DELAY);
         return;
     }
 
@@ -158,7 +158,7 @@ void THINK(prox_seek)(edict_t *ent)
     if (ent->s.frame > 13)
         ent->s.frame = 9;
     ent->think = prox_seek;
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 }
 
 static bool monster_or_player(edict_t *ent)
@@ -231,7 +231,7 @@ void THINK(prox_open)(edict_t *ent)
         }
 
         ent->think = prox_seek;
-        ent->nextthink = level.time + SEC(0.2f);
+        G_SetNextThink(ent, level.time + SEC(0.2f));
     } else {
         if (ent->s.frame == 0) {
             G_StartSound(ent, CHAN_VOICE, G_SoundIndex("weapons/proxopen.wav"), 1, ATTN_NORM);
@@ -239,7 +239,7 @@ void THINK(prox_open)(edict_t *ent)
         }
         ent->s.frame++;
         ent->think = prox_open;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     }
 }
 
@@ -314,7 +314,7 @@ void TOUCH(prox_land)(edict_t *ent, edict_t *other, const trace_t *tr, bool othe
     ent->die = prox_die;
     ent->teamchain = field;
     ent->health = PROX_HEALTH;
-    ent->nextthink = level.time;
+    G_SetNextThink(ent, level.time);
     ent->think = prox_open;
     ent->touch = NULL;
     ent->r.solid = SOLID_BBOX;
@@ -332,7 +332,7 @@ void THINK(Prox_Think)(edict_t *self)
 
     self->s.angles = vectoangles(self->velocity);
     self->s.angles.pitch -= 90;
-    self->nextthink = level.time;
+    G_SetNextThink(self, level.time);
 }
 
 void fire_prox(edict_t *self, vec3_t start, vec3_t aimdir, int prox_damage_multiplier, int speed)
@@ -369,7 +369,7 @@ void fire_prox(edict_t *self, vec3_t start, vec3_t aimdir, int prox_damage_multi
     prox->teammaster = self;
     prox->touch = prox_land;
     prox->think = Prox_Think;
-    prox->nextthink = level.time;
+    G_SetNextThink(prox, level.time);
     prox->dmg = PROX_DAMAGE * prox_damage_multiplier;
     prox->classname = "prox_mine";
     prox->flags |= FL_DAMAGEABLE;
@@ -488,7 +488,7 @@ void THINK(Nuke_Quake)(edict_t *self)
     }
 
     if (level.time < self->timestamp)
-        self->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self, level.time + FRAME_TIME);
     else
         G_FreeEdict(self);
 }
@@ -511,7 +511,7 @@ static void Nuke_Explode(edict_t *ent)
     ent->think = Nuke_Quake;
     ent->speed = NUKE_QUAKE_STRENGTH;
     ent->timestamp = level.time + NUKE_QUAKE_TIME;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     ent->last_move_time = 0;
 }
 
@@ -571,7 +571,7 @@ void THINK(Nuke_Think)(edict_t *ent)
         }
 
         ent->think = Nuke_Think;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
         ent->health = 1;
         ent->r.ownernum = ENTITYNUM_NONE;
         G_AddEvent(ent, EV_MUZZLEFLASH, muzzleflash);
@@ -590,7 +590,7 @@ void THINK(Nuke_Think)(edict_t *ent)
             G_StartSound(ent, CHAN_VOICE, G_SoundIndex("weapons/nukewarn2.wav"), 1, attenuation);
             ent->pain_debounce_time = level.time + SEC(1);
         }
-        ent->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(ent, level.time + FRAME_TIME);
     }
 }
 
@@ -629,7 +629,7 @@ void fire_nuke(edict_t *self, vec3_t start, vec3_t aimdir, int speed)
     nuke->s.modelindex = G_ModelIndex("models/weapons/g_nuke/tris.md2");
     nuke->r.ownernum = self->s.number;
     nuke->teammaster = self;
-    nuke->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(nuke, level.time + FRAME_TIME);
     nuke->timestamp = level.time + NUKE_DELAY + NUKE_TIME_TO_LIVE;
     nuke->think = Nuke_Think;
     nuke->touch = nuke_bounce;
@@ -787,14 +787,14 @@ void THINK(tesla_think_active)(edict_t *self)
 
             te->s.old_origin = G_SnapVector(start);
             te->s.origin = G_SnapVector(tr.endpos);
-            te->nextthink = level.time + SEC(0.2f);
+            G_SetNextThink(te, level.time + SEC(0.2f));
             trap_LinkEntity(te);
         }
     }
 
     if (self->r.inuse) {
         self->think = tesla_think_active;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
     }
 }
 
@@ -848,7 +848,7 @@ void THINK(tesla_activate)(edict_t *self)
         self->r.ownernum = ENTITYNUM_NONE;
     self->teamchain = trigger;
     self->think = tesla_think_active;
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
     self->air_finished = level.time + TESLA_TIME_TO_LIVE;
 }
 
@@ -868,7 +868,7 @@ void THINK(tesla_think)(edict_t *ent)
     if (ent->s.frame > 14) {
         ent->s.frame = 14;
         ent->think = tesla_activate;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     } else {
         if (ent->s.frame > 9) {
             if (ent->s.frame == 10) {
@@ -882,7 +882,7 @@ void THINK(tesla_think)(edict_t *ent)
                 ent->s.skinnum = 3;
         }
         ent->think = tesla_think;
-        ent->nextthink = level.time + HZ(10);
+        G_SetNextThink(ent, level.time + HZ(10));
     }
 }
 
@@ -928,7 +928,7 @@ void fire_tesla(edict_t *self, vec3_t start, vec3_t aimdir, int tesla_damage_mul
     tesla->r.ownernum = self->s.number; // PGM - we don't want it owned by self YET.
     tesla->teammaster = self;
     tesla->think = tesla_think;
-    tesla->nextthink = level.time + TESLA_ACTIVATE_TIME;
+    G_SetNextThink(tesla, level.time + TESLA_ACTIVATE_TIME);
 
     // blow up on contact with lava & slime code
     tesla->touch = tesla_lava;
@@ -1041,7 +1041,7 @@ void fire_heatbeam(edict_t *self, vec3_t start, vec3_t aimdir, vec3_t offset, in
 
     te->s.old_origin = G_SnapVector(start);
     te->s.origin = G_SnapVector(tr.endpos);
-    te->nextthink = level.time + SEC(0.2f);
+    G_SetNextThink(te, level.time + SEC(0.2f));
     trap_LinkEntity(te);
 
     // if went through water, determine where the end is and make a bubble trail
@@ -1121,7 +1121,7 @@ void fire_blaster2(edict_t *self, vec3_t start, vec3_t dir, int damage, int spee
     bolt->s.skinnum = 2;
     bolt->s.scale = 2.5f;
     bolt->touch = blaster2_touch;
-    bolt->nextthink = level.time + SEC(2);
+    G_SetNextThink(bolt, level.time + SEC(2));
     bolt->think = G_FreeEdict;
     bolt->dmg = damage;
     bolt->dmg_radius = 128;
@@ -1173,7 +1173,7 @@ void THINK(tracker_pain_daemon_think)(edict_t *self)
                      hurt, 0, TRACKER_DAMAGE_FLAGS, MOD_TRACKER);
         }
 
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 
         if (self->enemy->client)
             self->enemy->client->tracker_pain_time = self->nextthink;
@@ -1192,7 +1192,7 @@ static void tracker_pain_daemon_spawn(edict_t *owner, edict_t *enemy, int damage
     daemon = G_Spawn();
     daemon->classname = "pain daemon";
     daemon->think = tracker_pain_daemon_think;
-    daemon->nextthink = level.time;
+    G_SetNextThink(daemon, level.time);
     daemon->timestamp = level.time + TRACKER_DAMAGE_TIME;
     daemon->r.ownernum = owner->s.number;
     daemon->enemy = enemy;
@@ -1270,7 +1270,7 @@ void THINK(tracker_fly)(edict_t *self)
     self->velocity = Vec3_Scale(dir, self->speed);
     self->monsterinfo.saved_goal = dest;
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void fire_tracker(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, edict_t *enemy)
@@ -1289,10 +1289,10 @@ void fire_tracker(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed
     trap_LinkEntity(bolt);
 
     if (enemy) {
-        bolt->nextthink = level.time + HZ(10);
+        G_SetNextThink(bolt, level.time + HZ(10));
         bolt->think = tracker_fly;
     } else {
-        bolt->nextthink = level.time + SEC(10);
+        G_SetNextThink(bolt, level.time + SEC(10));
         bolt->think = G_FreeEdict;
     }
 
@@ -163,7 +163,7 @@ void THINK(spawngrow_think)(edict_t *self)
     self->s.scale = Q_clipf(s, 1.0f / 16, 16);
     self->s.alpha = t * t;
 
-    self->nextthink += FRAME_TIME;
+    G_SetNextThink(self, self->nextthink + FRAME_TIME);
 }
 
 static vec3_t SpawnGro_laser_pos(edict_t *ent)
@@ -176,7 +176,7 @@ void THINK(SpawnGro_laser_think)(edict_t *self)
 {
     self->s.old_origin = SpawnGro_laser_pos(self);
     trap_LinkEntity(self);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void SpawnGrow_Spawn(vec3_t startpos, float start_size, float end_size)
@@ -212,7 +212,7 @@ void SpawnGrow_Spawn(vec3_t startpos, float start_size, float end_size)
     ent->wait = SPAWNGROW_LIFESPAN_SEC;
     ent->timestamp = level.time + SPAWNGROW_LIFESPAN;
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
 
     trap_LinkEntity(ent);
 
@@ -228,7 +228,7 @@ void SpawnGrow_Spawn(vec3_t startpos, float start_size, float end_size)
     beam->s.origin = ent->s.origin;
     beam->s.old_origin = SpawnGro_laser_pos(beam);
     beam->think = SpawnGro_laser_think;
-    beam->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(beam, level.time + FRAME_TIME);
     trap_LinkEntity(beam);
 }
 
@@ -260,7 +260,7 @@ void THINK(widowlegs_think)(edict_t *self)
 
     if (self->s.frame < MAX_LEGSFRAME) {
         self->s.frame++;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
         return;
     }
 
@@ -304,7 +304,7 @@ void THINK(widowlegs_think)(edict_t *self)
         G_TempEntity(point, EV_EXPLOSION1, 0);
     }
 
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 void Widowlegs_Spawn(edict_t *self)
@@ -324,6 +324,6 @@ void Widowlegs_Spawn(edict_t *self)
     ent->s.modelindex = G_ModelIndex("models/monsters/legs/tris.md2");
     ent->think = widowlegs_think;
 
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
     trap_LinkEntity(ent);
 }
@@ -157,7 +157,7 @@ static void sphere_fire(edict_t *self, edict_t *enemy)
 
     self->touch = vengeance_touch;
     self->think = sphere_think_explode;
-    self->nextthink = self->timestamp;
+    G_SetNextThink(self, self->timestamp);
 }
 #endif
 
@@ -416,7 +416,7 @@ void THINK(defender_think)(edict_t *self)
     sphere_fly(self);
 
     if (self->r.inuse)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void THINK(hunter_think)(edict_t *self)
@@ -470,7 +470,7 @@ void THINK(hunter_think)(edict_t *self)
         sphere_fly(self);
 
     if (self->r.inuse)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 void THINK(vengeance_think)(edict_t *self)
@@ -492,7 +492,7 @@ void THINK(vengeance_think)(edict_t *self)
         sphere_fly(self);
 
     if (self->r.inuse)
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
 }
 
 // *************************
@@ -557,7 +557,7 @@ edict_t *Sphere_Spawn(edict_t *owner, spawnflags_t spawnflags)
         return NULL;
     }
 
-    sphere->nextthink = level.time + HZ(10);
+    G_SetNextThink(sphere, level.time + HZ(10));
 
     trap_LinkEntity(sphere);
 
@@ -246,7 +246,7 @@ static void CarrierSpawn(edict_t *self)
 
     G_StartSound(self, CHAN_BODY, sound_spawn, 1, ATTN_NONE);
 
-    ent->nextthink = level.time;
+    G_SetNextThink(ent, level.time);
     ent->think(ent);
 
     ent->monsterinfo.aiflags |= AI_SPAWNED_COMMANDER | AI_DO_NOT_COUNT | AI_IGNORE_SHOTS;
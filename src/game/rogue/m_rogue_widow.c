@@ -227,7 +227,7 @@ static void WidowSpawn(edict_t *self)
         ent->monsterinfo.commander = self;
         ent->monsterinfo.slots_from_commander = 1;
 
-        ent->nextthink = level.time;
+        G_SetNextThink(ent, level.time);
         ent->think(ent);
 
         ent->monsterinfo.aiflags |= AI_SPAWNED_COMMANDER | AI_DO_NOT_COUNT | AI_IGNORE_SHOTS;
@@ -880,7 +880,7 @@ static void widow_dead(edict_t *self)
     self->r.box = Box3_FromSize(56, 0, 80);
     self->movetype = MOVETYPE_TOSS;
     self->r.svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     trap_LinkEntity(self);
 }
 #endif
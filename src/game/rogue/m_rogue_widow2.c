@@ -153,7 +153,7 @@ static void Widow2Spawn(edict_t *self)
         ent->monsterinfo.commander = self;
         ent->monsterinfo.slots_from_commander = 1;
 
-        ent->nextthink = level.time;
+        G_SetNextThink(ent, level.time);
         ent->think(ent);
 
         ent->monsterinfo.aiflags |= AI_SPAWNED_COMMANDER | AI_DO_NOT_COUNT | AI_IGNORE_SHOTS;
@@ -431,7 +431,7 @@ static void Widow2Tongue(edict_t *self)
 
     te->s.old_origin = G_SnapVector(start);
     te->s.origin = G_SnapVector(end);
-    te->nextthink = level.time + SEC(0.2f);
+    G_SetNextThink(te, level.time + SEC(0.2f));
     trap_LinkEntity(te);
 
     dir = Vec3_Sub(start, end);
@@ -636,7 +636,7 @@ static void widow2_finaldeath(edict_t *self)
     M_ScaleBox(self);
     self->movetype = MOVETYPE_TOSS;
     self->takedamage = true;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     trap_LinkEntity(self);
 }
 
@@ -1045,16 +1045,16 @@ static void ThrowWidowGibReal(edict_t *self, const char *gibname, int damage, gi
         gib->think = G_FreeEdict;
         // sized gibs last longer
         if (sized)
-            gib->nextthink = level.time + random_time_sec(20, 35);
+            G_SetNextThink(gib, level.time + random_time_sec(20, 35));
         else
-            gib->nextthink = level.time + random_time_sec(5, 15);
+            G_SetNextThink(gib, level.time + random_time_sec(5, 15));
     } else {
         gib->think = G_FreeEdict;
         // sized gibs last longer
         if (sized)
-            gib->nextthink = level.time + random_time_sec(60, 75);
+            G_SetNextThink(gib, level.time + random_time_sec(60, 75));
         else
-            gib->nextthink = level.time + random_time_sec(25, 35);
+            G_SetNextThink(gib, level.time + random_time_sec(25, 35));
     }
 
     if (!(type & GIB_METALLIC)) {
@@ -1157,7 +1157,7 @@ void THINK(WidowExplode)(edict_t *self)
             ThrowWidowGib(self, "models/objects/gibs/sm_metal/tris.md2", 400, GIB_METALLIC);
         self->deadflag = true;
         self->think = monster_think;
-        self->nextthink = level.time + HZ(10);
+        G_SetNextThink(self, level.time + HZ(10));
         M_SetAnimation(self, &widow2_move_dead);
         return;
     }
@@ -1194,7 +1194,7 @@ void THINK(WidowExplode)(edict_t *self)
         G_TempEntity(org, (self->count & 1) ? EV_EXPLOSION1 : EV_EXPLOSION1_NP, 0);
 
     self->think = WidowExplode;
-    self->nextthink = level.time + HZ(10);
+    G_SetNextThink(self, level.time + HZ(10));
 }
 
 static const vec3_t explosion1_offsets[] = {
@@ -395,7 +395,7 @@ void DIE(DBall_BallDie)(edict_t *self, edict_t *inflictor, edict_t *attacker, in
     self->r.solid = SOLID_NOT;
     //  self->s.modelindex = 0;
     self->think = DBall_BallRespawn;
-    self->nextthink = level.time + SEC(2);
+    G_SetNextThink(self, level.time + SEC(2));
     trap_LinkEntity(self);
 }
 
@@ -14,7 +14,7 @@ void fire_blueblaster(edict_t *self, vec3_t start, vec3_t dir, int damage, int s
     bolt->s.skinnum = 1;
     bolt->s.sound = G_SoundIndex("misc/lasfly.wav");
     bolt->touch = blaster_touch;
-    bolt->nextthink = level.time + SEC(2);
+    G_SetNextThink(bolt, level.time + SEC(2));
     bolt->think = G_FreeEdict;
     bolt->dmg = damage;
     bolt->classname = "bolt";
@@ -67,7 +67,7 @@ void fire_ionripper(edict_t *self, vec3_t start, vec3_t dir, int damage, int spe
     ion->s.modelindex = G_ModelIndex("models/objects/boomrang/tris.md2");
     ion->s.sound = G_SoundIndex("misc/lasfly.wav");
     ion->touch = ionripper_touch;
-    ion->nextthink = level.time + SEC(3);
+    G_SetNextThink(ion, level.time + SEC(3));
     ion->think = ionripper_sparks;
     ion->dmg = damage;
     ion->dmg_radius = 100;
@@ -148,7 +148,7 @@ void THINK(heat_think)(edict_t *self)
         self->enemy = NULL;
 
     self->velocity = Vec3_Scale(self->movedir, self->speed);
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 void fire_heat(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, float damage_radius, int radius_damage, float turn_fraction)
@@ -164,7 +164,7 @@ void fire_heat(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, f
     heat->touch = rocket_touch;
     heat->speed = speed;
     heat->accel = turn_fraction;
-    heat->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(heat, level.time + FRAME_TIME);
     heat->think = heat_think;
     heat->dmg = damage;
     heat->radius_dmg = radius_damage;
@@ -216,7 +216,7 @@ void fire_plasma(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed,
     plasma->s.modelindex = G_ModelIndex("sprites/s_photon.sp2");
     plasma->s.sound = G_SoundIndex("weapons/rockfly.wav");
     plasma->touch = plasma_touch;
-    plasma->nextthink = level.time + SEC(8000.0f / speed);
+    G_SetNextThink(plasma, level.time + SEC(8000.0f / speed));
     plasma->think = G_FreeEdict;
     plasma->dmg = damage;
     plasma->radius_dmg = radius_damage;
@@ -257,7 +257,7 @@ void THINK(Trap_Gib_Think)(edict_t *ent)
     if (ent->watertype & MASK_WATER)
         ent->waterlevel = WATER_FEET;
 
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     trap_LinkEntity(ent);
 }
 
@@ -285,7 +285,7 @@ void THINK(Trap_Think)(edict_t *ent)
         return;
     }
 
-    ent->nextthink = level.time + HZ(10);
+    G_SetNextThink(ent, level.time + HZ(10));
 
     if (!ent->groundentity)
         return;
@@ -309,7 +309,7 @@ void THINK(Trap_Think)(edict_t *ent)
         }
         ent->s.frame++;
         if (ent->s.frame == 8) {
-            ent->nextthink = level.time + SEC(1);
+            G_SetNextThink(ent, level.time + SEC(1));
             ent->think = G_FreeEdict;
             ent->s.effects &= ~EF_TRAP;
 
@@ -322,7 +322,7 @@ void THINK(Trap_Think)(edict_t *ent)
             cube->s.angles.yaw = frandom() * 360;
             cube->velocity.z = 400;
             cube->think(cube);
-            cube->nextthink = 0;
+            G_SetNextThink(cube, 0);
             trap_LinkEntity(cube);
 
             G_StartSound(cube, CHAN_AUTO, G_SoundIndex("misc/fhit3.wav"), 1, ATTN_NORM);
@@ -441,7 +441,7 @@ void THINK(Trap_Think)(edict_t *ent)
             continue;
 
         e->movetype = MOVETYPE_NONE;
-        e->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(e, level.time + FRAME_TIME);
         e->think = Trap_Gib_Think;
         e->r.ownernum = ent->s.number;
         Trap_Gib_Think(e);
@@ -476,7 +476,7 @@ void fire_trap(edict_t *self, vec3_t start, vec3_t aimdir, int speed)
     trap->s.modelindex = G_ModelIndex("models/weapons/z_trap/tris.md2");
     trap->teammaster = self;
     trap->r.ownernum = self->s.number;
-    trap->nextthink = level.time + SEC(1);
+    G_SetNextThink(trap, level.time + SEC(1));
     trap->think = Trap_Think;
     trap->classname = "food_cube_trap";
     // RAFAEL 16-APR-98
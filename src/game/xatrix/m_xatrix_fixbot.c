@@ -50,7 +50,7 @@ void THINK(bot_goal_check)(edict_t *self)
         return;
     }
 
-    self->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(self, level.time + FRAME_TIME);
 }
 
 edict_t *healFindMonster(edict_t *self, float radius);
@@ -205,7 +205,7 @@ static void roam_goal(edict_t *self)
     ent->r.solid = SOLID_BBOX;
     ent->r.ownernum = self->s.number;
     ent->think = bot_goal_check;
-    ent->nextthink = level.time + FRAME_TIME;
+    G_SetNextThink(ent, level.time + FRAME_TIME);
     trap_LinkEntity(ent);   // FIXME
 
     oldlen = 0;
@@ -251,7 +251,7 @@ static void use_scanner(edict_t *self)
 
         // remove the old one
         if (strcmp(self->goalentity->classname, "bot_goal") == 0) {
-            self->goalentity->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(self->goalentity, level.time + FRAME_TIME);
             self->goalentity->think = G_FreeEdict;
         }
 
@@ -273,7 +273,7 @@ static void use_scanner(edict_t *self)
         if (strcmp(self->goalentity->classname, "object_repair") == 0) {
             M_SetAnimation(self, &fixbot_move_weld_start);
         } else {
-            self->goalentity->nextthink = level.time + FRAME_TIME;
+            G_SetNextThink(self->goalentity, level.time + FRAME_TIME);
             self->goalentity->think = G_FreeEdict;
             self->goalentity = self->enemy = NULL;
             M_SetAnimation(self, &fixbot_move_stand);
@@ -404,7 +404,7 @@ static void fly_vertical(edict_t *self)
     M_ChangeYaw(self);
 
     if (self->s.frame == FRAME_landing_58 || self->s.frame == FRAME_takeoff_16) {
-        self->goalentity->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self->goalentity, level.time + FRAME_TIME);
         self->goalentity->think = G_FreeEdict;
         M_SetAnimation(self, &fixbot_move_stand);
         self->goalentity = self->enemy = NULL;
@@ -434,7 +434,7 @@ static void fly_vertical2(edict_t *self)
     M_ChangeYaw(self);
 
     if (len < 32) {
-        self->goalentity->nextthink = level.time + FRAME_TIME;
+        G_SetNextThink(self->goalentity, level.time + FRAME_TIME);
         self->goalentity->think = G_FreeEdict;
         M_SetAnimation(self, &fixbot_move_stand);
         self->goalentity = self->enemy = NULL;
@@ -1049,7 +1049,7 @@ static void fixbot_dead(edict_t *self)
     self->r.box = Box3_FromSize(16, -24, -8);
     self->movetype = MOVETYPE_TOSS;
     self->r.svflags |= SVF_DEADMONSTER;
-    self->nextthink = 0;
+    G_SetNextThink(self, 0);
     trap_LinkEntity(self);
 }
 #endif
@@ -643,7 +643,7 @@ static void fire_loogie(edict_t *self, vec3_t start, vec3_t dir, int damage, int
     loogie->s.renderfx |= RF_FULLBRIGHT;
     loogie->s.modelindex = G_ModelIndex("models/objects/loogy/tris.md2");
     loogie->touch = loogie_touch;
-    loogie->nextthink = level.time + SEC(2);
+    G_SetNextThink(loogie, level.time + SEC(2));
     loogie->think = G_FreeEdict;
     loogie->dmg = damage;
     trap_LinkEntity(loogie);
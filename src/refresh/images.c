@@ -1323,6 +1323,7 @@ static void make_screenshot(const char *name, const char *ext,
             .work_cb = screenshot_work_cb,
             .done_cb = screenshot_done_cb,
             .cb_arg = Z_CopyStruct(&s),
+            .priority = ASYNC_PRIO_LOW,
         };
         Com_QueueAsyncWork(&work);
     } else {
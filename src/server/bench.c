@@ -0,0 +1,731 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+//
+// bench.c -- headless server benchmark driven by recorded client input
+//
+
+#include "server.h"
+
+#define BENCH_MAGIC     MakeLittleLong('S','B','N','1')
+#define BENCH_VERSION   1
+
+#define BENCH_CMD_SIZE  14
+
+typedef enum {
+    BENCH_EV_END,
+    BENCH_EV_FRAME,         // server frame boundary
+    BENCH_EV_BEGIN,         // clientnum, userinfo
+    BENCH_EV_DROP,          // clientnum
+    BENCH_EV_USERINFO,      // clientnum, userinfo
+    BENCH_EV_MOVE,          // clientnum, usercmd
+    BENCH_EV_STRINGCMD,     // clientnum, string
+} bench_event_t;
+
+static const char *const bench_names[BENCH_NUM_STATS] = {
+    "game", "trace", "frame_build", "delta_encode", "netchan"
+};
+
+bench_stats_t   sv_bench;
+
+static struct {
+    qhandle_t   file;
+    bool        pending;        // waiting for map spawn
+    unsigned    frames;
+    char        name[MAX_OSPATH];
+    sizebuf_t   buf;
+    byte        data[MAX_MSGLEN];
+} rec;
+
+/*
+==============================================================================
+
+RECORDING
+
+==============================================================================
+*/
+
+static void flush_record(bool force)
+{
+    if (!rec.file)
+        return;
+    if (!force && rec.buf.cursize < rec.buf.maxsize / 2)
+        return;
+    if (FS_Write(rec.buf.data, rec.buf.cursize, rec.file) != rec.buf.cursize) {
+        Com_EPrintf("Couldn't write %s\n", rec.name);
+        FS_CloseFile(rec.file);
+        rec.file = 0;
+    }
+    SZ_Clear(&rec.buf);
+}
+
+static void stop_record(void)
+{
+    sv_bench.recording = false;
+
+    if (!rec.file)
+        return;
+
+    SZ_WriteByte(&rec.buf, BENCH_EV_END);
+    flush_record(true);
+
+    if (rec.file) {
+        FS_CloseFile(rec.file);
+        rec.file = 0;
+        Com_Printf("Stopped benchmark recording (%u frames).\n", rec.frames);
+    }
+}
+
+static void write_client_event(bench_event_t ev, const client_t *client)
+{
+    SZ_WriteByte(&rec.buf, ev);
+    SZ_WriteByte(&rec.buf, client->number);
+}
+
+static void write_header(void)
+{
+    const client_t *client;
+    int64_t realtime = sv_bench.realtime;
+
+    SZ_WriteLong(&rec.buf, BENCH_MAGIC);
+    SZ_WriteLong(&rec.buf, BENCH_VERSION);
+    SZ_WriteLong(&rec.buf, realtime);
+    SZ_WriteLong(&rec.buf, realtime >> 32);
+    SZ_WriteShort(&rec.buf, sv.frametime);
+    SZ_WriteByte(&rec.buf, svs.maxclients);
+    SZ_WriteString(&rec.buf, sv.mapcmd);
+
+    // write all CVAR_LATCH cvars, just like savegames do
+    for (cvar_t *var = cvar_vars; var; var = var->next) {
+        if (!(var->flags & CVAR_LATCH))
+            continue;
+        if (var->flags & CVAR_PRIVATE)
+            continue;
+        SZ_WriteString(&rec.buf, var->name);
+        SZ_WriteString(&rec.buf, var->string);
+    }
+    SZ_WriteString(&rec.buf, "");
+
+    // clients that are already in game
+    FOR_EACH_CLIENT(client) {
+        if (client->state != cs_spawned)
+            continue;
+        write_client_event(BENCH_EV_BEGIN, client);
+        SZ_WriteString(&rec.buf, client->userinfo);
+    }
+}
+
+/*
+==================
+SV_BenchSpawnServer
+
+Called after a new map has been spawned. Starts pending recording.
+==================
+*/
+void SV_BenchSpawnServer(void)
+{
+    if (!rec.file)
+        return;
+
+    if (!rec.pending) {
+        // map changed, stop the old recording
+        stop_record();
+        return;
+    }
+
+    if (sv.state != ss_game) {
+        Com_Printf("Not a game map, benchmark recording canceled.\n");
+        FS_CloseFile(rec.file);
+        rec.file = 0;
+        sv_bench.recording = false;
+        return;
+    }
+
+    rec.pending = false;
+    rec.frames = 0;
+
+    write_header();
+    flush_record(false);
+
+    Com_Printf("Benchmark recording started on %s.\n", sv.name);
+}
+
+void SV_BenchFrame(void)
+{
+    if (!rec.file || rec.pending)
+        return;
+
+    SZ_WriteByte(&rec.buf, BENCH_EV_FRAME);
+    rec.frames++;
+    flush_record(false);
+}
+
+void SV_BenchClientBegin(const client_t *client)
+{
+    if (!rec.file || rec.pending)
+        return;
+
+    write_client_event(BENCH_EV_BEGIN, client);
+    SZ_WriteString(&rec.buf, client->userinfo);
+}
+
+void SV_BenchClientDrop(const client_t *client)
+{
+    if (!rec.file || rec.pending)
+        return;
+
+    write_client_event(BENCH_EV_DROP, client);
+}
+
+void SV_BenchUserinfo(const client_t *client)
+{
+    if (!rec.file || rec.pending || client->state != cs_spawned)
+        return;
+
+    write_client_event(BENCH_EV_USERINFO, client);
+    SZ_WriteString(&rec.buf, client->userinfo);
+}
+
+void SV_BenchUsercmd(const client_t *client, const usercmd_t *cmd)
+{
+    byte *p;
+
+    if (!rec.file || rec.pending)
+        return;
+
+    write_client_event(BENCH_EV_MOVE, client);
+
+    p = SZ_GetSpace(&rec.buf, BENCH_CMD_SIZE);
+    p[0] = cmd->msec;
+    p[1] = cmd->buttons;
+    WL16(p +  2, cmd->angles[0]);
+    WL16(p +  4, cmd->angles[1]);
+    WL16(p +  6, cmd->angles[2]);
+    WL16(p +  8, cmd->forwardmove);
+    WL16(p + 10, cmd->sidemove);
+    WL16(p + 12, cmd->upmove);
+    // impulse and lightlevel don't fit, write them separately
+    SZ_WriteByte(&rec.buf, cmd->impulse);
+    SZ_WriteByte(&rec.buf, cmd->lightlevel);
+}
+
+void SV_BenchStringCmd(const client_t *client, const char *s)
+{
+    if (!rec.file || rec.pending || client->state != cs_spawned)
+        return;
+
+    write_client_event(BENCH_EV_STRINGCMD, client);
+    SZ_WriteString(&rec.buf, s);
+}
+
+/*
+==================
+SV_BenchRecord_f
+
+Arms benchmark recording and restarts the game on current map, so that
+recording starts from a freshly spawned level.
+==================
+*/
+static void SV_BenchRecord_f(void)
+{
+    char buffer[MAX_OSPATH];
+    qhandle_t f;
+
+    if (Cmd_Argc() != 2) {
+        Com_Printf("Usage: %s <name>\n", Cmd_Argv(0));
+        return;
+    }
+
+    if (rec.file) {
+        Com_Printf("Already recording %s.\n", rec.name);
+        return;
+    }
+
+    if (sv.state != ss_game) {
+        Com_Printf("No game map running.\n");
+        return;
+    }
+
+    f = FS_EasyOpenFile(buffer, sizeof(buffer), FS_MODE_WRITE,
+                        "bench/", Cmd_Argv(1), ".sbn");
+    if (!f)
+        return;
+
+    rec.file = f;
+    rec.pending = true;
+
+    // game seeds RNG from real time on restart, playback returns the same
+    sv_bench.recording = true;
+    sv_bench.realtime = Com_RealTime();
+    Q_strlcpy(rec.name, buffer, sizeof(rec.name));
+    SZ_InitWrite(&rec.buf, rec.data, sizeof(rec.data));
+
+    Com_Printf("Recording benchmark to %s.\n", buffer);
+
+    // restart the game
+    Cbuf_AddText(&cmd_buffer, va("map \"%s\" force\n", sv.mapcmd));
+}
+
+static void SV_BenchStop_f(void)
+{
+    if (!rec.file) {
+        Com_Printf("Not recording a benchmark.\n");
+        return;
+    }
+
+    if (rec.pending) {
+        FS_CloseFile(rec.file);
+        rec.file = 0;
+        sv_bench.recording = false;
+        Com_Printf("Benchmark recording canceled.\n");
+        return;
+    }
+
+    stop_record();
+}
+
+/*
+==============================================================================
+
+PLAYBACK
+
+==============================================================================
+*/
+
+static const char *read_string(sizebuf_t *sb)
+{
+    const byte *p = sb->data + sb->readcount;
+    const byte *end;
+
+    if (sb->readcount >= sb->cursize)
+        return NULL;
+
+    end = memchr(p, 0, sb->cursize - sb->readcount);
+    if (!end)
+        return NULL;
+
+    sb->readcount += end - p + 1;
+    return (const char *)p;
+}
+
+static client_t *bench_client(sizebuf_t *sb)
+{
+    int number = SZ_ReadByte(sb);
+
+    if (number < 0 || number >= svs.maxclients)
+        return NULL;
+
+    return &svs.client_pool[number];
+}
+
+static void bench_drop(client_t *cl)
+{
+    if (cl->state == cs_free)
+        return;
+
+    SV_DropClient(cl, NULL);
+    SV_RemoveClient(cl);
+}
+
+static void bench_connect(client_t *cl, const char *userinfo)
+{
+    static const netadr_t adr = { .type = NA_UNSPECIFIED };   // packets are discarded
+    const char *denied;
+    int number = cl->number;
+
+    bench_drop(cl);
+
+    memset(cl, 0, sizeof(*cl));
+    cl->number = number;
+    cl->protocol = PROTOCOL_VERSION_MINOR;
+    cl->has_zlib = USE_ZLIB;
+    cl->edict = SV_EdictForNum(number);
+    cl->client = SV_ClientForNum(number);
+    Q_strlcpy(cl->userinfo, userinfo, sizeof(cl->userinfo));
+
+    sv_client = cl;
+    denied = ge->ClientConnect(number);
+    sv_client = NULL;
+    if (denied) {
+        Com_WPrintf("Client %d refused: %s\n", number, denied);
+        cl->userinfo[0] = 0;
+        return;
+    }
+
+    Netchan_Setup(&cl->netchan, NS_SERVER, &adr, number, MAX_PACKETLEN_WRITABLE);
+    SV_UserinfoChanged(cl);
+    SV_RateInit(&cl->ratelimit_namechange, sv_namechange_limit->string);
+    SZ_InitWrite(&cl->datagram, SV_Mallocz(MAX_MSGLEN), MAX_MSGLEN);
+    List_SeqAdd(&sv_clientlist, &cl->entry);
+
+    cl->state = cs_assigned;
+    cl->framenum = 1;
+    cl->lastframe = -1;
+    cl->lastmessage = svs.realtime;
+    cl->lastactivity = svs.realtime;
+    cl->min_ping = 9999;
+
+    // go through the regular connection sequence
+    sv_client = cl;
+    SV_New_f();
+    SV_Begin_f();
+    sv_client = NULL;
+
+    // gamestate is never delivered
+    SZ_Clear(&cl->netchan.message);
+}
+
+// pretend every client has received and acknowledged everything
+static void bench_ack_clients(void)
+{
+    client_t *cl;
+
+    FOR_EACH_CLIENT(cl) {
+        if (cl->state != cs_spawned)
+            continue;
+        cl->lastframe = cl->netchan.outgoing_sequence - 1;
+        cl->frames_acked++;
+        cl->netchan.reliable_length = 0;
+        cl->netchan.fragment_pending = false;
+        cl->lastmessage = svs.realtime;
+    }
+}
+
+static void bench_run_frame(void)
+{
+    uint64_t start;
+
+    Nav_Frame();
+
+    start = SV_BenchBegin();
+    ge->RunFrame(sv.time);
+    SV_BenchEnd(BENCH_GAME, start);
+
+    SV_SendClientMessages();
+    bench_ack_clients();
+
+    start = SV_BenchBegin();
+    ge->PrepFrame();
+    SV_BenchEnd(BENCH_GAME, start);
+
+    sv.time += sv.frametime;
+    svs.realtime += sv.frametime;
+}
+
+static int compare_times(const void *p1, const void *p2)
+{
+    uint32_t a = *(const uint32_t *)p1;
+    uint32_t b = *(const uint32_t *)p2;
+    return a < b ? -1 : a > b;
+}
+
+static void write_results(const char *name, const uint32_t *times, unsigned frames,
+                          uint64_t total, int clients)
+{
+    char buffer[MAX_OSPATH];
+    qhandle_t f;
+    uint64_t game, sum;
+    int ret;
+
+    if (Q_concat(buffer, sizeof(buffer), "bench/", name, ".json") >= sizeof(buffer))
+        return;
+
+    FS_OpenFile(buffer, &f, FS_MODE_WRITE | FS_FLAG_TEXT);
+    if (!f)
+        return;
+
+    FS_FPrintf(f, "{\n");
+    FS_FPrintf(f, "  \"name\": \"%s\",\n", name);
+    FS_FPrintf(f, "  \"version\": \"%s\",\n", com_version->string);
+    FS_FPrintf(f, "  \"map\": \"%s\",\n", sv.name);
+    FS_FPrintf(f, "  \"frames\": %u,\n", frames);
+    FS_FPrintf(f, "  \"clients\": %d,\n", clients);
+    FS_FPrintf(f, "  \"total_usec\": %"PRIu64",\n", total);
+    FS_FPrintf(f, "  \"frame_usec\": {\"min\": %u, \"avg\": %"PRIu64", \"p50\": %u, \"p99\": %u, \"max\": %u},\n",
+               times[0], total / frames, times[frames / 2], times[frames * 99 / 100], times[frames - 1]);
+
+    // game time includes traces, split them
+    game = sv_bench.time[BENCH_GAME] - min(sv_bench.time[BENCH_GAME], sv_bench.time[BENCH_TRACE]);
+    sum = 0;
+    for (int i = 0; i < BENCH_NUM_STATS; i++)
+        sum += i == BENCH_GAME ? game : sv_bench.time[i];
+
+    FS_FPrintf(f, "  \"subsystems\": {\n");
+    for (int i = 0; i < BENCH_NUM_STATS; i++) {
+        FS_FPrintf(f, "    \"%s\": {\"usec\": %"PRIu64", \"calls\": %"PRIu64"},\n", bench_names[i],
+                   i == BENCH_GAME ? game : sv_bench.time[i], sv_bench.count[i]);
+    }
+    FS_FPrintf(f, "    \"other\": {\"usec\": %"PRIu64"}\n", total - min(total, sum));
+    FS_FPrintf(f, "  }\n}\n");
+
+    ret = FS_CloseFile(f);
+    if (ret < 0)
+        Com_EPrintf("Couldn't write %s: %s\n", buffer, Q_ErrorString(ret));
+    else
+        Com_Printf("Wrote %s.\n", buffer);
+}
+
+/*
+==================
+SV_BenchPlay_f
+
+Spawns recorded map, then replays recorded client input as fast as possible
+with timing enabled. Game is given fixed real time, so it is seeded the same
+way on every run.
+==================
+*/
+static void SV_BenchPlay_f(void)
+{
+    char buffer[MAX_OSPATH], name[MAX_QPATH];
+    const char *s, *var;
+    const byte *p;
+    sizebuf_t sb;
+    byte *data;
+    mapcmd_t cmd;
+    client_t *cl;
+    usercmd_t ucmd;
+    uint32_t *times;
+    unsigned frames, maxframes;
+    uint64_t start, total;
+    int len, clients, maxclients;
+    bench_event_t ev;
+
+    if (Cmd_Argc() < 2) {
+        Com_Printf("Usage: %s <name> [maxframes]\n", Cmd_Argv(0));
+        return;
+    }
+
+    if (rec.file) {
+        Com_Printf("Can't play benchmark while recording.\n");
+        return;
+    }
+
+    if (Q_concat(buffer, sizeof(buffer), "bench/", Cmd_Argv(1), ".sbn") >= sizeof(buffer)) {
+        Com_Printf("Oversize filename specified.\n");
+        return;
+    }
+
+    // not TAG_SERVER, SV_InitGame below checks it for leaks
+    len = FS_LoadFileEx(buffer, (void **)&data, 0, TAG_GENERAL);
+    if (!data) {
+        Com_Printf("Couldn't load %s: %s\n", buffer, Q_ErrorString(len));
+        return;
+    }
+
+    SZ_InitRead(&sb, data, len);
+    if (SZ_ReadLong(&sb) != BENCH_MAGIC || SZ_ReadLong(&sb) != BENCH_VERSION) {
+        Com_Printf("%s is not a benchmark file.\n", buffer);
+        goto done;
+    }
+
+    memset(&cmd, 0, sizeof(cmd));
+    sv_bench.realtime = (uint32_t)SZ_ReadLong(&sb);
+    sv_bench.realtime |= (int64_t)SZ_ReadLong(&sb) << 32;
+    SZ_ReadShort(&sb);  // recorded frametime, informational
+    maxclients = SZ_ReadByte(&sb);
+    s = read_string(&sb);
+    if (!s || Q_strlcpy(cmd.buffer, s, sizeof(cmd.buffer)) >= sizeof(cmd.buffer))
+        goto bad;
+
+    // restore CVAR_LATCH cvars
+    while (1) {
+        var = read_string(&sb);
+        if (!var)
+            goto bad;
+        if (!*var)
+            break;
+        s = read_string(&sb);
+        if (!s)
+            goto bad;
+        Cvar_UserSet(var, s);
+    }
+    Cvar_SetInteger(sv_maxclients, max(maxclients, 1), FROM_CODE);
+
+    if (!SV_ParseMapCmd(&cmd))
+        goto done;
+
+    // count frames
+    maxframes = Cmd_Argc() > 2 ? Q_atoi(Cmd_Argv(2)) : 0;
+    frames = 0;
+    for (p = sb.data + sb.readcount; p < sb.data + sb.cursize; p++) {
+        // upper bound, exact count is not important
+        if (*p == BENCH_EV_FRAME)
+            frames++;
+    }
+    if (maxframes > 0 && frames > maxframes)
+        frames = maxframes;
+    if (!frames)
+        goto bad;
+
+    // any error will drop from this point
+    sv_bench.active = true;
+    SV_InitGame();
+    SV_SpawnServer(&cmd);
+
+    Q_strlcpy(name, COM_SkipPath(Cmd_Argv(1)), sizeof(name));
+    times = SV_Malloc(sizeof(times[0]) * frames);
+    memset(sv_bench.time, 0, sizeof(sv_bench.time));
+    memset(sv_bench.count, 0, sizeof(sv_bench.count));
+
+    Com_Printf("Running benchmark %s...\n", name);
+
+    clients = 0;
+    total = 0;
+    start = Sys_Microseconds();
+    for (frames = 0; frames < maxframes || !maxframes; ) {
+        ev = SZ_ReadByte(&sb);
+        if (ev == BENCH_EV_END || ev == -1)
+            break;
+
+        switch (ev) {
+        case BENCH_EV_FRAME:
+            bench_run_frame();
+            times[frames] = Sys_Microseconds() - start;
+            total += times[frames];
+            frames++;
+            start = Sys_Microseconds();
+            break;
+
+        case BENCH_EV_BEGIN:
+            cl = bench_client(&sb);
+            s = read_string(&sb);
+            if (!cl || !s)
+                goto bad_event;
+            bench_connect(cl, s);
+            clients = max(clients, cl->number + 1);
+            break;
+
+        case BENCH_EV_DROP:
+            cl = bench_client(&sb);
+            if (!cl)
+                goto bad_event;
+            bench_drop(cl);
+            break;
+
+        case BENCH_EV_USERINFO:
+            cl = bench_client(&sb);
+            s = read_string(&sb);
+            if (!cl || !s)
+                goto bad_event;
+            if (cl->state != cs_spawned)
+                break;
+            Q_strlcpy(cl->userinfo, s, sizeof(cl->userinfo));
+            SV_UserinfoChanged(cl);
+            break;
+
+        case BENCH_EV_MOVE:
+            cl = bench_client(&sb);
+            if (!cl || SZ_Remaining(&sb) < BENCH_CMD_SIZE + 2)
+                goto bad_event;
+            p = SZ_ReadData(&sb, BENCH_CMD_SIZE);
+            ucmd.msec = p[0];
+            ucmd.buttons = p[1];
+            ucmd.angles[0] = RL16(p +  2);
+            ucmd.angles[1] = RL16(p +  4);
+            ucmd.angles[2] = RL16(p +  6);
+            ucmd.forwardmove = RL16(p +  8);
+            ucmd.sidemove = RL16(p + 10);
+            ucmd.upmove = RL16(p + 12);
+            ucmd.impulse = SZ_ReadByte(&sb);
+            ucmd.lightlevel = SZ_ReadByte(&sb);
+            if (cl->state != cs_spawned)
+                break;
+            cl->lastcmd = ucmd;
+            sv_client = cl;
+            {
+                uint64_t t = SV_BenchBegin();
+                ge->ClientThink(cl->number);
+                SV_BenchEnd(BENCH_GAME, t);
+            }
+            sv_client = NULL;
+            break;
+
+        case BENCH_EV_STRINGCMD:
+            cl = bench_client(&sb);
+            s = read_string(&sb);
+            if (!cl || !s)
+                goto bad_event;
+            if (cl->state != cs_spawned)
+                break;
+            Cmd_TokenizeString(s, false);
+            sv_client = cl;
+            ge->ClientCommand(cl->number);
+            sv_client = NULL;
+            break;
+
+        default:
+        bad_event:
+            Com_WPrintf("Bad benchmark event %d at offset %u\n", ev, sb.readcount);
+            goto finish;
+        }
+    }
+
+finish:
+    sv_bench.active = false;
+
+    FOR_EACH_CLIENT(cl) {
+        if (cl->netchan.remote_address.type == NA_UNSPECIFIED)
+            bench_drop(cl);
+    }
+
+    if (frames) {
+        qsort(times, frames, sizeof(times[0]), compare_times);
+        Com_Printf("%u frames, %d clients: %.3f sec, %.1f usec/frame\n",
+                   frames, clients, total * 1e-6, (double)total / frames);
+        write_results(name, times, frames, total, clients);
+    }
+
+    Z_Free(times);
+    goto done;
+
+bad:
+    Com_Printf("%s is corrupt.\n", buffer);
+done:
+    FS_FreeFile(sb.data);
+}
+
+static void SV_Bench_c(int firstarg, int argnum)
+{
+    if (argnum == 1)
+        FS_File_g("bench", ".sbn", FS_SEARCH_STRIPEXT);
+}
+
+void SV_BenchShutdown(error_type_t type)
+{
+    // game restart issued by benchrecord or benchplay
+    if (type == ERR_RECONNECT)
+        return;
+
+    if (rec.pending) {
+        FS_CloseFile(rec.file);
+        rec.file = 0;
+        rec.pending = false;
+    }
+    stop_record();
+    sv_bench.active = false;
+}
+
+static const cmdreg_t c_bench[] = {
+    { "benchrecord", SV_BenchRecord_f, SV_Bench_c },
+    { "benchstop", SV_BenchStop_f },
+    { "benchplay", SV_BenchPlay_f, SV_Bench_c },
+    { NULL }
+};
+
+void SV_RegisterBench(void)
+{
+    Cmd_Register(c_bench);
+}
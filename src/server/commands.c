@@ -737,6 +737,14 @@ static void SV_Serverinfo_f(void)
 
     Com_Printf("Server info settings:\n");
     Info_Print(serverinfo);
+
+    if (svs.initialized) {
+        const querycache_t *q = &svs.query;
+
+        Com_Printf("\nQuery replies (cached/built):\n");
+        Com_Printf("status  %u/%u\n", q->status_hits, q->status_builds);
+        Com_Printf("info    %u/%u\n", q->info_hits, q->info_builds);
+    }
 }
 
 void SV_PrintMiscInfo(void)
@@ -26,6 +26,24 @@ Encode a client frame onto the network channel
 =============================================================================
 */
 
+// what was written for each entity of the frame during the last emit pass
+typedef enum {
+    EMIT_KEEP,      // nothing to save by deferring
+    EMIT_DELTA,     // delta from the old frame
+    EMIT_NEW,       // delta from the baseline
+} emit_t;
+
+static struct {
+    byte        type[MAX_PACKET_ENTITIES];
+    int         bits[MAX_PACKET_ENTITIES];
+    unsigned    old[MAX_PACKET_ENTITIES];
+} emitted;
+
+static inline int write_pos(void)
+{
+    return msg_write.cursize * 8 + 32 - msg_write.bits_left;
+}
+
 /*
 =============
 SV_EmitPacketEntities
@@ -36,7 +54,7 @@ Writes a delta update of an entity_state_t list to the message.
 static void SV_EmitPacketEntities(client_t *client, const client_frame_t *from, const client_frame_t *to)
 {
     const entity_state_t *oldent, *newent;
-    int i, oldnum, newnum, oldindex, newindex, from_num_entities;
+    int i, oldnum, newnum, oldindex, newindex, from_num_entities, pos;
 
     if (!from)
         from_num_entities = 0;
@@ -69,7 +87,11 @@ static void SV_EmitPacketEntities(client_t *client, const client_frame_t *from,
             // not changed at all. Note that players are always 'newentities',
             // this updates their old_origin always and prevents warping in case
             // of packet loss.
+            pos = write_pos();
             MSG_WriteDeltaEntity(oldent, newent, false);
+            emitted.bits[newindex] = write_pos() - pos;
+            emitted.type[newindex] = emitted.bits[newindex] ? EMIT_DELTA : EMIT_KEEP;
+            emitted.old[newindex] = from->first_entity + oldindex;
             oldindex++;
             newindex++;
             continue;
@@ -83,7 +105,10 @@ static void SV_EmitPacketEntities(client_t *client, const client_frame_t *from,
             } else {
                 oldent = &nullEntityState;
             }
+            pos = write_pos();
             MSG_WriteDeltaEntity(oldent, newent, true);
+            emitted.bits[newindex] = write_pos() - pos;
+            emitted.type[newindex] = EMIT_NEW;
             newindex++;
             continue;
         }
@@ -134,6 +159,157 @@ static client_frame_t *get_last_frame(client_t *client)
     return frame;
 }
 
+/*
+==================
+frame_budget
+
+Returns how many bytes svc_frame message may take so that packet neither gets
+fragmented nor makes SV_RateDrop suppress following frames.
+==================
+*/
+static int frame_budget(const client_t *client)
+{
+    const netchan_t *chan = &client->netchan;
+    int i, extra, budget, total;
+
+    // reliable data and unreliable datagram share the packet
+    extra = Netchan_ReliableSize(chan) + client->datagram.cursize;
+
+    budget = chan->maxpacketlen - extra;
+    if (budget < MIN_PACKETLEN / 2)
+        return INT_MAX;     // packet will be fragmented anyway
+
+    if (!client->rate)
+        return budget;
+
+    // see SV_RateDrop, this frame replaces the oldest message
+    total = 0;
+    for (i = 0; i < RATE_MESSAGES; i++)
+        if (i != client->framenum % RATE_MESSAGES)
+            total += client->message_size[i];
+
+    total += extra + PACKET_HEADER;
+    if (total < client->rate)
+        budget = min(budget, client->rate - total);
+    else
+        budget = 0;
+
+    return budget;
+}
+
+typedef struct {
+    int     index;
+    float   priority;
+} candidate_t;
+
+static int candcmp(const void *p1, const void *p2)
+{
+    const candidate_t *c1 = p1;
+    const candidate_t *c2 = p2;
+
+    if (c1->priority < c2->priority)
+        return -1;
+    if (c1->priority > c2->priority)
+        return 1;
+    return c1->index - c2->index;
+}
+
+// higher priority entities are less likely to be deferred
+static float entity_priority(const client_t *client, const entity_state_t *s, const vec3_t org)
+{
+    float priority = 1.0f + client->deferred[s->number];
+
+    // players matter most
+    if (s->number < svs.maxclients)
+        priority *= 4.0f;
+    // things that can be seen or bumped into over sounds and triggers
+    else if (s->modelindex || s->solid)
+        priority *= 2.0f;
+
+    // nearby entities first
+    return priority * 512.0f / (512.0f + Vec3_Distance(org, s->origin));
+}
+
+static bool has_events(const entity_state_t *s)
+{
+    for (int i = 0; i < MAX_EVENTS; i++)
+        if (s->event[i])
+            return true;
+    return false;
+}
+
+/*
+==================
+defer_entities
+
+Picks lowest priority updates to hold back until `excess' bits are saved.
+Deferred deltas keep state the client already has, deferred new entities are
+left out of the frame, so that both are sent again in later frames. Returns
+false if nothing could be deferred.
+==================
+*/
+static bool defer_entities(client_t *client, client_frame_t *frame, int excess)
+{
+    static candidate_t cands[MAX_PACKET_ENTITIES];
+    static bool defer[MAX_PACKET_ENTITIES];
+    entity_state_t *state;
+    int i, j, count, deferred;
+    vec3_t org;
+
+    org = SV_GetClient_ViewOrg(client);
+
+    count = 0;
+    for (i = 0; i < frame->num_entities; i++) {
+        defer[i] = false;
+        if (emitted.type[i] == EMIT_KEEP)
+            continue;
+
+        state = &client->entities[(frame->first_entity + i) & PARSE_ENTITIES_MASK];
+
+        // events are not repeated and would be lost
+        if (has_events(state) || state->number == frame->ps.clientnum)
+            continue;
+
+        cands[count].index = i;
+        cands[count].priority = entity_priority(client, state, org);
+        count++;
+    }
+
+    qsort(cands, count, sizeof(cands[0]), candcmp);
+
+    for (i = deferred = 0; i < count && excess > 0; i++, deferred++) {
+        defer[cands[i].index] = true;
+        excess -= emitted.bits[cands[i].index];
+    }
+
+    if (!deferred)
+        return false;
+
+    // carry deferred updates forward, compact out deferred new entities
+    for (i = j = 0; i < frame->num_entities; i++) {
+        state = &client->entities[(frame->first_entity + i) & PARSE_ENTITIES_MASK];
+        if (defer[i]) {
+            if (client->deferred[state->number] < 255)
+                client->deferred[state->number]++;
+            if (emitted.type[i] == EMIT_NEW)
+                continue;
+            *state = client->entities[emitted.old[i] & PARSE_ENTITIES_MASK];
+        } else {
+            client->deferred[state->number] = 0;
+        }
+        if (i != j)
+            client->entities[(frame->first_entity + j) & PARSE_ENTITIES_MASK] = *state;
+        j++;
+    }
+
+    frame->num_entities = j;
+    client->next_entity = frame->first_entity + j;
+
+    SV_DPrintf(1, "Frame %d: deferred %d of %d entities for %s\n",
+               frame->number, deferred, count, client->name);
+    return true;
+}
+
 /*
 ==================
 SV_WriteFrameToClient
@@ -141,8 +317,10 @@ SV_WriteFrameToClient
 */
 void SV_WriteFrameToClient(client_t *client)
 {
-    const client_frame_t *frame, *oldframe;
-    int delta;
+    client_frame_t *frame;
+    const client_frame_t *oldframe;
+    int delta, budget;
+    sizebuf_t mark;
 
     // this is the frame we are creating
     frame = &client->frames[client->netchan.outgoing_sequence & UPDATE_MASK];
@@ -170,8 +348,23 @@ void SV_WriteFrameToClient(client_t *client)
     client->frameflags = 0;
 
     // delta encode the entities
+    mark = msg_write;
     SV_EmitPacketEntities(client, oldframe, frame);
     MSG_FlushBits();
+
+    if (!sv_entity_budget->integer || !client->deferred)
+        return;
+
+    // if it doesn't fit, hold some updates back and encode again
+    budget = frame_budget(client);
+    if (msg_write.cursize > budget &&
+        defer_entities(client, frame, (msg_write.cursize - budget) * 8)) {
+        msg_write.cursize = mark.cursize;
+        msg_write.bits_buf = mark.bits_buf;
+        msg_write.bits_left = mark.bits_left;
+        SV_EmitPacketEntities(client, oldframe, frame);
+        MSG_FlushBits();
+    }
 }
 
 /*
@@ -213,6 +406,209 @@ static bool SV_EntityAttenuatedAway(const edict_t *ent)
     return dist * mult > 1.0f;
 }
 
+typedef struct {
+    uint32_t        clientnum;
+    int             area;
+    const visrow_t  *pvs;
+    const visrow_t  *phs;
+} clientvis_t;
+
+static void SV_SetupClientVis(const client_t *client, clientvis_t *vis)
+{
+    const mleaf_t *leaf;
+
+    // find the client's PVS
+    clientorg = SV_GetClient_ViewOrg(client);
+
+    leaf = CM_PointLeaf(&sv.cm, clientorg);
+    vis->clientnum = client->client->ps.clientnum;
+    vis->area = leaf->area;
+    vis->pvs = CM_FatPVS(&sv.cm, clientorg);
+    vis->phs = BSP_ClusterVis(sv.cm.cache, leaf->cluster, DVIS_PHS);
+}
+
+static bool SV_EntityCulled(const clientvis_t *vis, const edict_t *ent)
+{
+    int e = ent->s.number;
+
+    // ignore ents without visible models
+    if (ent->r.svflags & SVF_NOCLIENT)
+        return true;
+
+    // ignore if not linked anywhere
+    if (!ent->r.linked && !(ent->r.svflags & SVF_NOCULL))
+        return true;
+
+    // ignore if pov number matches mask
+    if (ent->r.svflags & SVF_CLIENTMASK && vis->clientnum < MAX_CLIENTS
+        && Q_IsBitSet(ent->r.clientmask, vis->clientnum))
+        return true;
+
+    // ignore ents without visible models unless they have an effect
+    if (!SV_EntityHasEffects(ent))
+        return true;
+
+    // ignore if not touching a PV leaf
+    if (e != vis->clientnum && !sv_novis->integer && !(ent->r.svflags & SVF_NOCULL)) {
+        // check area
+        if (!CM_AreasConnected(&sv.cm, vis->area, ent->r.areanum)) {
+            // doors can legally straddle two areas, so
+            // we may need to check another one
+            if (!CM_AreasConnected(&sv.cm, vis->area, ent->r.areanum2)) {
+                return true;        // blocked by a door
+            }
+        }
+
+        if (ent->s.sound) {
+            if (!SV_EntityVisible(e, vis->phs))
+                return true;
+            // don't send sounds if they will be attenuated away
+            if (SV_EntityAttenuatedAway(ent)) {
+                if (!ent->s.modelindex)
+                    return true;
+                if (!(ent->r.svflags & SVF_PHS) && !SV_EntityVisible(e, vis->pvs))
+                    return true;
+            }
+        } else {
+            if (!SV_EntityVisible(e, (ent->r.svflags & SVF_PHS) ? vis->phs : vis->pvs))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+static void SV_CopyEntityState(entity_state_t *state, const edict_t *ent, uint32_t clientnum)
+{
+    *state = ent->s;
+
+    if (ent->s.number == clientnum) {
+        // don't waste bandwidth
+        state->origin = vec3_origin;
+        state->angles = vec3_origin;
+        state->old_origin = vec3_origin;
+    }
+    if (ent->r.ownernum == clientnum) {
+        // don't mark players missiles as solid
+        state->solid = 0;
+    }
+}
+
+/*
+=============
+SV_HoldClientEvents
+
+Called instead of SV_BuildClientFrame on frames client skips because of lower
+snapshot rate. Events last only a single frame, so save states of entities
+with events visible to the client for merging into the next frame sent.
+=============
+*/
+void SV_HoldClientEvents(client_t *client)
+{
+    static int      event_ents[MAX_EDICTS];
+    static int      num_event_ents;
+    static int64_t  event_time = -1;
+    static int      event_spawncount;
+    edict_t         *ent;
+    clientvis_t     vis;
+    int             i;
+
+    // find entities with events once per server frame
+    if (event_time != sv.time || event_spawncount != sv.spawncount) {
+        event_time = sv.time;
+        event_spawncount = sv.spawncount;
+        num_event_ents = 0;
+        for (i = 0; i < svs.num_edicts; i++) {
+            ent = SV_EdictForNum(i);
+            if (ent->r.inuse && has_events(&ent->s))
+                event_ents[num_event_ents++] = i;
+        }
+    }
+
+    if (!num_event_ents)
+        return;
+
+    SV_SetupClientVis(client, &vis);
+
+    for (i = 0; i < num_event_ents; i++) {
+        ent = SV_EdictForNum(event_ents[i]);
+        if (SV_EntityCulled(&vis, ent))
+            continue;
+
+        if (client->num_held_events == MAX_HELD_EVENTS) {
+            SV_DPrintf(1, "Too many held events for %s\n", client->name);
+            break;
+        }
+
+        SV_CopyEntityState(&client->held_events[client->num_held_events++], ent, vis.clientnum);
+    }
+}
+
+// events from different frames are distinct even if equal, so always append
+static void merge_events(const client_t *client, entity_state_t *to, const entity_state_t *from)
+{
+    int i, j = 0;
+
+    for (i = 0; i < MAX_EVENTS; i++) {
+        if (!from->event[i])
+            continue;
+        while (j < MAX_EVENTS && to->event[j])
+            j++;
+        if (j == MAX_EVENTS) {
+            SV_DPrintf(1, "Too many events on entity %d for %s\n", to->number, client->name);
+            break;
+        }
+        to->event[j] = from->event[i];
+        to->event_param[j] = from->event_param[i];
+    }
+}
+
+// merges held events into the frame, keeping it sorted by entity number
+static void SV_MergeHeldEvents(client_t *client, client_frame_t *frame)
+{
+    static entity_state_t merged[MAX_PACKET_ENTITIES];
+    entity_state_t *held = client->held_events, *state, tmp;
+    int i, j, n, count = client->num_held_events;
+
+    // insertion sort, preserves order of events of the same entity
+    for (i = 1; i < count; i++) {
+        tmp = held[i];
+        for (j = i; j > 0 && held[j - 1].number > tmp.number; j--)
+            held[j] = held[j - 1];
+        held[j] = tmp;
+    }
+
+    for (i = j = n = 0; n < MAX_PACKET_ENTITIES; ) {
+        state = NULL;
+        if (i < frame->num_entities)
+            state = &client->entities[(frame->first_entity + i) & PARSE_ENTITIES_MASK];
+
+        if (state && (j == count || state->number <= held[j].number)) {
+            merged[n++] = *state;
+            i++;
+        } else if (j < count) {
+            // entity still in frame or held from earlier frame
+            if (n && merged[n - 1].number == held[j].number)
+                merge_events(client, &merged[n - 1], &held[j]);
+            else
+                merged[n++] = held[j];
+            j++;
+        } else {
+            break;
+        }
+    }
+
+    if (j < count)
+        SV_DPrintf(1, "Dropped %d held events for %s\n", count - j, client->name);
+
+    for (i = 0; i < n; i++)
+        client->entities[(frame->first_entity + i) & PARSE_ENTITIES_MASK] = merged[i];
+
+    frame->num_entities = n;
+    client->next_entity = frame->first_entity + n;
+    client->num_held_events = 0;
+}
+
 /*
 =============
 SV_BuildClientFrame
@@ -226,11 +622,7 @@ void SV_BuildClientFrame(client_t *client)
     int         e;
     edict_t     *ent;
     client_frame_t  *frame;
-    entity_state_t  *state;
-    const mleaf_t   *leaf;
-    int             clientarea, clientcluster;
-    const visrow_t  *clientphs;
-    const visrow_t  *clientpvs;
+    clientvis_t     vis;
 
     Q_assert(client->entities);
 
@@ -242,22 +634,14 @@ void SV_BuildClientFrame(client_t *client)
 
     client->frames_sent++;
 
-    // find the client's PVS
-    clientorg = SV_GetClient_ViewOrg(client);
-
-    leaf = CM_PointLeaf(&sv.cm, clientorg);
-    clientarea = leaf->area;
-    clientcluster = leaf->cluster;
+    SV_SetupClientVis(client, &vis);
 
     // calculate the visible areas
-    frame->areabytes = CM_WriteAreaBits(&sv.cm, frame->areabits, clientarea);
+    frame->areabytes = CM_WriteAreaBits(&sv.cm, frame->areabits, vis.area);
 
     // grab the current player_state_t
     frame->ps = client->client->ps;
 
-    clientpvs = CM_FatPVS(&sv.cm, clientorg);
-    clientphs = BSP_ClusterVis(sv.cm.cache, clientcluster, DVIS_PHS);
-
     // build up the list of visible entities
     frame->num_entities = 0;
     frame->first_entity = client->next_entity;
@@ -271,64 +655,11 @@ void SV_BuildClientFrame(client_t *client)
 
         Q_assert_soft(ent->s.number == e);
 
-        // ignore ents without visible models
-        if (ent->r.svflags & SVF_NOCLIENT)
-            continue;
-
-        // ignore if not linked anywhere
-        if (!ent->r.linked && !(ent->r.svflags & SVF_NOCULL))
-            continue;
-
-        // ignore if pov number matches mask
-        if (ent->r.svflags & SVF_CLIENTMASK && frame->ps.clientnum < MAX_CLIENTS
-            && Q_IsBitSet(ent->r.clientmask, frame->ps.clientnum))
-            continue;
-
-        // ignore ents without visible models unless they have an effect
-        if (!SV_EntityHasEffects(ent))
+        if (SV_EntityCulled(&vis, ent))
             continue;
 
-        // ignore if not touching a PV leaf
-        if (e != frame->ps.clientnum && !sv_novis->integer && !(ent->r.svflags & SVF_NOCULL)) {
-            // check area
-            if (!CM_AreasConnected(&sv.cm, clientarea, ent->r.areanum)) {
-                // doors can legally straddle two areas, so
-                // we may need to check another one
-                if (!CM_AreasConnected(&sv.cm, clientarea, ent->r.areanum2)) {
-                    continue;        // blocked by a door
-                }
-            }
-
-            if (ent->s.sound) {
-                if (!SV_EntityVisible(e, clientphs))
-                    continue;
-                // don't send sounds if they will be attenuated away
-                if (SV_EntityAttenuatedAway(ent)) {
-                    if (!ent->s.modelindex)
-                        continue;
-                    if (!(ent->r.svflags & SVF_PHS) && !SV_EntityVisible(e, clientpvs))
-                        continue;
-                }
-            } else {
-                if (!SV_EntityVisible(e, (ent->r.svflags & SVF_PHS) ? clientphs : clientpvs))
-                    continue;
-            }
-        }
-
         // add it to the circular client_entities array
-        state = &client->entities[client->next_entity & PARSE_ENTITIES_MASK];
-        *state = ent->s;
-
-        if (e == frame->ps.clientnum) {
-            // don't waste bandwidth
-            state->origin = vec3_origin;
-            state->angles = vec3_origin;
-            state->old_origin = vec3_origin;
-        }
-        if (ent->r.ownernum == frame->ps.clientnum) {
-            // don't mark players missiles as solid
-            state->solid = 0;
-        }
+        SV_CopyEntityState(&client->entities[client->next_entity & PARSE_ENTITIES_MASK], ent, vis.clientnum);
 
         frame->num_entities++;
         client->next_entity++;
@@ -336,4 +667,8 @@ void SV_BuildClientFrame(client_t *client)
         if (frame->num_entities == MAX_PACKET_ENTITIES)
             break;
     }
+
+    // events from skipped frames go out with this one
+    if (client->num_held_events)
+        SV_MergeHeldEvents(client, frame);
 }
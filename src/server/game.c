@@ -144,6 +144,8 @@ static void PF_SetConfigstring(unsigned index, const char *val)
         memcpy(*dst, val, len + 1);
     }
 
+    SV_InvalidateConfigstring(index);
+
     if (sv.state == ss_loading)
         return;
 
@@ -253,6 +255,14 @@ static bool PF_ParseEntityString(char *buf, size_t size)
     return sv.entitystring;
 }
 
+// benchmark recording and playback give the game fixed time to seed RNG with
+static int64_t PF_RealTime(void)
+{
+    if (sv_bench.active || sv_bench.recording)
+        return sv_bench.realtime;
+    return Com_RealTime();
+}
+
 static bool PF_GetSurfaceInfo(unsigned surf_id, surface_info_t *info)
 {
     return BSP_GetSurfaceInfo(sv.cm.cache, surf_id, info);
@@ -389,6 +399,10 @@ VM_THUNK(BoxEdicts) {
     VM_U32(0) = SV_AreaEdicts(VM_BOX3(0), VM_PTR_CNT(1, int, VM_U32(2)), VM_U32(2), VM_U32(3));
 }
 
+VM_THUNK(RadiusEdicts) {
+    VM_U32(0) = SV_RadiusEdicts(VM_VEC3(0), VM_F32(1), VM_PTR_CNT(2, int, VM_U32(3)), VM_U32(3), VM_U32(4));
+}
+
 VM_THUNK(InVis) {
     VM_U32(0) = PF_InVis(VM_VEC3(0), VM_VEC3(1), VM_U32(2));
 }
@@ -470,7 +484,7 @@ VM_THUNK(GetPathToGoal) {
 }
 
 VM_THUNK(RealTime) {
-    VM_I64(0) = Com_RealTime();
+    VM_I64(0) = PF_RealTime();
 }
 
 VM_THUNK(LocalTime) {
@@ -623,6 +637,7 @@ static const vm_import_t game_vm_imports[] = {
     VM_IMPORT(Clip, "ii"),
     VM_IMPORT(PointContents, "i i"),
     VM_IMPORT(BoxEdicts, "i iiii"),
+    VM_IMPORT(RadiusEdicts, "i ifiii"),
     VM_IMPORT(InVis, "i iii"),
     VM_IMPORT(SetAreaPortalState, "ii"),
     VM_IMPORT(AreasConnected, "i ii"),
@@ -876,6 +891,7 @@ static const game_import_t game_dll_imports = {
     .Clip = SV_Clip,
     .PointContents = SV_PointContents,
     .BoxEdicts = SV_AreaEdicts,
+    .RadiusEdicts = SV_RadiusEdicts,
 
     .InVis = PF_InVis,
     .SetAreaPortalState = PF_SetAreaPortalState,
@@ -902,7 +918,7 @@ static const game_import_t game_dll_imports = {
     .LoadPathData = Nav_Load,
     .GetPathToGoal = Nav_GetPathToGoal,
 
-    .RealTime = Com_RealTime,
+    .RealTime = PF_RealTime,
     .LocalTime = Com_LocalTime,
 
     .Cvar_Register = PF_Cvar_Register,
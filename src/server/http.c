@@ -0,0 +1,766 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+//
+// http.c -- minimal HTTP/1.1 server for client downloads
+//
+
+#include "server.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <errno.h>
+#define USE_SENDFILE    1
+#else
+#define USE_SENDFILE    0
+#endif
+
+#define HTTP_RECV_SIZE      0x1000
+#define HTTP_SEND_SIZE      0x4000
+#define HTTP_MAX_REQUEST    0x1000
+#define HTTP_SENDFILE_CHUNK 0x40000
+
+typedef struct {
+    list_t      entry;
+    netadr_t    address;
+    int         refcount;
+    unsigned    time;
+    int64_t     credit;     // bytes this IP may send right now
+} http_peer_t;
+
+typedef struct {
+    list_t          entry;
+    netstream_t     stream;
+    http_peer_t     *peer;
+    unsigned        lastmessage;
+    bool            keepalive;
+    bool            closing;    // drop once send queue drains
+    qhandle_t       file;       // body being sent, if any
+    FILE            *raw;       // for zero-copy transfer
+    int64_t         rawofs;
+    int64_t         pos, end;   // remaining body range
+    size_t          reqlen;
+    char            request[HTTP_MAX_REQUEST];
+    byte            buffer[HTTP_RECV_SIZE + HTTP_SEND_SIZE];
+} http_client_t;
+
+static cvar_t   *sv_http_enable;
+static cvar_t   *sv_http_maxclients;
+static cvar_t   *sv_http_maxperip;
+static cvar_t   *sv_http_rate;
+static cvar_t   *sv_http_timeout;
+
+static list_t   http_clients;
+static list_t   http_peers;
+static int      http_numclients;
+static bool     http_listening;
+
+// only asset types clients are expected to download, never configs
+static const char http_extensions[][8] = {
+    "bsp", "ent", "filelist", "iqm", "jpg", "md2", "md3", "md5anim",
+    "md5mesh", "ogg", "pak", "pcx", "pkz", "png", "sp2", "tga", "wal", "wav"
+};
+
+/*
+==============================================================================
+
+PEERS
+
+==============================================================================
+*/
+
+static http_peer_t *get_peer(const netadr_t *address)
+{
+    http_peer_t *peer;
+
+    LIST_FOR_EACH(peer, &http_peers, entry)
+        if (NET_IsEqualBaseAdr(&peer->address, address))
+            goto found;
+
+    peer = SV_Mallocz(sizeof(*peer));
+    peer->address = *address;
+    peer->time = svs.realtime;
+    List_Append(&http_peers, &peer->entry);
+
+found:
+    peer->refcount++;
+    return peer;
+}
+
+static void put_peer(http_peer_t *peer)
+{
+    if (--peer->refcount == 0) {
+        List_Remove(&peer->entry);
+        Z_Free(peer);
+    }
+}
+
+// token bucket shared by all connections from the same IP
+static int64_t peer_credit(http_peer_t *peer)
+{
+    int64_t rate = sv_http_rate->integer * 1024LL;
+
+    if (rate <= 0)
+        return INT64_MAX;
+
+    peer->credit += (svs.realtime - peer->time) * rate / 1000;
+    peer->time = svs.realtime;
+    if (peer->credit > rate)
+        peer->credit = rate;
+
+    return peer->credit;
+}
+
+static void peer_consume(http_peer_t *peer, int64_t len)
+{
+    if (sv_http_rate->integer > 0)
+        peer->credit -= len;
+}
+
+/*
+==============================================================================
+
+CLIENTS
+
+==============================================================================
+*/
+
+static void close_body(http_client_t *c)
+{
+    if (c->file) {
+        FS_CloseFile(c->file);
+        c->file = 0;
+    }
+    c->raw = NULL;
+    c->pos = c->end = 0;
+}
+
+static void drop_client(http_client_t *c, const char *reason)
+{
+    if (reason)
+        SV_DPrintf(1, "HTTP: dropping %s: %s\n", NET_AdrToString(&c->stream.address), reason);
+
+    close_body(c);
+    NET_CloseStream(&c->stream);
+    put_peer(c->peer);
+    List_Remove(&c->entry);
+    Z_Free(c);
+    http_numclients--;
+}
+
+static void accept_client(const netstream_t *stream)
+{
+    http_client_t *c;
+    http_peer_t *peer;
+    netstream_t s = *stream;
+
+    if (http_numclients >= sv_http_maxclients->integer) {
+        SV_DPrintf(1, "HTTP: too many connections, rejecting %s\n", NET_AdrToString(&s.address));
+        NET_CloseStream(&s);
+        return;
+    }
+
+    peer = get_peer(&s.address);
+    if (peer->refcount > sv_http_maxperip->integer) {
+        SV_DPrintf(1, "HTTP: too many connections from %s\n", NET_AdrToString(&s.address));
+        put_peer(peer);
+        NET_CloseStream(&s);
+        return;
+    }
+
+    c = SV_Mallocz(sizeof(*c));
+    c->stream = s;
+    c->stream.recv.data = c->buffer;
+    c->stream.recv.size = HTTP_RECV_SIZE;
+    c->stream.send.data = c->buffer + HTTP_RECV_SIZE;
+    c->stream.send.size = HTTP_SEND_SIZE;
+    c->peer = peer;
+    c->lastmessage = svs.realtime;
+    List_Append(&http_clients, &c->entry);
+    http_numclients++;
+
+    SV_DPrintf(1, "HTTP: accepted %s\n", NET_AdrToString(&s.address));
+}
+
+/*
+==============================================================================
+
+RESPONSES
+
+==============================================================================
+*/
+
+static const char *status_text(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 206: return "Partial Content";
+    case 400: return "Bad Request";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 416: return "Range Not Satisfiable";
+    case 431: return "Request Header Fields Too Large";
+    case 505: return "HTTP Version Not Supported";
+    default:  return "Internal Server Error";
+    }
+}
+
+static void write_header(http_client_t *c, int status, int64_t length, const char *extra)
+{
+    char buf[MAX_STRING_CHARS];
+    size_t len;
+
+    len = Q_snprintf(buf, sizeof(buf),
+                     "HTTP/1.1 %d %s\r\n"
+                     "Server: %s\r\n"
+                     "Content-Length: %"PRId64"\r\n"
+                     "Connection: %s\r\n"
+                     "%s"
+                     "\r\n",
+                     status, status_text(status), com_version->string, length,
+                     c->keepalive ? "keep-alive" : "close", extra);
+
+    // send queue is always empty when starting a response
+    Q_assert(len < sizeof(buf));
+    FIFO_Write(&c->stream.send, buf, len);
+}
+
+static void send_error(http_client_t *c, int status, bool head)
+{
+    char body[MAX_QPATH];
+    size_t len;
+
+    SV_DPrintf(1, "HTTP: %s: %d\n", NET_AdrToString(&c->stream.address), status);
+
+    // don't trust state of the connection after malformed requests
+    if (status == 400 || status == 431 || status == 505)
+        c->keepalive = false;
+
+    len = Q_snprintf(body, sizeof(body), "%d %s\n", status, status_text(status));
+    write_header(c, status, len, status == 405 ? "Allow: GET, HEAD\r\n"
+                 "Content-Type: text/plain\r\n" : "Content-Type: text/plain\r\n");
+    if (!head)
+        FIFO_Write(&c->stream.send, body, len);
+
+    if (!c->keepalive)
+        c->closing = true;
+}
+
+/*
+==============================================================================
+
+REQUESTS
+
+==============================================================================
+*/
+
+static int hexdigit(int c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c = Q_tolower(c);
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+// decodes URL path into quake path and open mode, returns HTTP status
+static int decode_path(const char *s, char *path, size_t size, unsigned *mode)
+{
+    const char *game = *fs_game->string ? fs_game->string : BASEGAME;
+    char buf[MAX_OSPATH], *p, *ext;
+    size_t len = 0;
+    int hi, lo;
+
+    if (*s != '/')
+        return 400;
+
+    for (s++; *s && *s != '?' && *s != '#'; s++) {
+        int c = *s;
+        if (c == '%') {
+            if ((hi = hexdigit(s[1])) == -1 || (lo = hexdigit(s[2])) == -1)
+                return 400;
+            c = hi << 4 | lo;
+            s += 2;
+            if (!c)
+                return 400;
+        }
+        if (len >= sizeof(buf) - 1)
+            return 404;
+        buf[len++] = c;
+    }
+    buf[len] = 0;
+
+    // first component must be our game directory
+    len = strlen(game);
+    if (FS_pathcmpn(buf, game, len) || buf[len] != '/')
+        return 404;
+    p = buf + len + 1;
+
+    if (FS_NormalizePathBuffer(path, p, size) >= size)
+        return 404;
+
+    if (FS_ValidatePath(path) == PATH_INVALID || !Q_ispath(path[0]) ||
+        strstr(path, "..") || strstr(path, "/."))
+        return 403;
+
+    ext = COM_FileExtension(path);
+    if (*ext++ != '.')
+        return 403;
+
+    // never serve packs from base directories, these are commercial data.
+    // FS_PATH_GAME has no effect without a mod, so refuse them outright.
+    *mode = FS_MODE_READ;
+    if (!Q_strcasecmp(ext, "pak") || !Q_strcasecmp(ext, "pkz")) {
+        if (!*fs_game->string)
+            return 403;
+        *mode |= FS_PATH_GAME;
+    }
+
+    for (int i = 0; i < q_countof(http_extensions); i++)
+        if (!Q_strcasecmp(ext, http_extensions[i]))
+            return 200;
+
+    return 403;
+}
+
+// parses single byte range, returns HTTP status
+static int parse_range(const char *s, int64_t length, int64_t *start, int64_t *end)
+{
+    char *p;
+    int64_t a, b;
+
+    if (Q_strncasecmp(s, "bytes=", 6))
+        return 200;
+    s += 6;
+
+    // multiple ranges are not supported, send entire file
+    if (strchr(s, ','))
+        return 200;
+
+    if (*s == '-') {
+        // suffix range
+        b = strtoll(s + 1, &p, 10);
+        if (p == s + 1 || *p || b < 0)
+            return 200;
+        if (!b)
+            return 416;
+        *start = max(length - b, 0);
+        *end = length;
+        return 206;
+    }
+
+    a = strtoll(s, &p, 10);
+    if (p == s || *p != '-' || a < 0)
+        return 200;
+    s = p + 1;
+
+    if (!*s) {
+        b = length - 1;
+    } else {
+        b = strtoll(s, &p, 10);
+        if (*p || b < a)
+            return 200;
+    }
+
+    if (a >= length)
+        return 416;
+
+    *start = a;
+    *end = min(b, length - 1) + 1;
+    return 206;
+}
+
+static void handle_request(http_client_t *c, char *request)
+{
+    char *line, *next, *method, *target, *version, *range = NULL;
+    char path[MAX_QPATH], extra[MAX_QPATH * 2];
+    int64_t length, start, end;
+    qhandle_t f;
+    unsigned mode;
+    bool head;
+    int status;
+
+    // request line
+    next = strstr(request, "\r\n");
+    *next = 0;
+    next += 2;
+
+    method = request;
+    target = strchr(method, ' ');
+    if (!target) {
+        send_error(c, 400, false);
+        return;
+    }
+    *target++ = 0;
+    version = strchr(target, ' ');
+    if (!version) {
+        send_error(c, 400, false);
+        return;
+    }
+    *version++ = 0;
+
+    head = !strcmp(method, "HEAD");
+
+    if (!strcmp(version, "HTTP/1.1")) {
+        c->keepalive = true;
+    } else if (!strcmp(version, "HTTP/1.0")) {
+        c->keepalive = false;
+    } else {
+        send_error(c, 505, head);
+        return;
+    }
+
+    // header fields
+    for (line = next; *line; line = next) {
+        char *value;
+
+        next = strstr(line, "\r\n");
+        *next = 0;
+        next += 2;
+
+        value = strchr(line, ':');
+        if (!value) {
+            send_error(c, 400, head);
+            return;
+        }
+        *value++ = 0;
+        while (*value == ' ' || *value == '\t')
+            value++;
+
+        if (!Q_strcasecmp(line, "Connection")) {
+            if (Q_stristr(value, "close"))
+                c->keepalive = false;
+            else if (Q_stristr(value, "keep-alive"))
+                c->keepalive = true;
+        } else if (!Q_strcasecmp(line, "Range")) {
+            range = value;
+        }
+    }
+
+    if (!head && strcmp(method, "GET")) {
+        send_error(c, 405, false);
+        return;
+    }
+
+    status = decode_path(target, path, sizeof(path), &mode);
+    if (status != 200) {
+        send_error(c, status, head);
+        return;
+    }
+
+    length = FS_OpenFile(path, &f, mode);
+    if (!f) {
+        send_error(c, 404, head);
+        return;
+    }
+
+    start = 0;
+    end = length;
+    if (range)
+        status = parse_range(range, length, &start, &end);
+
+    if (status == 416) {
+        FS_CloseFile(f);
+        Q_snprintf(extra, sizeof(extra), "Content-Range: bytes */%"PRId64"\r\n", length);
+        write_header(c, 416, 0, extra);
+        if (!c->keepalive)
+            c->closing = true;
+        return;
+    }
+
+    if (status == 206)
+        Q_snprintf(extra, sizeof(extra),
+                   "Content-Range: bytes %"PRId64"-%"PRId64"/%"PRId64"\r\n"
+                   "Content-Type: application/octet-stream\r\n",
+                   start, end - 1, length);
+    else
+        Q_strlcpy(extra, "Accept-Ranges: bytes\r\n"
+                  "Content-Type: application/octet-stream\r\n", sizeof(extra));
+
+    SV_DPrintf(1, "HTTP: %s: %s %s: %d [%"PRId64"-%"PRId64"]\n",
+               NET_AdrToString(&c->stream.address), method, path, status, start, end);
+
+    write_header(c, status, end - start, extra);
+
+    if (head || start == end) {
+        FS_CloseFile(f);
+        if (!c->keepalive)
+            c->closing = true;
+        return;
+    }
+
+    c->file = f;
+    c->pos = start;
+    c->end = end;
+#if USE_SENDFILE
+    c->raw = FS_RawFile(f, &c->rawofs);
+    if (c->raw)
+        return;
+#endif
+    if (start && FS_Seek(f, start, SEEK_SET)) {
+        close_body(c);
+        c->keepalive = false;
+        c->closing = true;
+    }
+}
+
+static void parse_requests(http_client_t *c)
+{
+    char *p;
+    size_t len;
+
+    // one request at a time, after previous response has been sent
+    while (!c->file && !c->closing && !FIFO_Usage(&c->stream.send)) {
+        p = strstr(c->request, "\r\n\r\n");
+        if (!p) {
+            if (c->reqlen == sizeof(c->request) - 1) {
+                send_error(c, 431, false);
+                c->reqlen = 0;
+            }
+            break;
+        }
+
+        p[2] = 0;   // keep the last CRLF for header parsing
+        len = p + 4 - c->request;
+        handle_request(c, c->request);
+
+        c->reqlen -= len;
+        memmove(c->request, c->request + len, c->reqlen);
+        c->request[c->reqlen] = 0;
+    }
+}
+
+/*
+==============================================================================
+
+BODY
+
+==============================================================================
+*/
+
+static bool send_body(http_client_t *c)
+{
+    int64_t credit = peer_credit(c->peer);
+    size_t len;
+    void *data;
+    int ret;
+
+#if USE_SENDFILE
+    if (c->raw) {
+        struct pollfd *e = c->stream.socket;
+        off_t offset = c->rawofs + c->pos;
+
+        // headers and such must get out first
+        if (FIFO_Usage(&c->stream.send) || !(e->revents & POLLOUT) || credit <= 0)
+            return true;
+
+        len = min(c->end - c->pos, min(credit, HTTP_SENDFILE_CHUNK));
+        ret = sendfile(e->fd, fileno(c->raw), &offset, len);
+        if (ret < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                e->revents &= ~POLLOUT;
+                return true;
+            }
+            drop_client(c, strerror(errno));
+            return false;
+        }
+        if (!ret) {
+            drop_client(c, "file truncated");
+            return false;
+        }
+        c->pos += ret;
+        c->lastmessage = svs.realtime;
+        peer_consume(c->peer, ret);
+    } else
+#endif
+    // stream file contents through the send queue
+    while (c->pos < c->end && credit > 0) {
+        data = FIFO_Reserve(&c->stream.send, &len);
+        if (!len)
+            break;
+        len = min(len, min(c->end - c->pos, credit));
+        ret = FS_Read(data, len, c->file);
+        if (ret <= 0) {
+            drop_client(c, ret ? Q_ErrorString(ret) : "file truncated");
+            return false;
+        }
+        FIFO_Commit(&c->stream.send, ret);
+        c->pos += ret;
+        credit -= ret;
+        peer_consume(c->peer, ret);
+    }
+
+    if (c->pos == c->end) {
+        close_body(c);
+        if (!c->keepalive)
+            c->closing = true;
+    }
+
+    return true;
+}
+
+static void run_client(http_client_t *c)
+{
+    neterr_t ret;
+    size_t len, pending;
+
+    pending = FIFO_Usage(&c->stream.send);
+
+    ret = NET_RunStream(&c->stream);
+    if (ret == NET_ERROR) {
+        drop_client(c, NET_ErrorString());
+        return;
+    }
+    if (ret == NET_CLOSED) {
+        drop_client(c, NULL);
+        return;
+    }
+
+    if (ret == NET_OK || FIFO_Usage(&c->stream.send) < pending)
+        c->lastmessage = svs.realtime;
+
+    // move received data into linear request buffer
+    len = FIFO_Read(&c->stream.recv, c->request + c->reqlen,
+                    sizeof(c->request) - 1 - c->reqlen);
+    c->reqlen += len;
+    c->request[c->reqlen] = 0;
+
+    parse_requests(c);
+
+    if (c->file && !send_body(c))
+        return;
+
+    if (c->closing && !FIFO_Usage(&c->stream.send)) {
+        drop_client(c, NULL);
+        return;
+    }
+
+    if (svs.realtime - c->lastmessage > sv_http_timeout->integer * 1000U) {
+        drop_client(c, "timed out");
+        return;
+    }
+
+    NET_UpdateStream(&c->stream);
+
+    // wake up when socket becomes writable for zero-copy transfer
+    if (c->raw && peer_credit(c->peer) > 0)
+        c->stream.socket->events |= POLLOUT;
+}
+
+/*
+==================
+SV_HttpRun
+
+Accepts new connections and services existing ones. Called each time
+NET_Sleep returns, so transfers are not bound to server framerate.
+==================
+*/
+void SV_HttpRun(void)
+{
+    http_client_t *c, *next;
+    netstream_t stream;
+    neterr_t ret;
+
+    if (!http_listening)
+        return;
+
+    while ((ret = NET_Accept(&stream)) == NET_OK)
+        accept_client(&stream);
+
+    if (ret == NET_ERROR)
+        Com_DPrintf("HTTP: accept failed: %s\n", NET_ErrorString());
+
+    LIST_FOR_EACH_SAFE(c, next, &http_clients, entry)
+        run_client(c);
+}
+
+/*
+==================
+SV_HttpAddress
+
+Returns download URL prefix pointing to this server, if known.
+==================
+*/
+const char *SV_HttpAddress(void)
+{
+    static char buffer[MAX_QPATH];
+
+    if (!http_listening || !*net_ip->string)
+        return NULL;
+
+    Q_snprintf(buffer, sizeof(buffer), "http://%s:%d/", net_ip->string, net_port->integer);
+    return buffer;
+}
+
+void SV_HttpShutdown(void)
+{
+    http_client_t *c, *next;
+
+    LIST_FOR_EACH_SAFE(c, next, &http_clients, entry)
+        drop_client(c, NULL);
+
+    if (http_listening) {
+        NET_Listen(false);
+        http_listening = false;
+    }
+}
+
+void SV_HttpStart(void)
+{
+    neterr_t ret;
+
+    if (!sv_http_enable->integer) {
+        SV_HttpShutdown();
+        return;
+    }
+
+    if (http_listening || !svs.initialized)
+        return;
+
+    ret = NET_Listen(true);
+    if (ret == NET_OK) {
+        http_listening = true;
+        Com_Printf("HTTP server listening on TCP port %d\n", net_port->integer);
+    } else if (ret == NET_ERROR) {
+        Com_EPrintf("Couldn't start HTTP server: %s\n", NET_ErrorString());
+    }
+}
+
+static void sv_http_enable_changed(cvar_t *self)
+{
+    SV_HttpStart();
+}
+
+void SV_RegisterHttp(void)
+{
+    List_Init(&http_clients);
+    List_Init(&http_peers);
+
+    sv_http_enable = Cvar_Get("sv_http_enable", "0", 0);
+    sv_http_enable->changed = sv_http_enable_changed;
+    sv_http_maxclients = Cvar_Get("sv_http_maxclients", "16", 0);
+    sv_http_maxperip = Cvar_Get("sv_http_maxperip", "4", 0);
+    sv_http_rate = Cvar_Get("sv_http_rate", "1024", 0);
+    sv_http_timeout = Cvar_Get("sv_http_timeout", "30", 0);
+}
@@ -111,6 +111,7 @@ void SV_SpawnServer(const mapcmd_t *cmd)
     SV_SendAsyncPackets();
 
     // free current level
+    SV_FreeGamestate();
     for (int i = 0; i < MAX_CONFIGSTRINGS; i++)
         Z_Free(sv.configstrings[i]);
     for (int i = 0; i < MAX_EDICTS; i++)
@@ -167,6 +168,9 @@ void SV_SpawnServer(const mapcmd_t *cmd)
     // all precaches are complete
     SV_SetState(cmd->state);
 
+    // start pending benchmark recording
+    SV_BenchSpawnServer();
+
     // set serverinfo variable
     SV_InfoSet("mapname", sv.name);
     SV_InfoSet("port", net_port->string);
@@ -399,4 +403,10 @@ void SV_InitGame(void)
     }
 
     svs.initialized = true;
+
+    // start serving downloads if enabled
+    SV_HttpStart();
+
+    // hand server sockets over to receive threads if enabled
+    SV_StartNetThreads();
 }
@@ -46,6 +46,9 @@ cvar_t  *sv_reserved_password;
 cvar_t  *sv_show_name_changes;
 
 cvar_t  *sv_novis;
+cvar_t  *sv_entity_budget;
+cvar_t  *sv_min_snaps;
+cvar_t  *sv_max_snaps;
 
 cvar_t  *sv_maxclients;
 cvar_t  *sv_reserved_slots;
@@ -118,6 +121,8 @@ void SV_CleanClient(client_t *client)
 
     // free packet entities
     Z_Freep(&client->entities);
+    Z_Freep(&client->deferred);
+    Z_Freep(&client->held_events);
 
     // free datagram
     Z_Free(client->datagram.data);
@@ -176,6 +181,9 @@ void SV_DropClient(client_t *client, const char *reason)
     client->state = cs_zombie;        // become free in a few seconds
     client->lastmessage = svs.realtime;
 
+    if (oldstate == cs_spawned)
+        SV_BenchClientDrop(client);
+
     // call the prog function for removing a client
     // this will remove the body, among other things
     ge->ClientDisconnect(client->number);
@@ -213,8 +221,20 @@ kernel. Returns true if limit is exceeded.
 */
 bool SV_RateLimited(ratelimit_t *r)
 {
-    r->credit += (svs.realtime - r->time) * CREDITS_PER_MSEC;
-    r->time = svs.realtime;
+    return SV_RateLimitedAt(r, svs.realtime);
+}
+
+/*
+===============
+SV_RateLimitedAt
+
+Same as above, but with explicit time base for use outside of main thread.
+===============
+*/
+bool SV_RateLimitedAt(ratelimit_t *r, unsigned time)
+{
+    r->credit += (time - r->time) * CREDITS_PER_MSEC;
+    r->time = time;
     if (r->credit > r->credit_cap)
         r->credit = r->credit_cap;
 
@@ -411,6 +431,57 @@ static size_t SV_StatusString(char *status)
     return total;
 }
 
+/*
+================
+SV_InvalidateQueryCache
+
+Makes status and info replies rebuilt on next request. Called once per
+frame and when something they show changes.
+================
+*/
+void SV_InvalidateQueryCache(void)
+{
+    svs.query.status_len = 0;
+    svs.query.info_len = 0;
+    svs.query.generation++;
+}
+
+static void build_status_reply(void)
+{
+    querycache_t *q = &svs.query;
+
+    // write the packet header
+    memcpy(q->status, "\xff\xff\xff\xffprint\n", 10);
+    q->status_len = 10 + SV_StatusString(q->status + 10);
+    q->status_builds++;
+}
+
+static void build_info_reply(void)
+{
+    querycache_t *q = &svs.query;
+
+    q->info_len = Q_scnprintf(q->info, sizeof(q->info),
+                              "\xff\xff\xff\xffinfo\n%16s %8s %2i/%2i\n",
+                              sv_hostname->string, sv.name, SV_CountClients(),
+                              svs.maxclients_soft);
+    q->info_builds++;
+}
+
+/*
+================
+SV_BuildQueryCache
+
+Makes sure both cached replies are valid.
+================
+*/
+void SV_BuildQueryCache(void)
+{
+    if (!svs.query.status_len)
+        build_status_reply();
+    if (!svs.query.info_len)
+        build_info_reply();
+}
+
 /*
 ================
 SVC_Status
@@ -420,8 +491,7 @@ Responds with all the info that qplug or qspy can see
 */
 static void SVC_Status(void)
 {
-    char    buffer[MAX_PACKETLEN_DEFAULT];
-    size_t  len;
+    querycache_t *q = &svs.query;
 
     if (!sv_status_show->integer) {
         return;
@@ -433,14 +503,13 @@ static void SVC_Status(void)
         return;
     }
 
-    // write the packet header
-    memcpy(buffer, "\xff\xff\xff\xffprint\n", 10);
-    len = 10;
-
-    len += SV_StatusString(buffer + len);
+    if (q->status_len)
+        q->status_hits++;
+    else
+        build_status_reply();
 
     // send the datagram
-    NET_SendPacket(NS_SERVER, buffer, len, &net_from);
+    NET_SendPacket(NS_SERVER, q->status, q->status_len, &net_from);
 }
 
 /*
@@ -473,8 +542,7 @@ The second parameter should be the current protocol version number.
 */
 static void SVC_Info(void)
 {
-    char    buffer[MAX_QPATH+10];
-    size_t  len;
+    querycache_t *q = &svs.query;
     int     version;
 
     if (svs.maxclients == 1)
@@ -484,12 +552,12 @@ static void SVC_Info(void)
     if (version != PROTOCOL_VERSION_MAJOR)
         return; // ignore invalid versions
 
-    len = Q_scnprintf(buffer, sizeof(buffer),
-                      "\xff\xff\xff\xffinfo\n%16s %8s %2i/%2i\n",
-                      sv_hostname->string, sv.name, SV_CountClients(),
-                      svs.maxclients_soft);
+    if (q->info_len)
+        q->info_hits++;
+    else
+        build_info_reply();
 
-    NET_SendPacket(NS_SERVER, buffer, len, &net_from);
+    NET_SendPacket(NS_SERVER, q->info, q->info_len, &net_from);
 }
 
 /*
@@ -506,19 +574,15 @@ static void SVC_Ping(void)
 
 /*
 =================
-SVC_GetChallenge
+SV_AddChallenge
 
-Returns a challenge number that can be used
-in a subsequent client_connect command.
-We do this to prevent denial of service attacks that
-flood the server with invalid connection IPs.  With a
-challenge, they must give a valid IP address.
+Remembers challenge number given to the address, replacing the oldest one
+if the table is full. Caller must hold the challenge lock.
 =================
 */
-static void SVC_GetChallenge(void)
+void SV_AddChallenge(const netadr_t *adr, unsigned challenge, unsigned time)
 {
     int         i, oldest;
-    unsigned    challenge;
     unsigned    oldestTime;
 
     oldest = 0;
@@ -526,10 +590,10 @@ static void SVC_GetChallenge(void)
 
     // see if we already have a challenge for this ip
     for (i = 0; i < MAX_CHALLENGES; i++) {
-        if (NET_IsEqualBaseAdr(&net_from, &svs.challenges[i].adr))
+        if (NET_IsEqualBaseAdr(adr, &svs.challenges[i].adr))
             break;
-        if (svs.challenges[i].time > com_eventTime) {
-            svs.challenges[i].time = com_eventTime;
+        if (svs.challenges[i].time > time) {
+            svs.challenges[i].time = time;
         }
         if (svs.challenges[i].time < oldestTime) {
             oldestTime = svs.challenges[i].time;
@@ -537,16 +601,37 @@ static void SVC_GetChallenge(void)
         }
     }
 
-    challenge = Q_rand() & INT_MAX;
     if (i == MAX_CHALLENGES) {
         // overwrite the oldest
         svs.challenges[oldest].challenge = challenge;
-        svs.challenges[oldest].adr = net_from;
-        svs.challenges[oldest].time = com_eventTime;
+        svs.challenges[oldest].adr = *adr;
+        svs.challenges[oldest].time = time;
     } else {
         svs.challenges[i].challenge = challenge;
-        svs.challenges[i].time = com_eventTime;
+        svs.challenges[i].time = time;
     }
+}
+
+/*
+=================
+SVC_GetChallenge
+
+Returns a challenge number that can be used
+in a subsequent client_connect command.
+We do this to prevent denial of service attacks that
+flood the server with invalid connection IPs.  With a
+challenge, they must give a valid IP address.
+=================
+*/
+static void SVC_GetChallenge(void)
+{
+    unsigned    challenge;
+
+    challenge = Q_rand() & INT_MAX;
+
+    SV_LockChallenges();
+    SV_AddChallenge(&net_from, challenge, com_eventTime);
+    SV_UnlockChallenges();
 
     // send it back
     Netchan_OutOfBand(NS_SERVER, &net_from,
@@ -628,28 +713,32 @@ static bool permit_connection(conn_params_t *p)
     int i, count;
     client_t *cl;
     const char *s;
+    bool good;
 
     // loopback clients are permitted without any checks
     if (NET_IsLocalAddress(&net_from))
         return true;
 
     // see if the challenge is valid
+    SV_LockChallenges();
     for (i = 0; i < MAX_CHALLENGES; i++) {
         if (!svs.challenges[i].challenge)
             continue;
 
-        if (NET_IsEqualBaseAdr(&net_from, &svs.challenges[i].adr)) {
-            if (svs.challenges[i].challenge == p->challenge)
-                break;        // good
-
-            return reject("Bad challenge.\n");
-        }
+        if (NET_IsEqualBaseAdr(&net_from, &svs.challenges[i].adr))
+            break;
     }
 
+    good = i < MAX_CHALLENGES && svs.challenges[i].challenge == p->challenge;
+    if (good)
+        svs.challenges[i].challenge = 0;
+    SV_UnlockChallenges();
+
     if (i == MAX_CHALLENGES)
         return reject("No challenge for address.\n");
 
-    svs.challenges[i].challenge = 0;
+    if (!good)
+        return reject("Bad challenge.\n");
 
     // check for banned address
     if ((match = SV_MatchAddress(&sv_banlist, &net_from)) != NULL) {
@@ -796,6 +885,10 @@ static void send_connect_packet(client_t *newcl)
     if (sv_downloadserver->string[0]) {
         dlstring1 = " dlserver=";
         dlstring2 = sv_downloadserver->string;
+    } else if ((dlstring2 = SV_HttpAddress())) {
+        dlstring1 = " dlserver=";
+    } else {
+        dlstring2 = "";
     }
 
     Netchan_OutOfBand(NS_SERVER, &net_from, "client_connect%s%s map=%s",
@@ -1563,6 +1656,12 @@ unsigned SV_Frame(unsigned msec)
     // read packets from UDP clients
     NET_GetPackets(NS_SERVER, SV_PacketEvent);
 
+    // read packets passed on by receive threads
+    SV_NetThreadRun(SV_PacketEvent);
+
+    // serve HTTP downloads
+    SV_HttpRun();
+
     if (svs.initialized) {
         // deliver fragments and reliable messages for connecting clients
         SV_SendAsyncPackets();
@@ -1574,6 +1673,9 @@ unsigned SV_Frame(unsigned msec)
         return sv.frametime - sv.frameresidual;
     }
 
+    // status replies may change once per frame
+    SV_InvalidateQueryCache();
+
     if (svs.initialized && !check_paused()) {
         // check timeouts
         SV_CheckTimeouts();
@@ -1584,6 +1686,8 @@ unsigned SV_Frame(unsigned msec)
         // give the clients some timeslices
         SV_GiveMsec();
 
+        SV_BenchFrame();
+
         Nav_Frame();
 
         // let everything in the world think and move
@@ -1642,6 +1746,9 @@ void SV_UserinfoChanged(client_t *cl)
     // call prog code to allow overrides
     ge->ClientUserinfoChanged(cl->number);
 
+    // name may have changed
+    SV_InvalidateQueryCache();
+
     // name for C code
     val = Info_ValueForKey(cl->userinfo, "name");
     len = Q_strlcpy(name, val, sizeof(name));
@@ -1671,6 +1778,10 @@ void SV_UserinfoChanged(client_t *cl)
         cl->rate = 5000;
     }
 
+    // snaps command
+    val = Info_ValueForKey(cl->userinfo, "snaps");
+    cl->snaps = max(Q_atoi(val), 0);
+
     // never drop over the loopback
     if (NET_IsLocalAddress(&cl->netchan.remote_address)) {
         cl->rate = 0;
@@ -1789,6 +1900,9 @@ void SV_Init(void)
     SV_InitOperatorCommands();
 
     SV_RegisterSavegames();
+    SV_RegisterBench();
+    SV_RegisterHttp();
+    SV_RegisterNetThreads();
 
     Nav_Register();
 
@@ -1827,6 +1941,9 @@ void SV_Init(void)
     sv_reserved_password = Cvar_Get("sv_reserved_password", "", CVAR_PRIVATE);
     sv_locked = Cvar_Get("sv_locked", "0", 0);
     sv_novis = Cvar_Get("sv_novis", "0", 0);
+    sv_entity_budget = Cvar_Get("sv_entity_budget", "1", 0);
+    sv_min_snaps = Cvar_Get("sv_min_snaps", "10", 0);
+    sv_max_snaps = Cvar_Get("sv_max_snaps", "0", 0);
     sv_downloadserver = Cvar_Get("sv_downloadserver", "", 0);
     sv_redirect_address = Cvar_Get("sv_redirect_address", "", 0);
 
@@ -1967,10 +2084,14 @@ void SV_Shutdown(const char *finalmsg, error_type_t type)
     R_ClearDebugLines();    // for local system
 
     SV_FinalMessage(finalmsg, type);
+    SV_BenchShutdown(type);
     SV_MasterShutdown();
+    SV_HttpShutdown();
+    SV_StopNetThreads();
     SV_ShutdownGameProgs();
 
     // free current level
+    SV_FreeGamestate();
     for (int i = 0; i < MAX_CONFIGSTRINGS; i++)
         Z_Free(sv.configstrings[i]);
     for (int i = 0; i < MAX_EDICTS; i++)
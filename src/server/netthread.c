@@ -0,0 +1,533 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+//
+// netthread.c -- receive threads for server UDP traffic
+//
+// Each thread owns one shard of server sockets. Queries that don't need game
+// state (ping, info, status, getchallenge) are answered directly from
+// a snapshot published by main thread. Packets from known client addresses
+// and remaining connectionless commands are passed to main thread through
+// single producer, single consumer queue. Everything else is dropped.
+//
+
+#include "server.h"
+#include "system/pthread.h"
+
+#include <stdatomic.h>
+
+#define NET_QUEUE_SIZE      256     // must be power of two
+#define NET_QUEUE_MASK      (NET_QUEUE_SIZE - 1)
+
+#define SNAPSHOT_MSEC       100     // how often to republish status replies
+
+typedef struct {
+    netadr_t    from;
+    unsigned    len;
+    byte        data[MAX_PACKETLEN];
+} netpacket_t;
+
+typedef struct {
+    pthread_t       thread;
+    int             shard;
+    uint32_t        seed;
+    netpacket_t     *queue;
+    atomic_uint     head;       // written by receive thread
+    atomic_uint     tail;       // written by main thread
+    byte            buffer[MAX_PACKETLEN];
+} netthread_t;
+
+typedef struct {
+    netadr_t    addr;
+    int         qport;
+} netclient_t;
+
+typedef struct {
+    netadr_t    addr;
+    netadr_t    mask;
+} netmatch_t;
+
+static cvar_t   *sv_netthreads;
+
+static netthread_t  net_threads[MAX_NET_SHARDS];
+static int          net_numthreads;
+static atomic_bool  net_terminate;
+static atomic_bool  net_wakeup;
+
+// protects challenges and snapshot below
+static pthread_mutex_t  net_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct {
+    unsigned        generation;
+    unsigned        time;
+
+    char            status[MAX_PACKETLEN_DEFAULT];
+    size_t          status_len;
+    char            info[MAX_QPATH + 10];
+    size_t          info_len;
+    ratelimit_t     ratelimit;
+
+    netclient_t     *clients;
+    int             numclients;
+
+    netmatch_t      *blacklist;
+    int             numblacklist;
+    int             maxblacklist;
+} net_snap;
+
+static struct {
+    atomic_uint     status_hits;
+    atomic_uint     info_hits;
+    atomic_uint     answered;
+    atomic_uint     queued;
+    atomic_uint     overflowed;
+    atomic_uint     ignored;
+} net_stats;
+
+void SV_LockChallenges(void)
+{
+    pthread_mutex_lock(&net_lock);
+}
+
+void SV_UnlockChallenges(void)
+{
+    pthread_mutex_unlock(&net_lock);
+}
+
+/*
+==============================================================================
+
+RECEIVE THREAD
+
+==============================================================================
+*/
+
+// xorshift32, Q_rand is not thread safe
+static unsigned next_challenge(netthread_t *t)
+{
+    uint32_t x = t->seed;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    t->seed = x;
+
+    return x & INT_MAX;
+}
+
+static bool is_blacklisted(const netadr_t *from)
+{
+    for (int i = 0; i < net_snap.numblacklist; i++) {
+        const netmatch_t *m = &net_snap.blacklist[i];
+        if (NET_IsEqualBaseAdrMask(from, &m->addr, &m->mask))
+            return true;
+    }
+
+    return false;
+}
+
+static bool is_client(const netadr_t *from, const byte *data, unsigned len)
+{
+    for (int i = 0; i < net_snap.numclients; i++) {
+        const netclient_t *c = &net_snap.clients[i];
+
+        if (!NET_IsEqualBaseAdr(from, &c->addr))
+            continue;
+
+        // see SV_PacketEvent
+        if (c->qport) {
+            if (len >= PACKET_HEADER - 1 && data[8] == c->qport)
+                return true;
+        } else {
+            if (c->addr.port == from->port)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// returns true if packet was consumed
+static bool answer_query(netthread_t *t, const netadr_t *from,
+                         const byte *data, unsigned len)
+{
+    char        cmd[16], reply[MAX_PACKETLEN_DEFAULT];
+    unsigned    i, n, arg, challenge;
+    size_t      reply_len = 0;
+
+    // extract first word of the first line
+    for (i = 4, n = 0; i < len && n < sizeof(cmd) - 1; i++, n++) {
+        if (data[i] <= ' ')
+            break;
+        cmd[n] = data[i];
+    }
+    cmd[n] = 0;
+
+    // protocol version for info
+    while (i < len && data[i] == ' ')
+        i++;
+    for (arg = 0; i < len && Q_isdigit(data[i]) && arg < 1000; i++)
+        arg = arg * 10 + data[i] - '0';
+
+    if (strcmp(cmd, "ping") && strcmp(cmd, "info") &&
+        strcmp(cmd, "status") && strcmp(cmd, "getchallenge"))
+        return false;
+
+    pthread_mutex_lock(&net_lock);
+
+    if (is_blacklisted(from)) {
+        // drop silently
+    } else if (!strcmp(cmd, "ping")) {
+        memcpy(reply, "\xff\xff\xff\xff" "ack", 7);
+        reply_len = 7;
+    } else if (!strcmp(cmd, "info")) {
+        if (arg == PROTOCOL_VERSION_MAJOR && net_snap.info_len) {
+            memcpy(reply, net_snap.info, net_snap.info_len);
+            reply_len = net_snap.info_len;
+            atomic_fetch_add(&net_stats.info_hits, 1);
+        }
+    } else if (!strcmp(cmd, "status")) {
+        if (net_snap.status_len &&
+            !SV_RateLimitedAt(&net_snap.ratelimit, Sys_Milliseconds())) {
+            memcpy(reply, net_snap.status, net_snap.status_len);
+            reply_len = net_snap.status_len;
+            atomic_fetch_add(&net_stats.status_hits, 1);
+        }
+    } else {
+        challenge = next_challenge(t);
+        SV_AddChallenge(from, challenge, Sys_Milliseconds());
+        reply_len = Q_scnprintf(reply, sizeof(reply),
+                                "\xff\xff\xff\xff" "challenge %u p=34,35,36",
+                                challenge);
+    }
+
+    pthread_mutex_unlock(&net_lock);
+
+    if (reply_len) {
+        NET_OffloadSend(t->shard, reply, reply_len, from);
+        atomic_fetch_add(&net_stats.answered, 1);
+    } else {
+        atomic_fetch_add(&net_stats.ignored, 1);
+    }
+
+    return true;
+}
+
+static void queue_packet(netthread_t *t, const netadr_t *from,
+                         const byte *data, unsigned len)
+{
+    unsigned head = atomic_load_explicit(&t->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&t->tail, memory_order_acquire);
+    netpacket_t *p;
+
+    if (head - tail >= NET_QUEUE_SIZE) {
+        atomic_fetch_add(&net_stats.overflowed, 1);
+        return;
+    }
+
+    p = &t->queue[head & NET_QUEUE_MASK];
+    p->from = *from;
+    p->len = len;
+    memcpy(p->data, data, len);
+
+    atomic_store_explicit(&t->head, head + 1, memory_order_release);
+    atomic_fetch_add(&net_stats.queued, 1);
+
+    // wake up main thread unless it was already notified
+    if (!atomic_exchange(&net_wakeup, true))
+        NET_OffloadWake();
+}
+
+static void process_packet(netthread_t *t, const netadr_t *from, unsigned len)
+{
+    const byte *data = t->buffer;
+    bool known;
+
+    if (len < 4)
+        return;
+
+    if (*(int *)data == -1) {
+        if (!answer_query(t, from, data, len))
+            queue_packet(t, from, data, len);
+        return;
+    }
+
+    pthread_mutex_lock(&net_lock);
+    known = is_client(from, data, len);
+    pthread_mutex_unlock(&net_lock);
+
+    if (known)
+        queue_packet(t, from, data, len);
+    else
+        atomic_fetch_add(&net_stats.ignored, 1);
+}
+
+static void *recv_thread_func(void *arg)
+{
+    netthread_t *t = arg;
+    netadr_t from;
+    int ret;
+
+    while (!atomic_load(&net_terminate)) {
+        if (NET_OffloadWait(t->shard, 100) <= 0)
+            continue;
+
+        while ((ret = NET_OffloadRecv(t->shard, t->buffer, sizeof(t->buffer), &from)) >= 0)
+            process_packet(t, &from, ret);
+    }
+
+    return NULL;
+}
+
+/*
+==============================================================================
+
+MAIN THREAD
+
+==============================================================================
+*/
+
+static void publish_clients(void)
+{
+    client_t *cl;
+    int count = 0;
+
+    FOR_EACH_CLIENT(cl) {
+        if (count == svs.maxclients)
+            break;
+        net_snap.clients[count].addr = cl->netchan.remote_address;
+        net_snap.clients[count].qport = cl->netchan.qport;
+        count++;
+    }
+
+    net_snap.numclients = count;
+}
+
+static void publish_blacklist(void)
+{
+    addrmatch_t *match;
+    int count = 0;
+
+    LIST_FOR_EACH(match, &sv_blacklist, entry) {
+        if (count == net_snap.maxblacklist) {
+            net_snap.maxblacklist = Q_ALIGN(count + 1, 16);
+            net_snap.blacklist = Z_Realloc(net_snap.blacklist,
+                                           sizeof(net_snap.blacklist[0]) * net_snap.maxblacklist);
+        }
+        net_snap.blacklist[count].addr = match->addr;
+        net_snap.blacklist[count].mask = match->mask;
+        count++;
+    }
+
+    net_snap.numblacklist = count;
+}
+
+static void publish_status(void)
+{
+    const querycache_t *q = &svs.query;
+    ratelimit_t *r = &net_snap.ratelimit;
+
+    SV_BuildQueryCache();
+
+    if (sv_status_show->integer) {
+        memcpy(net_snap.status, q->status, q->status_len);
+        net_snap.status_len = q->status_len;
+    } else {
+        net_snap.status_len = 0;
+    }
+
+    if (svs.maxclients > 1) {
+        memcpy(net_snap.info, q->info, q->info_len);
+        net_snap.info_len = q->info_len;
+    } else {
+        net_snap.info_len = 0;
+    }
+
+    // pick up sv_status_limit changes, but keep accumulated credit
+    r->cost = svs.ratelimit_status.cost;
+    r->credit_cap = svs.ratelimit_status.credit_cap;
+    if (r->credit > r->credit_cap)
+        r->credit = r->credit_cap;
+}
+
+static void publish_snapshot(bool full)
+{
+    pthread_mutex_lock(&net_lock);
+
+    publish_clients();
+
+    if (full) {
+        publish_blacklist();
+        publish_status();
+        net_snap.generation = svs.query.generation;
+        net_snap.time = svs.realtime;
+    }
+
+    pthread_mutex_unlock(&net_lock);
+}
+
+/*
+==================
+SV_NetThreadRun
+
+Feeds packets queued by receive threads into packet_cb, then republishes
+client addresses so that new connections are recognized immediately. Query
+cache is invalidated every frame, so status replies are republished at most
+every SNAPSHOT_MSEC.
+==================
+*/
+void SV_NetThreadRun(void (*packet_cb)(void))
+{
+    netthread_t *t;
+    netpacket_t *p;
+    unsigned tail;
+    int i;
+
+    if (!net_numthreads)
+        return;
+
+    svs.query.status_hits += atomic_exchange(&net_stats.status_hits, 0);
+    svs.query.info_hits += atomic_exchange(&net_stats.info_hits, 0);
+
+    atomic_store(&net_wakeup, false);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // packet_cb may stop threads, so check each time
+    for (i = 0; i < net_numthreads; i++) {
+        t = &net_threads[i];
+        while (net_numthreads) {
+            tail = atomic_load_explicit(&t->tail, memory_order_relaxed);
+            if (tail == atomic_load_explicit(&t->head, memory_order_acquire))
+                break;
+
+            p = &t->queue[tail & NET_QUEUE_MASK];
+            memcpy(msg_read_buffer, p->data, p->len);
+            SZ_InitRead(&msg_read, msg_read_buffer, p->len);
+            net_from = p->from;
+
+            atomic_store_explicit(&t->tail, tail + 1, memory_order_release);
+
+            (*packet_cb)();
+        }
+    }
+
+    if (!net_numthreads)
+        return;
+
+    publish_snapshot(net_snap.generation != svs.query.generation &&
+                     svs.realtime - net_snap.time >= SNAPSHOT_MSEC);
+}
+
+/*
+==================
+SV_StartNetThreads
+==================
+*/
+void SV_StartNetThreads(void)
+{
+    netthread_t *t;
+    int i, count;
+
+    if (net_numthreads || !svs.initialized)
+        return;
+
+    if (sv_netthreads->integer <= 0)
+        return;
+
+    count = NET_OffloadServer(sv_netthreads->integer);
+    if (!count)
+        return;
+
+    net_snap.clients = SV_Malloc(sizeof(net_snap.clients[0]) * svs.maxclients);
+    net_snap.ratelimit = svs.ratelimit_status;
+    net_snap.ratelimit.time = Sys_Milliseconds();
+    publish_snapshot(true);
+
+    atomic_store(&net_terminate, false);
+    atomic_store(&net_wakeup, false);
+
+    for (i = 0; i < count; i++) {
+        t = &net_threads[i];
+        t->shard = i;
+        t->seed = Q_rand() | 1;
+        t->queue = SV_Malloc(sizeof(t->queue[0]) * NET_QUEUE_SIZE);
+        atomic_store(&t->head, 0);
+        atomic_store(&t->tail, 0);
+        if (pthread_create(&t->thread, NULL, recv_thread_func, t)) {
+            Com_EPrintf("Couldn't create network thread\n");
+            Z_Free(t->queue);
+            t->queue = NULL;
+            break;
+        }
+    }
+
+    // every shard must have its reader
+    net_numthreads = i;
+    if (net_numthreads < count) {
+        SV_StopNetThreads();
+        return;
+    }
+
+    Com_Printf("Started %d network thread%s\n", i, i == 1 ? "" : "s");
+}
+
+/*
+==================
+SV_StopNetThreads
+==================
+*/
+void SV_StopNetThreads(void)
+{
+    int i;
+
+    atomic_store(&net_terminate, true);
+
+    for (i = 0; i < net_numthreads; i++) {
+        Q_assert(!pthread_join(net_threads[i].thread, NULL));
+        Z_Free(net_threads[i].queue);
+        net_threads[i].queue = NULL;
+    }
+
+    if (net_numthreads)
+        Com_DPrintf("Network threads: %u answered, %u queued, %u overflowed, %u ignored\n",
+                    atomic_exchange(&net_stats.answered, 0),
+                    atomic_exchange(&net_stats.queued, 0),
+                    atomic_exchange(&net_stats.overflowed, 0),
+                    atomic_exchange(&net_stats.ignored, 0));
+
+    net_numthreads = 0;
+    NET_RestoreServer();
+
+    Z_Free(net_snap.clients);
+    Z_Free(net_snap.blacklist);
+    net_snap.clients = NULL;
+    net_snap.blacklist = NULL;
+    net_snap.numclients = 0;
+    net_snap.numblacklist = 0;
+    net_snap.maxblacklist = 0;
+}
+
+static void sv_netthreads_changed(cvar_t *self)
+{
+    SV_StopNetThreads();
+    SV_StartNetThreads();
+}
+
+void SV_RegisterNetThreads(void)
+{
+    sv_netthreads = Cvar_Get("sv_netthreads", "0", 0);
+    sv_netthreads->changed = sv_netthreads_changed;
+}
@@ -174,14 +174,19 @@ static bool can_auto_compress(const client_t *client)
     return true;
 }
 
-static int compress_message(const client_t *client)
+/*
+=======================
+SV_CompressMessage
+
+Deflates contents of the current write buffer into svs.z_buffer.
+Returns length of the compressed packet, or 0 on failure.
+=======================
+*/
+int SV_CompressMessage(const char *name)
 {
     int     ret, len;
     byte    *hdr;
 
-    if (!client->has_zlib)
-        return 0;
-
     svs.z.next_in = msg_write.data;
     svs.z.avail_in = msg_write.cursize;
     svs.z.next_out = svs.z_buffer + ZPACKET_HEADER;
@@ -195,7 +200,7 @@ static int compress_message(const client_t *client)
 
     if (ret != Z_STREAM_END) {
         Com_WPrintf("Error %d compressing %u bytes message for %s\n",
-                    ret, msg_write.cursize, client->name);
+                    ret, msg_write.cursize, name);
         return 0;
     }
 
@@ -208,6 +213,14 @@ static int compress_message(const client_t *client)
     return len + ZPACKET_HEADER;
 }
 
+static int compress_message(const client_t *client)
+{
+    if (!client->has_zlib)
+        return 0;
+
+    return SV_CompressMessage(client->name);
+}
+
 static byte *get_compressed_data(void)
 {
     return svs.z_buffer;
@@ -269,11 +282,14 @@ FRAME UPDATES
 
 static void SV_SendClientDatagram(client_t *client)
 {
+    uint64_t start;
     int cursize;
 
     // send over all the relevant entity_state_t
     // and the player_state_t
+    start = SV_BenchBegin();
     SV_WriteFrameToClient(client);
+    SV_BenchEnd(BENCH_DELTA, start);
 
     // now write unreliable messages
     // for this client out to the message
@@ -301,9 +317,11 @@ static void SV_SendClientDatagram(client_t *client)
 #endif
 
     // send the datagram
+    start = SV_BenchBegin();
     cursize = Netchan_Transmit(&client->netchan,
                                msg_write.cursize,
                                msg_write.data, 1);
+    SV_BenchEnd(BENCH_NETCHAN, start);
 
     // record the size for rate estimation
     SV_CalcSendTime(client, cursize);
@@ -321,6 +339,28 @@ COMMON STUFF
 ===============================================================================
 */
 
+/*
+=======================
+snapshot_divisor
+
+Returns number of server frames per snapshot for the client.
+=======================
+*/
+static int snapshot_divisor(const client_t *client)
+{
+    int fps = 1000 / sv.frametime;
+    int snaps = client->snaps ? client->snaps : fps;
+
+    if (sv_max_snaps->integer > 0)
+        snaps = min(snaps, sv_max_snaps->integer);
+    snaps = max(snaps, sv_min_snaps->integer);
+
+    if (snaps >= fps)
+        return 1;
+
+    return (fps + max(snaps, 1) - 1) / max(snaps, 1);
+}
+
 /*
 =======================
 SV_SendClientMessages
@@ -332,6 +372,7 @@ Clients in earlier connection state are handled in SV_SendAsyncPackets.
 void SV_SendClientMessages(void)
 {
     client_t    *client;
+    uint64_t    start;
     int         cursize;
 
     // send a message to each connected client
@@ -347,6 +388,14 @@ void SV_SendClientMessages(void)
             goto finish;
         }
 
+        // hold frame back until client's next snapshot, unreliable
+        // datagram and entity events are kept until then
+        if (client->snapskip > 0 && !client->netchan.fragment_pending) {
+            client->snapskip--;
+            SV_HoldClientEvents(client);
+            continue;
+        }
+
         // don't overrun bandwidth
         if (SV_RateDrop(client))
             goto finish;
@@ -360,12 +409,18 @@ void SV_SendClientMessages(void)
         }
 
         // build the new frame and write it
+        client->snapskip = snapshot_divisor(client) - 1;
+        start = SV_BenchBegin();
         SV_BuildClientFrame(client);
+        SV_BenchEnd(BENCH_BUILD, start);
         SV_SendClientDatagram(client);
 
 finish:
         // clear all unreliable messages still left
         SZ_Clear(&client->datagram);
+
+        // advance for next frame, this moves the rate window
+        client->framenum++;
     }
 }
 
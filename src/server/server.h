@@ -65,6 +65,9 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define SV_BASELINES_MASK       (SV_BASELINES_PER_CHUNK - 1)
 #define SV_BASELINES_CHUNKS     (MAX_EDICTS >> SV_BASELINES_SHIFT)
 
+// how long cached baselines are reused for connecting clients
+#define SV_BASELINES_MAXAGE     1000
+
 #define SV_InfoSet(var, val) \
     Cvar_FullSet(var, val, CVAR_SERVERINFO|CVAR_ROM, FROM_CODE)
 
@@ -92,6 +95,20 @@ typedef struct {
     uint16_t       *clusternums;
 } server_entity_t;
 
+// one encoded gamestate message, optionally followed by its compressed copy
+typedef struct {
+    int         first, end;     // range of configstrings covered
+    unsigned    size;
+    unsigned    zsize;          // 0 if compression didn't help
+    byte        data[1];
+} gamestate_packet_t;
+
+typedef struct {
+    gamestate_packet_t  **packets;
+    int                 num_packets;
+    int                 max_packets;
+} gamestate_stream_t;
+
 typedef struct {
     server_state_t  state;      // precache commands are only valid during load
     int             spawncount; // random number generated each server spawn
@@ -113,6 +130,12 @@ typedef struct {
     const char  *entitystring;
     char        *configstrings[MAX_CONFIGSTRINGS];
 
+    // gamestate encoded once and shared by all connecting clients
+    gamestate_stream_t  cs_stream;
+    gamestate_stream_t  bl_stream;
+    entity_state_t      *baselines[SV_BASELINES_CHUNKS];
+    int64_t             baselines_time;
+
     server_entity_t entities[MAX_EDICTS];
 } server_t;
 
@@ -135,6 +158,8 @@ typedef enum {
 
 #define RATE_MESSAGES   10
 
+#define MAX_HELD_EVENTS 64
+
 #define FOR_EACH_CLIENT(client) \
     LIST_FOR_EACH(client, &sv_clientlist, entry)
 
@@ -155,6 +180,20 @@ typedef struct {
     unsigned    cost;
 } ratelimit_t;
 
+// connectionless query replies, rebuilt at most once per frame
+typedef struct {
+    unsigned    generation;     // bumped on each invalidation
+    char        status[MAX_PACKETLEN_DEFAULT];
+    size_t      status_len;     // 0 if needs rebuild
+    char        info[MAX_QPATH + 10];
+    size_t      info_len;       // 0 if needs rebuild
+
+    unsigned    status_hits;
+    unsigned    status_builds;
+    unsigned    info_hits;
+    unsigned    info_builds;
+} querycache_t;
+
 typedef struct client_s {
     list_t          entry;
 
@@ -200,6 +239,8 @@ typedef struct client_s {
     unsigned        frames_sent, frames_acked, frames_nodelta;
     int             framenum;
     unsigned        frameflags;
+    int             snaps;          // requested snapshot rate, 0 = every frame
+    int             snapskip;       // frames left until next snapshot
     int64_t         begin_time;     // sv.time client has entered the game
 
     // rate dropping
@@ -217,6 +258,11 @@ typedef struct client_s {
     // per-client packet entities
     unsigned            next_entity;    // next state to use
     entity_state_t      *entities;      // [MAX_PARSE_ENTITIES]
+    byte                *deferred;      // [MAX_EDICTS] frames update was held back
+
+    // events from frames skipped because of lower snapshot rate
+    entity_state_t      *held_events;   // [MAX_HELD_EVENTS]
+    int                 num_held_events;
 
     // The datagram is written to by sound calls, prints, temp ents, etc.
     // It can be harmlessly overflowed.
@@ -317,6 +363,8 @@ typedef struct {
     ratelimit_t     ratelimit_rcon;
 
     challenge_t     challenges[MAX_CHALLENGES]; // to prevent invalid IPs from connecting
+
+    querycache_t    query;
 } server_static_t;
 
 //=============================================================================
@@ -349,6 +397,9 @@ extern cvar_t       *sv_debug;
 extern cvar_t       *sv_pad_packets;
 #endif
 extern cvar_t       *sv_novis;
+extern cvar_t       *sv_entity_budget;
+extern cvar_t       *sv_min_snaps;
+extern cvar_t       *sv_max_snaps;
 extern cvar_t       *sv_lan_force_rate;
 extern cvar_t       *sv_calcpings_method;
 extern cvar_t       *sv_changemapcmd;
@@ -368,6 +419,7 @@ extern cvar_t       *sv_status_limit;
 extern cvar_t       *sv_status_show;
 extern cvar_t       *sv_auth_limit;
 extern cvar_t       *sv_rcon_limit;
+extern cvar_t       *sv_namechange_limit;
 extern cvar_t       *sv_uptime;
 
 extern cvar_t       *sv_allow_unconnected_cmds;
@@ -393,12 +445,16 @@ void SV_InitOperatorCommands(void);
 void SV_UserinfoChanged(client_t *cl);
 
 bool SV_RateLimited(ratelimit_t *r);
+bool SV_RateLimitedAt(ratelimit_t *r, unsigned time);
 void SV_RateRecharge(ratelimit_t *r);
 void SV_RateInit(ratelimit_t *r, const char *s);
 
 addrmatch_t *SV_MatchAddress(const list_t *list, const netadr_t *address);
 
 int SV_CountClients(void);
+void SV_InvalidateQueryCache(void);
+void SV_BuildQueryCache(void);
+void SV_AddChallenge(const netadr_t *adr, unsigned challenge, unsigned time);
 
 #if USE_ZLIB
 voidpf SV_zalloc(voidpf opaque, uInt items, uInt size);
@@ -440,12 +496,17 @@ void SV_SendAsyncPackets(void);
 void SV_ClientCommand(client_t *cl, const char *fmt, ...) q_printf(2, 3);
 void SV_BroadcastCommand(const char *fmt, ...) q_printf(1, 2);
 void SV_ClientAddMessage(client_t *client, int flags);
+#if USE_ZLIB
+int SV_CompressMessage(const char *name);
+#endif
 void SV_ShutdownClientSend(client_t *client);
 void SV_InitClientSend(client_t *newcl);
 
 //
 // sv_user.c
 //
+void SV_InvalidateConfigstring(int index);
+void SV_FreeGamestate(void);
 void SV_New_f(void);
 void SV_Begin_f(void);
 void SV_ExecuteClientMessage(client_t *cl);
@@ -468,6 +529,7 @@ static inline bool SV_EntityHasEffects(const edict_t *ent)
 }
 
 void SV_BuildClientFrame(client_t *client);
+void SV_HoldClientEvents(client_t *client);
 void SV_WriteFrameToClient(client_t *client);
 
 //
@@ -516,6 +578,68 @@ void SV_RegisterSavegames(void);
 #define SV_RegisterSavegames()          (void)0
 #endif
 
+//
+// sv_bench.c
+//
+typedef enum {
+    BENCH_GAME,         // game module calls, including traces
+    BENCH_TRACE,        // SV_Trace and SV_Clip
+    BENCH_BUILD,        // SV_BuildClientFrame
+    BENCH_DELTA,        // SV_WriteFrameToClient
+    BENCH_NETCHAN,      // Netchan_Transmit
+    BENCH_NUM_STATS
+} bench_stat_t;
+
+typedef struct {
+    bool        active;
+    bool        recording;
+    int64_t     realtime;   // fixed value returned to game while active or recording
+    uint64_t    time[BENCH_NUM_STATS];
+    uint64_t    count[BENCH_NUM_STATS];
+} bench_stats_t;
+
+extern bench_stats_t    sv_bench;
+
+static inline uint64_t SV_BenchBegin(void)
+{
+    return sv_bench.active ? Sys_Microseconds() : 0;
+}
+
+static inline void SV_BenchEnd(bench_stat_t stat, uint64_t start)
+{
+    if (sv_bench.active) {
+        sv_bench.time[stat] += Sys_Microseconds() - start;
+        sv_bench.count[stat]++;
+    }
+}
+
+void SV_BenchSpawnServer(void);
+void SV_BenchFrame(void);
+void SV_BenchClientBegin(const client_t *client);
+void SV_BenchClientDrop(const client_t *client);
+void SV_BenchUserinfo(const client_t *client);
+void SV_BenchUsercmd(const client_t *client, const usercmd_t *cmd);
+void SV_BenchStringCmd(const client_t *client, const char *s);
+void SV_BenchShutdown(error_type_t type);
+void SV_RegisterBench(void);
+
+//
+// sv_http.c
+//
+void SV_HttpRun(void);
+void SV_HttpStart(void);
+void SV_HttpShutdown(void);
+const char *SV_HttpAddress(void);
+void SV_RegisterHttp(void);
+
+//
+// sv_netthread.c
+//
+void SV_NetThreadRun(void (*packet_cb)(void));
+void SV_LockChallenges(void);
+void SV_UnlockChallenges(void);
+void SV_RegisterNetThreads(void);
+
 //
 // sv_nav.c
 //
@@ -575,6 +699,11 @@ int SV_AreaEdicts(box3_t box, int *list, int maxcount, int areatype);
 // returns the number of pointers filled in
 // ??? does this always return the world?
 
+int SV_RadiusEdicts(vec3_t origin, float radius, int *list, int maxcount, int areatype);
+// like SV_AreaEdicts, but returns edicts with bounding boxes that intersect
+// the given sphere, sorted by edict number, or by distance from origin if
+// AREA_SORTED is set
+
 //===================================================================
 
 //
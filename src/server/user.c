@@ -19,7 +19,6 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "server.h"
 
-#define MSG_GAMESTATE   (MSG_RELIABLE | MSG_CLEAR | MSG_COMPRESS)
 
 /*
 ============================================================
@@ -32,24 +31,159 @@ sv_client and sv_player will be valid.
 
 static int      stringCmdCount;
 
+/*
+============================================================
+
+GAMESTATE CACHE
+
+Configstring and baseline streams are encoded (and compressed)
+once and then copied into reliable queue of each connecting
+client. Changing a configstring drops the cached packet holding
+it along with all following packets, these are re-encoded by
+the next client to connect. Baselines are snapshotted at most
+once per SV_BASELINES_MAXAGE milliseconds.
+
+============================================================
+*/
+
+static void free_stream(gamestate_stream_t *stream, int from)
+{
+    for (int i = from; i < stream->num_packets; i++)
+        Z_Freep(&stream->packets[i]);
+    stream->num_packets = from;
+}
+
+static void add_stream_packet(gamestate_stream_t *stream, int first, int end)
+{
+    gamestate_packet_t *p;
+    unsigned zsize = 0;
+
+#if USE_ZLIB
+    zsize = SV_CompressMessage("gamestate");
+    if (zsize >= msg_write.cursize)
+        zsize = 0;
+#endif
+
+    p = SV_Malloc(sizeof(*p) + msg_write.cursize + zsize);
+    p->first = first;
+    p->end = end;
+    p->size = msg_write.cursize;
+    p->zsize = zsize;
+    memcpy(p->data, msg_write.data, p->size);
+#if USE_ZLIB
+    memcpy(p->data + p->size, svs.z_buffer, zsize);
+#endif
+
+    if (stream->num_packets == stream->max_packets) {
+        stream->max_packets = max(stream->max_packets * 2, 16);
+        stream->packets = Z_ReallocArray(stream->packets, stream->max_packets,
+                                         sizeof(stream->packets[0]), TAG_SERVER);
+    }
+    stream->packets[stream->num_packets++] = p;
+
+    SZ_Clear(&msg_write);
+}
+
+static void write_stream(const gamestate_stream_t *stream)
+{
+    for (int i = 0; i < stream->num_packets; i++) {
+        const gamestate_packet_t *p = stream->packets[i];
+        if (p->zsize && sv_client->has_zlib)
+            SZ_Write(&sv_client->netchan.message, p->data + p->size, p->zsize);
+        else
+            SZ_Write(&sv_client->netchan.message, p->data, p->size);
+    }
+}
+
 /*
 ================
-SV_CreateBaselines
+SV_InvalidateConfigstring
+
+Called when configstring changes after the cache has been built.
+================
+*/
+void SV_InvalidateConfigstring(int index)
+{
+    gamestate_stream_t *stream = &sv.cs_stream;
+
+    for (int i = 0; i < stream->num_packets; i++) {
+        if (stream->packets[i]->end > index) {
+            free_stream(stream, i);
+            break;
+        }
+    }
+}
+
+void SV_FreeGamestate(void)
+{
+    free_stream(&sv.cs_stream, 0);
+    Z_Freep(&sv.cs_stream.packets);
+    free_stream(&sv.bl_stream, 0);
+    Z_Freep(&sv.bl_stream.packets);
+    for (int i = 0; i < SV_BASELINES_CHUNKS; i++)
+        Z_Freep(&sv.baselines[i]);
+}
+
+static void encode_configstring_stream(void)
+{
+    gamestate_stream_t *stream = &sv.cs_stream;
+    int         i, first;
+    const char *string;
+    size_t      length;
+
+    // encode only packets invalidated since last time
+    first = 0;
+    if (stream->num_packets) {
+        first = stream->packets[stream->num_packets - 1]->end;
+        if (first == MAX_CONFIGSTRINGS)
+            return;
+    }
+
+    SZ_Clear(&msg_write);
+    MSG_WriteByte(svc_configstringstream);
+
+    // write a packet full of data
+    for (i = first; i < MAX_CONFIGSTRINGS; i++) {
+        string = sv.configstrings[i];
+        if (!string) {
+            continue;
+        }
+        length = strlen(string);
+
+        // check if this configstring will overflow
+        if (msg_write.cursize + length + 5 > msg_write.maxsize) {
+            MSG_WriteShort(MAX_CONFIGSTRINGS);
+            add_stream_packet(stream, first, i);
+            MSG_WriteByte(svc_configstringstream);
+            first = i;
+        }
+
+        MSG_WriteShort(i);
+        MSG_WriteData(string, length + 1);
+    }
+
+    MSG_WriteShort(MAX_CONFIGSTRINGS);
+    add_stream_packet(stream, first, MAX_CONFIGSTRINGS);
+}
+
+/*
+================
+create_baselines
 
 Entity baselines are used to compress the update messages
 to the clients -- only the fields that differ from the
 baseline will be transmitted
 ================
 */
-static void SV_CreateBaselines(void)
+static void create_baselines(void)
 {
     int        i;
     edict_t    *ent;
     entity_state_t *base, **chunk;
 
-    // clear baselines from previous level
+    // clear baselines from previous snapshot
     for (i = 0; i < SV_BASELINES_CHUNKS; i++) {
-        base = sv_client->baselines[i];
+        base = sv.baselines[i];
         if (base) {
             memset(base, 0, sizeof(*base) * SV_BASELINES_PER_CHUNK);
         }
@@ -72,7 +206,7 @@ static void SV_CreateBaselines(void)
             continue;
         }
 
-        chunk = &sv_client->baselines[i >> SV_BASELINES_SHIFT];
+        chunk = &sv.baselines[i >> SV_BASELINES_SHIFT];
         if (*chunk == NULL) {
             *chunk = SV_Mallocz(sizeof(*base) * SV_BASELINES_PER_CHUNK);
         }
@@ -93,48 +227,25 @@ static void SV_CreateBaselines(void)
     }
 }
 
-static void write_configstring_stream(void)
-{
-    int         i;
-    const char *string;
-    size_t      length;
-
-    MSG_WriteByte(svc_configstringstream);
-
-    // write a packet full of data
-    for (i = 0; i < MAX_CONFIGSTRINGS; i++) {
-        string = sv.configstrings[i];
-        if (!string) {
-            continue;
-        }
-        length = strlen(string);
-
-        // check if this configstring will overflow
-        if (msg_write.cursize + length + 5 > msg_write.maxsize) {
-            MSG_WriteShort(MAX_CONFIGSTRINGS);
-            SV_ClientAddMessage(sv_client, MSG_GAMESTATE);
-            MSG_WriteByte(svc_configstringstream);
-        }
-
-        MSG_WriteShort(i);
-        MSG_WriteData(string, length + 1);
-    }
-
-    MSG_WriteShort(MAX_CONFIGSTRINGS);
-    SV_ClientAddMessage(sv_client, MSG_GAMESTATE);
-}
-
-static void write_baseline_stream(void)
+static void encode_baseline_stream(void)
 {
+    gamestate_stream_t *stream = &sv.bl_stream;
     int i, j;
     const entity_state_t *base;
 
+    if (stream->num_packets && sv.time - sv.baselines_time < SV_BASELINES_MAXAGE)
+        return;
+
+    create_baselines();
+    sv.baselines_time = sv.time;
+    free_stream(stream, 0);
+
     MSG_BeginWriting();
     MSG_WriteByte(svc_baselinestream);
 
     // write a packet full of data
     for (i = 0; i < SV_BASELINES_CHUNKS; i++) {
-        base = sv_client->baselines[i];
+        base = sv.baselines[i];
         if (!base) {
             continue;
         }
@@ -146,7 +257,7 @@ static void write_baseline_stream(void)
             if (msg_write.cursize + msg_max_entity_bytes > msg_write.maxsize) {
                 MSG_WriteBits(ENTITYNUM_NONE, ENTITYNUM_BITS);
                 MSG_FlushBits();
-                SV_ClientAddMessage(sv_client, MSG_GAMESTATE);
+                add_stream_packet(stream, 0, 0);
                 MSG_BeginWriting();
                 MSG_WriteByte(svc_baselinestream);
             }
@@ -156,7 +267,33 @@ static void write_baseline_stream(void)
 
     MSG_WriteBits(ENTITYNUM_NONE, ENTITYNUM_BITS);
     MSG_FlushBits();
-    SV_ClientAddMessage(sv_client, MSG_GAMESTATE);
+    add_stream_packet(stream, 0, 0);
+}
+
+/*
+================
+SV_CreateBaselines
+
+Gives this client a copy of cached baselines, so that
+subsequent deltas match what has been sent to it.
+================
+*/
+static void SV_CreateBaselines(void)
+{
+    entity_state_t **chunk;
+
+    for (int i = 0; i < SV_BASELINES_CHUNKS; i++) {
+        chunk = &sv_client->baselines[i];
+        if (!sv.baselines[i]) {
+            // clear baselines from previous level
+            if (*chunk)
+                memset(*chunk, 0, sizeof(**chunk) * SV_BASELINES_PER_CHUNK);
+            continue;
+        }
+        if (*chunk == NULL)
+            *chunk = SV_Malloc(sizeof(**chunk) * SV_BASELINES_PER_CHUNK);
+        memcpy(*chunk, sv.baselines[i], sizeof(**chunk) * SV_BASELINES_PER_CHUNK);
+    }
 }
 
 /*
@@ -187,6 +324,12 @@ void SV_New_f(void)
     // to make sure the protocol is right, and to set the gamedir
     //
 
+    // bring cached gamestate up to date
+    if (sv.state != ss_pic && sv.state != ss_cinematic) {
+        encode_configstring_stream();
+        encode_baseline_stream();
+    }
+
     // create baselines for this client
     SV_CreateBaselines();
 
@@ -213,8 +356,8 @@ void SV_New_f(void)
         return;
 
     // send gamestate
-    write_configstring_stream();
-    write_baseline_stream();
+    write_stream(&sv.cs_stream);
+    write_stream(&sv.bl_stream);
 
     // send next command
     SV_ClientCommand(sv_client, "precache %i\n", sv.spawncount);
@@ -256,9 +399,19 @@ void SV_Begin_f(void)
     // allocate packet entities if not done yet
     if (!sv_client->entities)
         sv_client->entities = SV_Mallocz(sizeof(sv_client->entities[0]) * MAX_PARSE_ENTITIES);
+    if (!sv_client->deferred)
+        sv_client->deferred = SV_Mallocz(MAX_EDICTS);
+    else
+        memset(sv_client->deferred, 0, MAX_EDICTS);
+    if (!sv_client->held_events)
+        sv_client->held_events = SV_Malloc(sizeof(sv_client->held_events[0]) * MAX_HELD_EVENTS);
+    sv_client->num_held_events = 0;
+    sv_client->snapskip = 0;
 
     // call the game begin function
     ge->ClientBegin(sv_client->number);
+
+    SV_BenchClientBegin(sv_client);
 }
 
 //============================================================================
@@ -402,6 +555,8 @@ static void SV_ExecuteUserCommand(const char *s)
         sv_client->lastactivity = svs.realtime;
     }
 
+    SV_BenchStringCmd(sv_client, s);
+
     ge->ClientCommand(sv_client->number);
 }
 
@@ -445,6 +600,9 @@ static inline void SV_ClientThink(usercmd_t *cmd)
 
     if (cmd != old)
         *old = *cmd;
+
+    SV_BenchUsercmd(sv_client, cmd);
+
     ge->ClientThink(sv_client->number);
 }
 
@@ -621,6 +779,7 @@ static void SV_UpdateUserinfo(void)
     }
 
     SV_UserinfoChanged(sv_client);
+    SV_BenchUserinfo(sv_client);
 }
 
 static void SV_ParseFullUserinfo(void)
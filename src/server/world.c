@@ -358,6 +358,59 @@ int SV_AreaEdicts(box3_t box, int *list, int maxcount, int areatype)
     return area_count;
 }
 
+typedef struct {
+    float   dist;
+    int     number;
+} radius_edict_t;
+
+static int radiuscmp(const void *p1, const void *p2)
+{
+    const radius_edict_t *a = p1;
+    const radius_edict_t *b = p2;
+
+    if (a->dist < b->dist)
+        return -1;
+    if (a->dist > b->dist)
+        return 1;
+    return a->number - b->number;
+}
+
+/*
+================
+SV_RadiusEdicts
+================
+*/
+int SV_RadiusEdicts(vec3_t origin, float radius, int *list, int maxcount, int areatype)
+{
+    static radius_edict_t sorted[MAX_EDICTS];
+    box3_t box = Box3_Translate(Box3_FromRadius(radius), origin);
+    int i, count, total;
+
+    maxcount = min(maxcount, MAX_EDICTS);
+    total = SV_AreaEdicts(box, list, maxcount, areatype & (AREA_SOLID | AREA_TRIGGERS));
+
+    // drop edicts whose bounds only touch the corners of the box
+    for (i = count = 0; i < total; i++) {
+        const edict_t *ent = SV_EdictForNum(list[i]);
+        vec3_t p = Box3_ClampPoint(ent->r.absbox, origin);
+        float dist = Vec3_DistanceSquared(p, origin);
+
+        if (dist > radius * radius)
+            continue;
+
+        sorted[count].dist = (areatype & AREA_SORTED) ? dist : 0;
+        sorted[count].number = list[i];
+        count++;
+    }
+
+    qsort(sorted, count, sizeof(sorted[0]), radiuscmp);
+
+    for (i = 0; i < count; i++)
+        list[i] = sorted[i].number;
+
+    return count;
+}
+
 
 //===========================================================================
 
@@ -507,16 +560,19 @@ Passedict and edicts owned by passedict are explicitly not checked.
 */
 void SV_Trace(trace_t *trace, const trace_args_t *args)
 {
+    uint64_t start = SV_BenchBegin();
+
     Q_assert_soft(args->entnum < MAX_EDICTS);
 
     // clip to world
     CM_BoxTrace(trace, args, SV_WorldNodes());
     trace->entnum = ENTITYNUM_WORLD;
-    if (trace->fraction == 0)
-        return;     // blocked by the world
 
-    // clip to other solid entities
-    SV_ClipMoveToEntities(trace, args);
+    // clip to other solid entities, unless blocked by the world
+    if (trace->fraction > 0)
+        SV_ClipMoveToEntities(trace, args);
+
+    SV_BenchEnd(BENCH_TRACE, start);
 }
 
 /*
@@ -529,6 +585,8 @@ Can be used to clip to SOLID_TRIGGER by its BSP tree.
 */
 void SV_Clip(trace_t *trace, const trace_args_t *args)
 {
+    uint64_t start = SV_BenchBegin();
+
     Q_assert_soft(args->entnum < MAX_EDICTS);
 
     if (args->entnum == ENTITYNUM_WORLD) {
@@ -540,4 +598,6 @@ void SV_Clip(trace_t *trace, const trace_args_t *args)
                                clip->s.origin, clip->s.angles);
     }
     trace->entnum = args->entnum;
+
+    SV_BenchEnd(BENCH_TRACE, start);
 }
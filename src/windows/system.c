@@ -869,6 +869,21 @@ unsigned Sys_Milliseconds(void)
     return tm.QuadPart * 1000ULL / timer_freq.QuadPart;
 }
 
+uint64_t Sys_Microseconds(void)
+{
+    LARGE_INTEGER tm;
+    QueryPerformanceCounter(&tm);
+    return tm.QuadPart / timer_freq.QuadPart * 1000000ULL +
+           tm.QuadPart % timer_freq.QuadPart * 1000000ULL / timer_freq.QuadPart;
+}
+
+int Sys_NumCPUs(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return max(info.dwNumberOfProcessors, 1);
+}
+
 void Sys_AddDefaultConfig(void)
 {
 }